@@ -106,6 +106,9 @@ public:
 	bool extract(std::size_t pos, Poco::Data::BLOB& val);
 		/// Extracts a BLOB.
 
+	bool extract(std::size_t pos, Poco::Data::StringArena& val);
+		/// Extracts a string directly into the StringArena.
+
 	bool extract(std::size_t pos, Poco::Any& val);
 		/// Extracts an Any.
 
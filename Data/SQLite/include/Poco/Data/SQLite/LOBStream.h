@@ -0,0 +1,199 @@
+//
+// LOBStream.h
+//
+// $Id: //poco/1.4/Data/SQLite/include/Poco/Data/SQLite/LOBStream.h#1 $
+//
+// Library: SQLite
+// Package: SQLite
+// Module:  LOBStream
+//
+// Definition of the LOBStreamBuf, LOBInputStream and LOBOutputStream classes.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef DataConnectors_SQLite_LOBStream_INCLUDED
+#define DataConnectors_SQLite_LOBStream_INCLUDED
+
+
+#include "Poco/Data/SQLite/SQLite.h"
+#include "Poco/Data/Session.h"
+#include "Poco/BufferedStreamBuf.h"
+#include <istream>
+#include <ostream>
+
+
+struct sqlite3;
+struct sqlite3_blob;
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+class SQLite_API LOBStreamBuf: public Poco::BufferedStreamBuf
+	/// This is the streambuf class used for incremental reading
+	/// and writing of a BLOB column value stored in a SQLite database.
+	///
+	/// In contrast to extracting into a Poco::Data::BLOB, the column
+	/// value is never held in memory as a whole; it is transferred
+	/// in chunks of BUFFER_SIZE bytes using the sqlite3_blob API.
+{
+public:
+	enum
+	{
+		BUFFER_SIZE = 65536
+	};
+
+	LOBStreamBuf(Session& session, const std::string& table, const std::string& column, Poco::Int64 rowID, std::ios::openmode mode);
+		/// Opens the BLOB stored in the given column of the row with the given
+		/// rowID in the given table.
+		///
+		/// The session must have been created with the SQLite connector;
+		/// pooled sessions are not supported. Throws a SQLiteException
+		/// if the BLOB cannot be opened.
+
+	~LOBStreamBuf();
+		/// Closes the BLOB.
+
+	std::streamsize size() const;
+		/// Returns the size of the BLOB in bytes.
+
+	void close();
+		/// Flushes pending output and closes the BLOB.
+		///
+		/// Throws a SQLiteException if the pending output
+		/// cannot be written, e.g. because it does not fit
+		/// into the BLOB. The BLOB is closed in any case.
+
+protected:
+	int readFromDevice(char* buffer, std::streamsize length);
+	int writeToDevice(const char* buffer, std::streamsize length);
+
+private:
+	static sqlite3* database(Session& session);
+
+	sqlite3*      _pDB;
+	sqlite3_blob* _pBlob;
+	int           _size;
+	int           _offset;
+};
+
+
+class SQLite_API LOBIOS: public virtual std::ios
+	/// The base class for LOBInputStream and LOBOutputStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the stream buffer and base classes.
+{
+public:
+	LOBIOS(Session& session, const std::string& table, const std::string& column, Poco::Int64 rowID, openmode mode);
+		/// Creates the LOBIOS.
+
+	~LOBIOS();
+		/// Destroys the LOBIOS.
+
+	LOBStreamBuf* rdbuf();
+		/// Returns a pointer to the internal LOBStreamBuf.
+
+	std::streamsize size() const;
+		/// Returns the size of the BLOB in bytes.
+
+	void close();
+		/// Flushes pending output and closes the BLOB.
+		///
+		/// Throws a SQLiteException if the pending output
+		/// cannot be written.
+
+protected:
+	LOBStreamBuf _buf;
+};
+
+
+class SQLite_API LOBInputStream: public LOBIOS, public std::istream
+	/// An input stream reading a BLOB column value directly from
+	/// the database, without copying it into memory as a whole.
+	///
+	/// Example:
+	///     LOBInputStream lob(session, "Images", "data", rowID);
+	///     Poco::StreamCopier::copyStream(lob, file);
+{
+public:
+	LOBInputStream(Session& session, const std::string& table, const std::string& column, Poco::Int64 rowID);
+		/// Creates the LOBInputStream for the given row and column.
+
+	~LOBInputStream();
+		/// Destroys the LOBInputStream.
+};
+
+
+class SQLite_API LOBOutputStream: public LOBIOS, public std::ostream
+	/// An output stream writing a BLOB column value directly to
+	/// the database.
+	///
+	/// SQLite cannot change the size of a BLOB incrementally, so the
+	/// row must have been inserted or updated with a BLOB of the final
+	/// size first, preferably using zeroblob(). Writing beyond the
+	/// end of the BLOB sets the stream's badbit.
+	///
+	/// Example:
+	///     session << "INSERT INTO Images VALUES (?, zeroblob(?))", use(name), use(size), now;
+	///     Poco::Int64 rowID;
+	///     session << "SELECT last_insert_rowid()", into(rowID), now;
+	///     LOBOutputStream lob(session, "Images", "data", rowID);
+	///     Poco::StreamCopier::copyStream(file, lob);
+	///     lob.close();
+{
+public:
+	LOBOutputStream(Session& session, const std::string& table, const std::string& column, Poco::Int64 rowID);
+		/// Creates the LOBOutputStream for the given row and column.
+
+	~LOBOutputStream();
+		/// Destroys the LOBOutputStream, flushing any pending output.
+};
+
+
+//
+// inlines
+//
+inline std::streamsize LOBStreamBuf::size() const
+{
+	return _size;
+}
+
+
+inline std::streamsize LOBIOS::size() const
+{
+	return _buf.size();
+}
+
+
+} } } // namespace Poco::Data::SQLite
+
+
+#endif // DataConnectors_SQLite_LOBStream_INCLUDED
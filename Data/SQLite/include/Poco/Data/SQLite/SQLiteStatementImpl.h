@@ -43,6 +43,7 @@
 #include "Poco/Data/SQLite/SQLite.h"
 #include "Poco/Data/SQLite/Binder.h"
 #include "Poco/Data/SQLite/Extractor.h"
+#include "Poco/Data/SQLite/StatementCache.h"
 #include "Poco/Data/StatementImpl.h"
 #include "Poco/Data/MetaColumn.h"
 #include "Poco/SharedPtr.h"
@@ -62,8 +63,11 @@ class SQLite_API SQLiteStatementImpl: public Poco::Data::StatementImpl
 	/// Implements statement functionality needed for SQLite
 {
 public:
-	SQLiteStatementImpl(sqlite3* pDB, int maxRetryAttempts, int minRetrySleep, int maxRetrySleep);
+	SQLiteStatementImpl(sqlite3* pDB, int maxRetryAttempts, int minRetrySleep, int maxRetrySleep, StatementCache::Ptr pCache = StatementCache::Ptr());
 		/// Creates the SQLiteStatementImpl.
+		///
+		/// If a StatementCache is given, the compiled statement handle
+		/// is taken from and returned to the cache.
 
 	~SQLiteStatementImpl();
 		/// Destroys the SQLiteStatementImpl.
@@ -103,7 +107,7 @@ protected:
 
 private:
 	void clear();
-		/// Removes the _pStmt
+		/// Removes the _pStmt, returning it to the statement cache if there is one.
 		
 	void sleep();
 		/// Sleep for a random time (between retry attempts).
@@ -113,6 +117,9 @@ private:
 
 	sqlite3*      _pDB;
 	sqlite3_stmt* _pStmt;
+	std::string   _sql;
+	StatementCache::Ptr _pCache;
+	Poco::UInt32  _cacheGeneration;
 	int           _maxRetryAttempts;
 	int           _minRetrySleep;
 	int           _maxRetrySleep;
@@ -42,6 +42,7 @@
 
 #include "Poco/Data/SQLite/SQLite.h"
 #include "Poco/Data/SQLite/Binder.h"
+#include "Poco/Data/SQLite/StatementCache.h"
 #include "Poco/Data/AbstractSessionImpl.h"
 #include "Poco/SharedPtr.h"
 
@@ -65,6 +66,15 @@ class SQLite_API SessionImpl: public Poco::Data::AbstractSessionImpl<SessionImpl
 	///     time. 
 	///   * minRetrySleep: the minimum time (in milliseconds) waited between two retry attempts.
 	///   * maxRetrySleep: the maximum time (in milliseconds) waited between two retry attempts.
+	///   * statementCacheSize: the maximum number of prepared statement handles (int)
+	///     kept in the session's StatementCache. 0 disables the cache.
+	///   * statementCacheHits: the number of statements compiled from a cached
+	///     handle (Poco::UInt64, read-only).
+	///   * statementCacheMisses: the number of cacheable statements that had to be
+	///     prepared (Poco::UInt64, read-only).
+	///
+	/// The statement cache belongs to the session and therefore survives
+	/// returning the session to a SessionPool.
 	///
 	/// Notes: For automatic retries to work, you should start every transaction that
 	/// at one point will write to the database with IMMEDIATE or EXCLUSIVE mode.
@@ -119,6 +129,10 @@ protected:
 	Poco::Any getMinRetrySleep(const std::string& prop);
 	void setMaxRetrySleep(const std::string& prop, const Poco::Any& value);
 	Poco::Any getMaxRetrySleep(const std::string& prop);
+	void setStatementCacheSize(const std::string& prop, const Poco::Any& value);
+	Poco::Any getStatementCacheSize(const std::string& prop);
+	Poco::Any getStatementCacheHits(const std::string& prop);
+	Poco::Any getStatementCacheMisses(const std::string& prop);
 	
 private:
 	void open();
@@ -131,6 +145,7 @@ private:
 	int         _minRetrySleep;
 	int         _maxRetrySleep;
 	bool        _connected;
+	StatementCache::Ptr _pStatementCache;
 	
 	static const std::string BEGIN_TRANSACTION;
 	static const std::string COMMIT_TRANSACTION;
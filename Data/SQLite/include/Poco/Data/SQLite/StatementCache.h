@@ -0,0 +1,195 @@
+//
+// StatementCache.h
+//
+// $Id: //poco/1.4/Data/SQLite/include/Poco/Data/SQLite/StatementCache.h#1 $
+//
+// Library: Data/SQLite
+// Package: SQLite
+// Module:  StatementCache
+//
+// Definition of the StatementCache class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef SQLite_StatementCache_INCLUDED
+#define SQLite_StatementCache_INCLUDED
+
+
+#include "Poco/Data/SQLite/SQLite.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Mutex.h"
+#include "Poco/Types.h"
+#include <list>
+#include <map>
+
+
+struct sqlite3_stmt;
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+class SQLite_API StatementCache: public Poco::RefCountedObject
+	/// A least recently used cache of compiled (prepared) SQLite
+	/// statement handles, keyed by SQL text.
+	///
+	/// Every SessionImpl owns a StatementCache. When a SQLiteStatementImpl
+	/// is compiled, it first tries to check out a handle for its SQL text
+	/// from the cache, and only calls sqlite3_prepare_v2() if there is
+	/// none. When the SQLiteStatementImpl is destroyed, the handle is reset
+	/// and returned to the cache instead of being finalized. A handle is
+	/// only ever used by one statement at a time; if the same SQL text
+	/// is compiled again while its handle is checked out, a new handle
+	/// is prepared.
+	///
+	/// Only data manipulation statements (SELECT, INSERT, UPDATE, DELETE,
+	/// REPLACE and WITH) are cached. Compiling a statement that changes the
+	/// database schema (CREATE, DROP, ALTER, ATTACH, DETACH) flushes the
+	/// cache and starts a new schema generation, so that the column metadata
+	/// of cached handles never gets stale. Handles checked out in an earlier
+	/// generation are not taken back. Schema changes made through other
+	/// connections are not detected.
+	///
+	/// A StatementCache is reference counted, as checked out handles
+	/// may be returned after the owning session has been closed.
+{
+public:
+	typedef Poco::AutoPtr<StatementCache> Ptr;
+
+	enum
+	{
+		DEFAULT_CAPACITY = 32 /// Default maximum number of cached statement handles.
+	};
+
+	explicit StatementCache(std::size_t capacity = DEFAULT_CAPACITY);
+		/// Creates the StatementCache with the given capacity.
+		/// A capacity of 0 disables caching.
+
+	sqlite3_stmt* get(const std::string& sql);
+		/// Checks out the cached handle for the given SQL text,
+		/// removing it from the cache.
+		///
+		/// Returns 0 if there is no cached handle for the SQL text,
+		/// in which case the caller must prepare a new one.
+		/// Schema changing statements flush the cache.
+
+	void put(const std::string& sql, sqlite3_stmt* pStmt, Poco::UInt32 generation);
+		/// Resets the given handle and returns it to the cache, where
+		/// it becomes the most recently used one. If the cache is full,
+		/// the least recently used handle is finalized. 
+		///
+		/// The handle is finalized instead of being cached if the SQL text
+		/// is not cacheable, if another handle for the same SQL text is
+		/// already cached, if the schema generation has changed since
+		/// the handle was prepared or checked out, or if the cache has
+		/// been closed.
+
+	Poco::UInt32 generation() const;
+		/// Returns the current schema generation.
+
+	void clear();
+		/// Finalizes all cached handles.
+
+	void close();
+		/// Finalizes all cached handles and disables the cache.
+		/// Must be called before the database connection is closed.
+
+	void setCapacity(std::size_t capacity);
+		/// Sets the maximum number of cached handles,
+		/// finalizing the least recently used ones if necessary.
+
+	std::size_t capacity() const;
+		/// Returns the maximum number of cached handles.
+
+	std::size_t size() const;
+		/// Returns the number of cached handles.
+
+	Poco::UInt64 hits() const;
+		/// Returns the number of times a cached handle was found.
+
+	Poco::UInt64 misses() const;
+		/// Returns the number of times a cacheable statement
+		/// had to be prepared.
+
+	static bool isCacheable(const std::string& sql);
+		/// Returns true if the given SQL text is a data manipulation
+		/// statement whose handle can be cached.
+
+	static bool changesSchema(const std::string& sql);
+		/// Returns true if the given SQL text is a statement
+		/// that changes the database schema.
+
+protected:
+	~StatementCache();
+		/// Destroys the StatementCache and finalizes all cached handles.
+
+private:
+	enum Kind
+	{
+		SK_DML,   /// cacheable data manipulation statement
+		SK_SCHEMA,/// schema changing statement
+		SK_OTHER  /// anything else (transaction control, PRAGMA, ...)
+	};
+
+	typedef std::list<std::string> KeyList;
+
+	struct Entry
+	{
+		sqlite3_stmt*     pStmt;
+		KeyList::iterator lru;
+	};
+
+	typedef std::map<std::string, Entry> EntryMap;
+
+	StatementCache(const StatementCache&);
+	StatementCache& operator = (const StatementCache&);
+
+	void evict(std::size_t capacity);
+		/// Finalizes least recently used handles until
+		/// at most capacity handles remain cached.
+
+	static Kind kindOf(const std::string& sql);
+
+	EntryMap                _entries;
+	KeyList                 _keys;
+	std::size_t             _capacity;
+	bool                    _closed;
+	Poco::UInt32            _generation;
+	Poco::UInt64            _hits;
+	Poco::UInt64            _misses;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+} } } // namespace Poco::Data::SQLite
+
+
+#endif // SQLite_StatementCache_INCLUDED
@@ -37,6 +37,7 @@
 #include "Poco/Data/SQLite/Extractor.h"
 #include "Poco/Data/SQLite/Utility.h"
 #include "Poco/Data/BLOB.h"
+#include "Poco/Data/StringArena.h"
 #include "Poco/Data/DataException.h"
 #include "Poco/Exception.h"
 #if defined(POCO_UNBUNDLED)
@@ -103,6 +104,19 @@ bool Extractor::extract(std::size_t pos, std::string& val)
 }
 
 
+bool Extractor::extract(std::size_t pos, Poco::Data::StringArena& val)
+{
+	if (isNull(pos))
+		return false;
+	const char* pBuf = reinterpret_cast<const char*>(sqlite3_column_text(_pStmt, (int) pos));
+	if (!pBuf)
+		val.append("", 0);
+	else
+		val.append(pBuf, sqlite3_column_bytes(_pStmt, (int) pos));
+	return true;
+}
+
+
 bool Extractor::extract(std::size_t pos, Poco::Data::BLOB& val)
 {
 	if (isNull(pos))
@@ -0,0 +1,198 @@
+//
+// LOBStream.cpp
+//
+// $Id: //poco/1.4/Data/SQLite/src/LOBStream.cpp#1 $
+//
+// Library: SQLite
+// Package: SQLite
+// Module:  LOBStream
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Data/SQLite/LOBStream.h"
+#include "Poco/Data/SQLite/SessionImpl.h"
+#include "Poco/Data/SQLite/Utility.h"
+#include "Poco/Data/SQLite/SQLiteException.h"
+#include "Poco/Exception.h"
+#if defined(POCO_UNBUNDLED)
+#include <sqlite3.h>
+#else
+#include "sqlite3.h"
+#endif
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+//
+// LOBStreamBuf
+//
+
+
+LOBStreamBuf::LOBStreamBuf(Session& session, const std::string& table, const std::string& column, Poco::Int64 rowID, std::ios::openmode mode):
+	BufferedStreamBuf(BUFFER_SIZE, mode),
+	_pDB(database(session)),
+	_pBlob(0),
+	_size(0),
+	_offset(0)
+{
+	int flags = (mode & std::ios::out) ? 1 : 0;
+	int rc = sqlite3_blob_open(_pDB, "main", table.c_str(), column.c_str(), rowID, flags, &_pBlob);
+	if (rc != SQLITE_OK)
+	{
+		std::string msg = Utility::lastError(_pDB);
+		if (_pBlob) sqlite3_blob_close(_pBlob);
+		Utility::throwException(rc, msg);
+	}
+	_size = sqlite3_blob_bytes(_pBlob);
+}
+
+
+LOBStreamBuf::~LOBStreamBuf()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void LOBStreamBuf::close()
+{
+	if (_pBlob)
+	{
+		bool synced = sync() == 0;
+		sqlite3_blob* pBlob = _pBlob;
+		_pBlob = 0;
+		int rc = sqlite3_blob_close(pBlob);
+		if (rc != SQLITE_OK) Utility::throwException(rc, Utility::lastError(_pDB));
+		if (!synced) throw SQLiteException("Cannot write pending data to BLOB");
+	}
+}
+
+
+int LOBStreamBuf::readFromDevice(char* buffer, std::streamsize length)
+{
+	if (!_pBlob) return -1;
+
+	int n = static_cast<int>(length < _size - _offset ? length : _size - _offset);
+	if (n <= 0) return 0;
+	if (sqlite3_blob_read(_pBlob, buffer, n, _offset) != SQLITE_OK) return -1;
+	_offset += n;
+	return n;
+}
+
+
+int LOBStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
+{
+	if (!_pBlob || length > _size - _offset) return -1;
+
+	int n = static_cast<int>(length);
+	if (sqlite3_blob_write(_pBlob, buffer, n, _offset) != SQLITE_OK) return -1;
+	_offset += n;
+	return n;
+}
+
+
+sqlite3* LOBStreamBuf::database(Session& session)
+{
+	SessionImpl* pImpl = dynamic_cast<SessionImpl*>(session.impl());
+	if (!pImpl) throw Poco::InvalidArgumentException("LOB streams require a SQLite session");
+	return pImpl->db();
+}
+
+
+//
+// LOBIOS
+//
+
+
+LOBIOS::LOBIOS(Session& session, const std::string& table, const std::string& column, Poco::Int64 rowID, openmode mode):
+	_buf(session, table, column, rowID, mode)
+{
+	poco_ios_init(&_buf);
+}
+
+
+LOBIOS::~LOBIOS()
+{
+}
+
+
+LOBStreamBuf* LOBIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+void LOBIOS::close()
+{
+	_buf.close();
+}
+
+
+//
+// LOBInputStream
+//
+
+
+LOBInputStream::LOBInputStream(Session& session, const std::string& table, const std::string& column, Poco::Int64 rowID):
+	LOBIOS(session, table, column, rowID, std::ios::in),
+	std::istream(&_buf)
+{
+}
+
+
+LOBInputStream::~LOBInputStream()
+{
+}
+
+
+//
+// LOBOutputStream
+//
+
+
+LOBOutputStream::LOBOutputStream(Session& session, const std::string& table, const std::string& column, Poco::Int64 rowID):
+	LOBIOS(session, table, column, rowID, std::ios::out),
+	std::ostream(&_buf)
+{
+}
+
+
+LOBOutputStream::~LOBOutputStream()
+{
+}
+
+
+} } } // namespace Poco::Data::SQLite
@@ -53,9 +53,11 @@ namespace Data {
 namespace SQLite {
 
 
-SQLiteStatementImpl::SQLiteStatementImpl(sqlite3* pDB, int maxRetryAttempts, int minRetrySleep, int maxRetrySleep):
+SQLiteStatementImpl::SQLiteStatementImpl(sqlite3* pDB, int maxRetryAttempts, int minRetrySleep, int maxRetrySleep, StatementCache::Ptr pCache):
 	_pDB(pDB),
 	_pStmt(0),
+	_pCache(pCache),
+	_cacheGeneration(0),
 	_maxRetryAttempts(maxRetryAttempts),
 	_minRetrySleep(minRetrySleep),
 	_maxRetrySleep(maxRetrySleep),
@@ -99,11 +101,11 @@ void SQLiteStatementImpl::compileImplImpl()
 	if (statement.empty())
 		throw InvalidSQLStatementException("Empty statements are illegal");
 
-	sqlite3_stmt* pStmt = 0;
+	sqlite3_stmt* pStmt = _pCache ? _pCache->get(statement) : 0;
 	const char* pSql = statement.c_str(); // The SQL to be executed
 	int rc = SQLITE_OK;
 	const char* pLeftover = 0;
-	bool queryFound = false;
+	bool queryFound = pStmt != 0;
 
 	while (rc == SQLITE_OK && !pStmt && !queryFound)
 	{
@@ -135,6 +137,8 @@ void SQLiteStatementImpl::compileImplImpl()
 
 	clear();
 	_pStmt = pStmt;
+	_sql   = statement;
+	if (_pCache) _cacheGeneration = _pCache->generation();
 
 	// prepare binding
 	_pBinder = new Binder(_pStmt);
@@ -194,7 +198,10 @@ void SQLiteStatementImpl::clear()
 
 	if (_pStmt)
 	{
-		sqlite3_finalize(_pStmt);
+		if (_pCache)
+			_pCache->put(_sql, _pStmt, _cacheGeneration);
+		else
+			sqlite3_finalize(_pStmt);
 		_pStmt=0;
 	}
 }
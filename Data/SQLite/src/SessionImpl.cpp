@@ -62,12 +62,16 @@ SessionImpl::SessionImpl(const std::string& fileName):
 	_maxRetryAttempts(DEFAULT_MAX_RETRY_ATTEMPTS),
 	_minRetrySleep(DEFAULT_MIN_RETRY_SLEEP),
 	_maxRetrySleep(DEFAULT_MAX_RETRY_SLEEP),
-	_connected(false)
+	_connected(false),
+	_pStatementCache(new StatementCache)
 {
 	addProperty("transactionMode", &SessionImpl::setTransactionMode, &SessionImpl::getTransactionMode);
 	addProperty("maxRetryAttempts", &SessionImpl::setMaxRetryAttempts, &SessionImpl::getMaxRetryAttempts);
 	addProperty("minRetrySleep", &SessionImpl::setMinRetrySleep, &SessionImpl::getMinRetrySleep);
 	addProperty("maxRetrySleep", &SessionImpl::setMaxRetrySleep, &SessionImpl::getMaxRetrySleep);
+	addProperty("statementCacheSize", &SessionImpl::setStatementCacheSize, &SessionImpl::getStatementCacheSize);
+	addProperty("statementCacheHits", 0, &SessionImpl::getStatementCacheHits);
+	addProperty("statementCacheMisses", 0, &SessionImpl::getStatementCacheMisses);
 	open();
 }
 
@@ -81,7 +85,7 @@ SessionImpl::~SessionImpl()
 Poco::Data::StatementImpl* SessionImpl::createStatementImpl()
 {
 	poco_check_ptr (_pDB);
-	return new SQLiteStatementImpl(_pDB, _maxRetryAttempts, _minRetrySleep, _maxRetrySleep);
+	return new SQLiteStatementImpl(_pDB, _maxRetryAttempts, _minRetrySleep, _maxRetrySleep, _pStatementCache);
 }
 
 
@@ -128,6 +132,7 @@ void SessionImpl::close()
 {
 	if (_pDB)
 	{
+		_pStatementCache->close();
 		sqlite3_close(_pDB);
 		_pDB = 0;
 	}
@@ -205,4 +210,31 @@ Poco::Any SessionImpl::getMaxRetrySleep(const std::string& prop)
 }
 
 
+void SessionImpl::setStatementCacheSize(const std::string& prop, const Poco::Any& value)
+{
+	int statementCacheSize = Poco::RefAnyCast<int>(value);
+	if (statementCacheSize < 0) throw Poco::InvalidArgumentException("statementCacheSize must be >= 0");
+
+	_pStatementCache->setCapacity(statementCacheSize);
+}
+
+
+Poco::Any SessionImpl::getStatementCacheSize(const std::string& prop)
+{
+	return Poco::Any(static_cast<int>(_pStatementCache->capacity()));
+}
+
+
+Poco::Any SessionImpl::getStatementCacheHits(const std::string& prop)
+{
+	return Poco::Any(_pStatementCache->hits());
+}
+
+
+Poco::Any SessionImpl::getStatementCacheMisses(const std::string& prop)
+{
+	return Poco::Any(_pStatementCache->misses());
+}
+
+
 } } } // namespace Poco::Data::SQLite
@@ -0,0 +1,242 @@
+//
+// StatementCache.cpp
+//
+// $Id: //poco/1.4/Data/SQLite/src/StatementCache.cpp#1 $
+//
+// Library: Data/SQLite
+// Package: SQLite
+// Module:  StatementCache
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Data/SQLite/StatementCache.h"
+#include "Poco/String.h"
+#include "Poco/Ascii.h"
+#if defined(POCO_UNBUNDLED)
+#include <sqlite3.h>
+#else
+#include "sqlite3.h"
+#endif
+
+
+namespace Poco {
+namespace Data {
+namespace SQLite {
+
+
+StatementCache::StatementCache(std::size_t capacity):
+	_capacity(capacity),
+	_closed(false),
+	_generation(0),
+	_hits(0),
+	_misses(0)
+{
+}
+
+
+StatementCache::~StatementCache()
+{
+	clear();
+}
+
+
+sqlite3_stmt* StatementCache::get(const std::string& sql)
+{
+	Kind kind = kindOf(sql);
+	if (SK_DML != kind)
+	{
+		if (SK_SCHEMA == kind)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			evict(0);
+			++_generation;
+		}
+		return 0;
+	}
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	EntryMap::iterator it = _entries.find(sql);
+	if (it == _entries.end())
+	{
+		++_misses;
+		return 0;
+	}
+	++_hits;
+	sqlite3_stmt* pStmt = it->second.pStmt;
+	_keys.erase(it->second.lru);
+	_entries.erase(it);
+	return pStmt;
+}
+
+
+void StatementCache::put(const std::string& sql, sqlite3_stmt* pStmt, Poco::UInt32 generation)
+{
+	if (!pStmt) return;
+
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (!_closed && _capacity > 0 && generation == _generation &&
+			_entries.find(sql) == _entries.end() && SK_DML == kindOf(sql))
+		{
+			sqlite3_reset(pStmt);
+			sqlite3_clear_bindings(pStmt);
+
+			Entry entry;
+			entry.pStmt = pStmt;
+			entry.lru   = _keys.insert(_keys.begin(), sql);
+			_entries.insert(EntryMap::value_type(sql, entry));
+			evict(_capacity);
+			return;
+		}
+	}
+	sqlite3_finalize(pStmt);
+}
+
+
+void StatementCache::clear()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	evict(0);
+}
+
+
+void StatementCache::close()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	evict(0);
+	_closed = true;
+}
+
+
+void StatementCache::setCapacity(std::size_t capacity)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_capacity = capacity;
+	evict(_capacity);
+}
+
+
+std::size_t StatementCache::capacity() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _capacity;
+}
+
+
+std::size_t StatementCache::size() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _entries.size();
+}
+
+
+Poco::UInt32 StatementCache::generation() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _generation;
+}
+
+
+Poco::UInt64 StatementCache::hits() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _hits;
+}
+
+
+Poco::UInt64 StatementCache::misses() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _misses;
+}
+
+
+bool StatementCache::isCacheable(const std::string& sql)
+{
+	return SK_DML == kindOf(sql);
+}
+
+
+bool StatementCache::changesSchema(const std::string& sql)
+{
+	return SK_SCHEMA == kindOf(sql);
+}
+
+
+void StatementCache::evict(std::size_t capacity)
+{
+	while (_entries.size() > capacity)
+	{
+		EntryMap::iterator it = _entries.find(_keys.back());
+		poco_assert_dbg (it != _entries.end());
+		sqlite3_finalize(it->second.pStmt);
+		_entries.erase(it);
+		_keys.pop_back();
+	}
+}
+
+
+StatementCache::Kind StatementCache::kindOf(const std::string& sql)
+{
+	std::string::const_iterator it  = sql.begin();
+	std::string::const_iterator end = sql.end();
+	while (it != end && (Poco::Ascii::isSpace(*it) || *it == '(')) ++it;
+	std::string::const_iterator beg = it;
+	while (it != end && Poco::Ascii::isAlpha(*it)) ++it;
+	std::string keyword(beg, it);
+
+	if (Poco::icompare(keyword, "SELECT") == 0 ||
+		Poco::icompare(keyword, "INSERT") == 0 ||
+		Poco::icompare(keyword, "UPDATE") == 0 ||
+		Poco::icompare(keyword, "DELETE") == 0 ||
+		Poco::icompare(keyword, "REPLACE") == 0 ||
+		Poco::icompare(keyword, "WITH") == 0)
+		return SK_DML;
+	else if (Poco::icompare(keyword, "CREATE") == 0 ||
+		Poco::icompare(keyword, "DROP") == 0 ||
+		Poco::icompare(keyword, "ALTER") == 0 ||
+		Poco::icompare(keyword, "ATTACH") == 0 ||
+		Poco::icompare(keyword, "DETACH") == 0)
+		return SK_SCHEMA;
+	else
+		return SK_OTHER;
+}
+
+
+} } } // namespace Poco::Data::SQLite
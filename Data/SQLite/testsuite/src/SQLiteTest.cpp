@@ -44,7 +44,10 @@
 #include <iostream>
 #include "Poco/File.h"
 #include "Poco/Stopwatch.h"
+#include "Poco/NumberFormatter.h"
 #include "Poco/Data/SQLite/SQLiteException.h"
+#include "Poco/Data/SQLite/StatementCache.h"
+#include "Poco/Data/SQLite/LOBStream.h"
 
 
 using namespace Poco::Data;
@@ -54,7 +57,10 @@ using Poco::AnyCast;
 using Poco::InvalidAccessException;
 using Poco::RangeException;
 using Poco::BadCastException;
+using Poco::NotFoundException;
 using Poco::Data::SQLite::ParameterCountMismatchException;
+using Poco::Data::SQLite::LOBInputStream;
+using Poco::Data::SQLite::LOBOutputStream;
 
 
 struct Person
@@ -1540,6 +1546,396 @@ void SQLiteTest::testInternalExtraction()
 }
 
 
+void SQLiteTest::testRecordSetColumnData()
+{
+	Session tmp (SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Vectors", now;
+	tmp << "CREATE TABLE Vectors (int0 INTEGER, flt0 REAL, str0 VARCHAR)", now;
+
+	std::vector<Tuple<int, double, std::string> > v;
+	v.push_back(Tuple<int, double, std::string>(1, 1.5, "3"));
+	v.push_back(Tuple<int, double, std::string>(2, 2.5, "4"));
+	v.push_back(Tuple<int, double, std::string>(3, 3.5, "5"));
+	tmp << "INSERT INTO Vectors VALUES (?,?,?)", use(v), now;
+
+	RecordSet rset((tmp << "SELECT * FROM Vectors", now));
+	assert (0 == rset.columnPosition("int0"));
+	assert (1 == rset.columnPosition("FLT0"));
+	assert (2 == rset.columnPosition("Str0"));
+	try { rset.columnPosition("str1"); fail ("must fail"); }
+	catch (NotFoundException&) { }
+
+	const std::vector<int>& ints = rset.columnData<int>(0);
+	assert (3 == ints.size());
+	assert (1 == ints[0] && 2 == ints[1] && 3 == ints[2]);
+	const std::vector<double>& dbls = rset.columnData<double>("flt0");
+	assert (3 == dbls.size());
+	assert (1.5 == dbls[0] && 3.5 == dbls[2]);
+	try { rset.columnData<std::string>(0); fail ("must fail"); }
+	catch (BadCastException&) { }
+
+	assert (rset.moveFirst());
+	assert (1 == rset.get<int>(0));
+	assert ("3" == rset.get<std::string>("str0"));
+	assert (rset.moveNext());
+	assert (2.5 == rset.get<double>("FLT0"));
+	assert (rset.moveLast());
+	assert (3 == rset.get<int>("int0"));
+	assert (3 == rset.value("int0").convert<int>());
+
+	rset = (tmp << "SELECT str0 AS s, int0 AS i FROM Vectors", now);
+	assert (0 == rset.columnPosition("s"));
+	assert (1 == rset.columnPosition("i"));
+	assert (MetaColumn::FDT_INT32 == rset.columnType("i"));
+	try { rset.columnPosition("int0"); fail ("must fail"); }
+	catch (NotFoundException&) { }
+
+	// access by name picks the first column of the requested type
+	rset = (tmp << "SELECT str0 AS x, int0 AS x FROM Vectors", now);
+	assert (0 == rset.columnPosition("x"));
+	assert (0 == rset.column<std::string>("x").position());
+	assert (1 == rset.column<int>("X").position());
+	assert (rset.moveFirst());
+	assert ("3" == rset.get<std::string>("x"));
+	assert (1 == rset.get<int>("x"));
+	assert (3 == rset.value<int>("x", 2));
+	try { rset.column<double>("x"); fail ("must fail"); }
+	catch (NotFoundException&) { }
+}
+
+
+void SQLiteTest::testRecordSetPerformance()
+{
+	Session tmp (SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Numbers", now;
+	tmp << "CREATE TABLE Numbers (int0 INTEGER, flt0 REAL)", now;
+
+	const int ROWS = 1000000;
+	std::vector<int> ints(ROWS);
+	std::vector<double> dbls(ROWS);
+	for (int i = 0; i < ROWS; ++i)
+	{
+		ints[i] = i;
+		dbls[i] = i + 0.5;
+	}
+	tmp.begin();
+	tmp << "INSERT INTO Numbers VALUES (?,?)", use(ints), use(dbls), now;
+	tmp.commit();
+
+	Poco::Stopwatch sw;
+	sw.start();
+	RecordSet rset((tmp << "SELECT * FROM Numbers", now));
+	sw.stop();
+	std::cout << "select " << rset.rowCount() << " rows: " << sw.elapsed()/1000 << " ms" << std::endl;
+	assert (ROWS == rset.rowCount());
+
+	double sum = 0;
+	sw.restart();
+	for (std::size_t row = 0; row < ROWS; ++row)
+		sum += rset.value(0, row).convert<double>() + rset.value("flt0", row).convert<double>();
+	sw.stop();
+	std::cout << "DynamicAny value(): " << sw.elapsed()/1000 << " ms" << std::endl;
+
+	double sum2 = 0;
+	sw.restart();
+	rset.moveFirst();
+	do
+	{
+		sum2 += rset.get<int>(0) + rset.get<double>("flt0");
+	}
+	while (rset.moveNext());
+	sw.stop();
+	std::cout << "typed get(): " << sw.elapsed()/1000 << " ms" << std::endl;
+	assert (sum == sum2);
+
+	double sum3 = 0;
+	sw.restart();
+	const std::vector<int>& ints2 = rset.columnData<int>(0);
+	const std::vector<double>& dbls2 = rset.columnData<double>("flt0");
+	for (std::size_t row = 0; row < ROWS; ++row)
+		sum3 += ints2[row] + dbls2[row];
+	sw.stop();
+	std::cout << "columnData(): " << sw.elapsed()/1000 << " ms" << std::endl;
+	assert (sum == sum3);
+}
+
+
+void SQLiteTest::testFetch()
+{
+	Session tmp (SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Ints", now;
+	tmp << "CREATE TABLE Ints (int0 INTEGER)", now;
+
+	std::vector<int> v;
+	for (int i = 0; i < 10; ++i) v.push_back(i);
+	tmp << "INSERT INTO Ints VALUES (?)", use(v), now;
+
+	std::vector<int> ints;
+	Statement stmt = (tmp << "SELECT int0 FROM Ints ORDER BY int0", into(ints));
+	assert (4 == stmt.fetch(4));
+	assert (4 == ints.size() && 0 == ints[0] && 3 == ints[3]);
+	assert (!stmt.done());
+	assert (4 == stmt.fetch(4));
+	assert (4 == ints.size() && 4 == ints[0] && 7 == ints[3]);
+	assert (2 == stmt.fetch(4));
+	assert (2 == ints.size() && 8 == ints[0] && 9 == ints[1]);
+	assert (stmt.done());
+	assert (0 == stmt.fetch(4));
+	assert (2 == ints.size());
+
+	// an exhausted statement is restarted by execute()
+	assert (10 == stmt.execute());
+	assert (12 == ints.size());
+
+	int i = -1;
+	int sum = 0;
+	Statement single = (tmp << "SELECT int0 FROM Ints", into(i));
+	while (single.fetch(1)) sum += i;
+	assert (45 == sum);
+
+	Statement internal = (tmp << "SELECT int0 FROM Ints ORDER BY int0");
+	assert (3 == internal.fetch(3));
+	RecordSet rset(internal);
+	assert (3 == rset.rowCount());
+	assert (2 == rset.value<int>("int0", 2));
+	sum = 0;
+	do
+	{
+		for (std::size_t row = 0; row < rset.rowCount(); ++row)
+			sum += rset.value<int>(0, row);
+	}
+	while (internal.fetch(3));
+	assert (45 == sum);
+}
+
+
+void SQLiteTest::testAsync()
+{
+	Session tmp (SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Ints", now;
+	tmp << "CREATE TABLE Ints (int0 INTEGER)", now;
+
+	std::vector<int> v;
+	for (int i = 0; i < 100; ++i) v.push_back(i);
+	tmp << "INSERT INTO Ints VALUES (?)", use(v), now;
+
+	Session s1 (SQLite::Connector::KEY, "dummy.db");
+	Session s2 (SQLite::Connector::KEY, "dummy.db");
+	std::vector<int> ints1;
+	std::vector<int> ints2;
+	Statement stmt1 = (s1 << "SELECT int0 FROM Ints WHERE int0 < 50", into(ints1));
+	Statement stmt2 = (s2 << "SELECT int0 FROM Ints WHERE int0 >= 50", into(ints2));
+	Statement::Result result1 = stmt1.executeAsync();
+	stmt2.executeAsync();
+	assert (50 == stmt2.wait());
+	assert (50 == stmt1.wait());
+	assert (result1.available() && 50 == result1.data());
+	assert (!stmt1.isAsyncPending());
+	assert (50 == ints1.size() && 50 == ints2.size());
+
+	// a completed statement is executed again; the earlier
+	// result stays valid
+	Statement::Result result2 = stmt1.executeAsync();
+	assert (50 == stmt1.wait(10000));
+	assert (100 == ints1.size());
+	assert (result1.available() && 50 == result1.data());
+	assert (result2.available() && 50 == result2.data());
+	assert (50 == stmt1.execute());
+	assert (150 == ints1.size());
+
+	// copies share the asynchronous execution, whenever they were made
+	Statement copy(stmt1);
+	stmt1.executeAsync();
+	assert (50 == copy.wait());
+	assert (200 == ints1.size());
+	copy.executeAsync();
+	{
+		Statement last(copy);
+		copy = stmt2;
+		stmt1 = stmt2;
+	}
+	assert (250 == ints1.size());
+
+	Statement failing = (s1 << "SELECT * FROM NoSuchTable");
+	failing.executeAsync();
+	try
+	{
+		failing.wait();
+		fail ("must fail");
+	}
+	catch (Poco::Exception&)
+	{
+	}
+
+	Statement notAsync = (s2 << "SELECT COUNT(*) FROM Ints");
+	try
+	{
+		notAsync.wait();
+		fail ("must fail");
+	}
+	catch (InvalidAccessException&)
+	{
+	}
+}
+
+
+void SQLiteTest::testLOBStream()
+{
+	Session tmp (SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Images", now;
+	tmp << "CREATE TABLE Images (name VARCHAR(30), data BLOB)", now;
+
+	const int size = 300000;
+	std::string name("image");
+	int lobSize = size;
+	tmp << "INSERT INTO Images VALUES (?, zeroblob(?))", use(name), use(lobSize), now;
+	Poco::Int64 rowID = 0;
+	tmp << "SELECT last_insert_rowid()", into(rowID), now;
+
+	{
+		LOBOutputStream out(tmp, "Images", "data", rowID);
+		assert (out.size() == size);
+		for (int i = 0; i < size; ++i) out.put(char(i % 251));
+		assert (out.good());
+		out.close();
+	}
+
+	{
+		LOBInputStream in(tmp, "Images", "data", rowID);
+		assert (in.size() == size);
+		int i = 0;
+		int c = in.get();
+		while (c != -1)
+		{
+			assert (char(c) == char(i % 251));
+			++i;
+			c = in.get();
+		}
+		assert (i == size);
+	}
+
+	BLOB blob;
+	tmp << "SELECT data FROM Images", into(blob), now;
+	assert (blob.size() == size);
+	assert (blob.rawContent()[size - 1] == char((size - 1) % 251));
+
+	{
+		LOBOutputStream out(tmp, "Images", "data", rowID);
+		std::string tooLong(size + 1, 'x');
+		out << tooLong << std::flush;
+		assert (out.bad());
+	}
+
+	try
+	{
+		LOBInputStream in(tmp, "Images", "data", rowID + 1);
+		fail ("must fail");
+	}
+	catch (SQLite::SQLiteException&)
+	{
+	}
+
+	int smallSize = 10;
+	tmp << "INSERT INTO Images VALUES (?, zeroblob(?))", use(name), use(smallSize), now;
+	Poco::Int64 smallRowID = 0;
+	tmp << "SELECT last_insert_rowid()", into(smallRowID), now;
+	{
+		// pending output that does not fit is reported by close()
+		LOBOutputStream out(tmp, "Images", "data", smallRowID);
+		out << std::string(smallSize + 1, 'x');
+		assert (out.good());
+		try
+		{
+			out.close();
+			fail ("must fail");
+		}
+		catch (SQLite::SQLiteException&)
+		{
+		}
+	}
+	{
+		// but not by the destructor
+		LOBOutputStream out(tmp, "Images", "data", smallRowID);
+		out << std::string(smallSize + 1, 'x');
+	}
+}
+
+
+void SQLiteTest::testStringArena()
+{
+	Session tmp (SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Strings", now;
+	tmp << "CREATE TABLE Strings (str VARCHAR(30))", now;
+
+	std::vector<std::string> data;
+	for (int i = 0; i < 100; ++i) data.push_back(Poco::NumberFormatter::format(i));
+	tmp << "INSERT INTO Strings VALUES (?)", use(data), now;
+	tmp << "INSERT INTO Strings VALUES (NULL)", now;
+
+	StringArena arena;
+	tmp << "SELECT str FROM Strings", into(arena), now;
+	assert (arena.size() == 101);
+	for (int i = 0; i < 100; ++i)
+	{
+		assert (!arena.isNull(i));
+		assert (arena.equals(i, data[i]));
+	}
+	assert (arena.isNull(100));
+	assert (arena[100].empty());
+
+	arena.clear();
+	tmp << "SELECT str FROM Strings WHERE str IS NULL", into(arena, std::string("null")), now;
+	assert (arena.size() == 1);
+	assert (!arena.isNull(0));
+	assert (arena[0] == "null");
+
+	StringArena window;
+	Statement stmt = (tmp << "SELECT str FROM Strings", into(window));
+	std::size_t total = 0;
+	std::size_t rows;
+	while ((rows = stmt.fetch(30)) > 0)
+	{
+		assert (window.size() == rows);
+		for (std::size_t i = 0; i < rows; ++i)
+		{
+			if (total + i < 100) assert (window.equals(i, data[total + i]));
+		}
+		total += rows;
+	}
+	assert (total == 101);
+}
+
+
+void SQLiteTest::testStringArenaPerformance()
+{
+	Session tmp (SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS Strings", now;
+	tmp << "CREATE TABLE Strings (str VARCHAR(30))", now;
+
+	const int rows = 200000;
+	std::vector<std::string> data;
+	for (int i = 0; i < rows; ++i) data.push_back("string value number " + Poco::NumberFormatter::format(i));
+	tmp.begin();
+	tmp << "INSERT INTO Strings VALUES (?)", use(data), now;
+	tmp.commit();
+
+	Poco::Stopwatch sw;
+	std::vector<std::string> strings;
+	sw.start();
+	tmp << "SELECT str FROM Strings", into(strings), now;
+	sw.stop();
+	assert (strings.size() == rows);
+	std::cout << "vector<string>: " << sw.elapsed() / 1000 << " [ms]" << std::endl;
+
+	StringArena arena;
+	sw.restart();
+	tmp << "SELECT str FROM Strings", into(arena), now;
+	sw.stop();
+	assert (arena.size() == rows);
+	std::cout << "StringArena: " << sw.elapsed() / 1000 << " [ms]" << std::endl;
+}
+
+
 void SQLiteTest::testBindingCount()
 {
 	Session tmp (SQLite::Connector::KEY, "dummy.db");
@@ -1563,6 +1959,60 @@ void SQLiteTest::testBindingCount()
 }
 
 
+void SQLiteTest::testStatementCache()
+{
+	Session tmp (SQLite::Connector::KEY, "dummy.db");
+	assert (AnyCast<int>(tmp.getProperty("statementCacheSize")) == SQLite::StatementCache::DEFAULT_CAPACITY);
+
+	tmp << "DROP TABLE IF EXISTS Ints", now;
+	tmp << "CREATE TABLE Ints (int0 INTEGER)", now;
+
+	Poco::UInt64 hits = AnyCast<Poco::UInt64>(tmp.getProperty("statementCacheHits"));
+	Poco::UInt64 misses = AnyCast<Poco::UInt64>(tmp.getProperty("statementCacheMisses"));
+	for (int i = 0; i < 10; ++i)
+	{
+		tmp << "INSERT INTO Ints VALUES (?)", use(i), now;
+	}
+	assert (AnyCast<Poco::UInt64>(tmp.getProperty("statementCacheMisses")) == misses + 1);
+	assert (AnyCast<Poco::UInt64>(tmp.getProperty("statementCacheHits")) == hits + 9);
+
+	// a statement that is still alive keeps its handle checked out
+	Statement stmt = (tmp << "SELECT COUNT(*) FROM Ints", now);
+	int count = 0;
+	tmp << "SELECT COUNT(*) FROM Ints", into(count), now;
+	assert (10 == count);
+	assert (AnyCast<Poco::UInt64>(tmp.getProperty("statementCacheMisses")) == misses + 3);
+
+	// schema changes flush the cache; no stale column metadata must be used
+	std::vector<int> ints;
+	tmp << "SELECT * FROM Ints", into(ints), now;
+	assert (10 == ints.size());
+	tmp << "DROP TABLE Ints", now;
+	tmp << "CREATE TABLE Ints (int0 INTEGER, int1 INTEGER)", now;
+	tmp << "INSERT INTO Ints VALUES (?, ?)", use(count), use(count), now;
+	std::vector<int> ints0;
+	std::vector<int> ints1;
+	tmp << "SELECT * FROM Ints", into(ints0), into(ints1), now;
+	assert (1 == ints0.size() && 10 == ints0[0]);
+	assert (1 == ints1.size() && 10 == ints1[0]);
+
+	tmp.setProperty("statementCacheSize", 0);
+	hits = AnyCast<Poco::UInt64>(tmp.getProperty("statementCacheHits"));
+	tmp << "SELECT * FROM Ints", into(ints0), into(ints1), now;
+	tmp << "SELECT * FROM Ints", into(ints0), into(ints1), now;
+	assert (AnyCast<Poco::UInt64>(tmp.getProperty("statementCacheHits")) == hits);
+
+	try
+	{
+		tmp.setProperty("statementCacheHits", Poco::UInt64(0));
+		fail ("statementCacheHits is read-only - must throw");
+	}
+	catch (Poco::Data::NotImplementedException&)
+	{
+	}
+}
+
+
 void SQLiteTest::setUp()
 {
 }
@@ -1632,7 +2082,15 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testTuple1);
 	CppUnit_addTest(pSuite, SQLiteTest, testTupleVector1);
 	CppUnit_addTest(pSuite, SQLiteTest, testInternalExtraction);
+	CppUnit_addTest(pSuite, SQLiteTest, testRecordSetColumnData);
+	//CppUnit_addTest(pSuite, SQLiteTest, testRecordSetPerformance);
+	CppUnit_addTest(pSuite, SQLiteTest, testFetch);
+	CppUnit_addTest(pSuite, SQLiteTest, testAsync);
+	CppUnit_addTest(pSuite, SQLiteTest, testLOBStream);
+	CppUnit_addTest(pSuite, SQLiteTest, testStringArena);
+	//CppUnit_addTest(pSuite, SQLiteTest, testStringArenaPerformance);
 	CppUnit_addTest(pSuite, SQLiteTest, testBindingCount);
+	CppUnit_addTest(pSuite, SQLiteTest, testStatementCache);
 
 	return pSuite;
 }
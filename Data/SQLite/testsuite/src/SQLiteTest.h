@@ -107,7 +107,15 @@ public:
 	void testTupleVector10();
 
 	void testInternalExtraction();
+	void testRecordSetColumnData();
+	void testRecordSetPerformance();
+	void testFetch();
+	void testAsync();
+	void testLOBStream();
+	void testStringArena();
+	void testStringArenaPerformance();
 	void testBindingCount();
+	void testStatementCache();
 
 	void setUp();
 	void tearDown();
@@ -97,6 +97,13 @@ public:
 	virtual void reset() = 0;
 		/// Resets the etxractor so that it can be re-used.
 
+	virtual void clear();
+		/// Removes all previously extracted values from the
+		/// result container. Called by Statement::fetch() before
+		/// extracting the next window of rows.
+		///
+		/// The default implementation does nothing.
+
 	virtual AbstractPrepare* createPrepareObject(AbstractPreparation* pPrep, std::size_t pos) const = 0;
 		/// Creates a Prepare object for the etxracting object
 
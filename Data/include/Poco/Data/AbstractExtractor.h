@@ -42,6 +42,7 @@
 
 #include "Poco/Data/Data.h"
 #include <cstddef>
+#include <string>
 
 
 namespace Poco {
@@ -49,6 +50,7 @@ namespace Data {
 
 
 class BLOB;
+class StringArena;
 
 
 class Data_API AbstractExtractor
@@ -103,6 +105,19 @@ public:
 
 	virtual bool extract(std::size_t pos, BLOB& val) = 0;
 		/// Extracts a BLOB. Returns false if null was received.
+
+	virtual bool extract(std::size_t pos, StringArena& val);
+		/// Extracts a string and appends it to the given StringArena.
+		/// Returns false if null was received, in which case nothing
+		/// is appended.
+		///
+		/// The default implementation extracts into a std::string that
+		/// is reused for every call and copies it into the arena.
+		/// Connectors that have direct access to the column data should
+		/// override this to append without the intermediate copy.
+
+private:
+	std::string _string;
 };
 
 
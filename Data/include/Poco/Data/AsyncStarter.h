@@ -0,0 +1,86 @@
+//
+// AsyncStarter.h
+//
+// $Id: //poco/1.4/Data/include/Poco/Data/AsyncStarter.h#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  AsyncStarter
+//
+// Definition of the AsyncStarter class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Data_AsyncStarter_INCLUDED
+#define Data_AsyncStarter_INCLUDED
+
+
+#include "Poco/Data/Data.h"
+#include "Poco/ActiveRunnable.h"
+#include "Poco/ThreadPool.h"
+
+
+namespace Poco {
+namespace Data {
+
+
+class StatementImpl;
+
+
+class Data_API AsyncStarter
+	/// The StarterType policy for the ActiveMethod used by
+	/// Statement::executeAsync().
+	///
+	/// Asynchronous statement executions run on a thread pool
+	/// owned by the Data library (see pool()), so that long running
+	/// queries do not use up the threads of ThreadPool::defaultPool().
+{
+public:
+	enum
+	{
+		MIN_THREADS = 2,  /// Minimum number of threads in the pool.
+		MAX_THREADS = 32  /// Maximum number of threads in the pool.
+	};
+
+	static void start(StatementImpl* pOwner, ActiveRunnableBase::Ptr pRunnable);
+		/// Starts the given runnable in the pool.
+		///
+		/// Throws a NoThreadAvailableException if all 
+		/// threads of the pool are busy.
+
+	static ThreadPool& pool();
+		/// Returns the thread pool used for asynchronous
+		/// statement execution. The pool is created on
+		/// first use.
+};
+
+
+} } // namespace Poco::Data
+
+
+#endif // Data_AsyncStarter_INCLUDED
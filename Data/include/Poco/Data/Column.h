@@ -100,6 +100,12 @@ public:
 		return *_pData;
 	}
 
+	const DataVec& data() const
+		/// Returns const reference to contained data.
+	{
+		return *_pData;
+	}
+
 	const T& value(std::size_t row) const
 		/// Returns the field value in specified row.
 	{
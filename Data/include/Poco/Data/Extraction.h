@@ -46,6 +46,7 @@
 #include "Poco/Data/TypeHandler.h"
 #include "Poco/Data/Column.h"
 #include "Poco/Data/DataException.h"
+#include "Poco/Data/StringArena.h"
 #include <set>
 #include <vector>
 #include <list>
@@ -158,6 +159,11 @@ public:
 	{
 	}
 
+	void clear()
+	{
+		_rResult.clear();
+	}
+
 	AbstractPrepare* createPrepareObject(AbstractPreparation* pPrep, std::size_t pos) const
 	{
 		return new Prepare<T>(pPrep, pos, _default);
@@ -218,6 +224,11 @@ public:
 	{
 	}
 
+	void clear()
+	{
+		_rResult.clear();
+	}
+
 	AbstractPrepare* createPrepareObject(AbstractPreparation* pPrep, std::size_t pos) const
 	{
 		return new Prepare<T>(pPrep, pos, _default);
@@ -337,6 +348,11 @@ public:
 	{
 	}
 
+	void clear()
+	{
+		_rResult.clear();
+	}
+
 	AbstractPrepare* createPrepareObject(AbstractPreparation* pPrep, std::size_t pos) const
 	{
 		return new Prepare<T>(pPrep, pos, _default);
@@ -391,6 +407,11 @@ public:
 	{
 	}
 
+	void clear()
+	{
+		_rResult.clear();
+	}
+
 	AbstractPrepare* createPrepareObject(AbstractPreparation* pPrep, std::size_t pos) const
 	{
 		return new Prepare<T>(pPrep, pos, _default);
@@ -445,6 +466,11 @@ public:
 	{
 	}
 
+	void clear()
+	{
+		_rResult.clear();
+	}
+
 	AbstractPrepare* createPrepareObject(AbstractPreparation* pPrep, std::size_t pos) const
 	{
 		return new Prepare<V>(pPrep, pos, _default);
@@ -500,6 +526,11 @@ public:
 	{
 	}
 
+	void clear()
+	{
+		_rResult.clear();
+	}
+
 	AbstractPrepare* createPrepareObject(AbstractPreparation* pPrep, std::size_t pos) const
 	{
 		return new Prepare<V>(pPrep, pos, _default);
@@ -511,6 +542,73 @@ private:
 };
 
 
+template <>
+class Extraction<StringArena>: public AbstractExtraction
+	/// StringArena specialization for extraction of string values from a query result set.
+	///
+	/// Null values are stored as null entries in the arena, unless a default
+	/// value has been given, in which case the default value is stored.
+{
+public:
+	Extraction(StringArena& result): _rResult(result), _default(), _hasDefault(false)
+	{
+	}
+
+	Extraction(StringArena& result, const std::string& def): _rResult(result), _default(def), _hasDefault(true)
+	{
+	}
+
+	virtual ~Extraction()
+	{
+	}
+
+	std::size_t numOfColumnsHandled() const
+	{
+		return 1u;
+	}
+
+	std::size_t numOfRowsHandled() const
+	{
+		return _rResult.size();
+	}
+
+	std::size_t numOfRowsAllowed() const
+	{
+		return getLimit();
+	}
+
+	void extract(std::size_t pos)
+	{
+		if (!getExtractor()->extract(pos, _rResult))
+		{
+			if (_hasDefault)
+				_rResult.append(_default);
+			else
+				_rResult.appendNull();
+		}
+	}
+
+	virtual void reset()
+	{
+	}
+
+	void clear()
+	{
+		_rResult.clear();
+	}
+
+	AbstractPrepare* createPrepareObject(AbstractPreparation* pPrep, std::size_t pos) const
+	{
+		return new Prepare<std::string>(pPrep, pos, _default);
+	}
+
+private:
+	StringArena& _rResult;
+	std::string  _default;
+	bool         _hasDefault;
+};
+
+
 template <typename T> Extraction<T>* into(T& t)
 	/// Convenience function to allow for a more compact creation of a default extraction object
 {
@@ -525,6 +623,14 @@ template <typename T> Extraction<T>* into(T& t, const T& def)
 }
 
 
+inline Extraction<StringArena>* into(StringArena& t, const std::string& def)
+	/// Convenience function to create a StringArena extraction object
+	/// that stores the given default for null values.
+{
+	return new Extraction<StringArena>(t, def);
+}
+
+
 } } // namespace Poco::Data
 
 
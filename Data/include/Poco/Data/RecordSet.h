@@ -47,6 +47,9 @@
 #include "Poco/String.h"
 #include "Poco/DynamicAny.h"
 #include "Poco/Exception.h"
+#include <map>
+#include <vector>
+#include <typeinfo>
 
 
 namespace Poco {
@@ -71,6 +74,14 @@ class Data_API RecordSet: private Statement
 	///
 	/// The number of rows in the RecordSet can be limited by specifying
 	/// a limit for the Statement.
+	///
+	/// The values of each column are stored contiguously in a std::vector
+	/// of the column's type. For bulk processing, columnData() gives direct
+	/// access to these vectors, and get() reads a typed value from the
+	/// current row; neither goes through DynamicAny. Column names are
+	/// resolved through a name to position map that is built once, when
+	/// the RecordSet is created or assigned, and the typed Column for a
+	/// position is only looked up (with dynamic_cast) on its first access.
 {
 public:
 	explicit RecordSet(const Statement& rStatement);
@@ -88,37 +99,61 @@ public:
 	std::size_t columnCount() const;
 		/// Returns the number of rows in the recordset.
 
+	std::size_t columnPosition(const std::string& name) const;
+		/// Returns the position of the first column with the specified
+		/// (case insensitive) name.
+		///
+		/// Throws a NotFoundException if there is no such column.
+
 	template<class T>
 	const Column<T>& column(const std::string& name) const
-		/// Returns the reference to the first Column with the specified name.
+		/// Returns the reference to the first Column of type T
+		/// with the specified name.
 	{
-		return column<T>(columnPosition<T>(name));
+		std::size_t pos = columnPosition(name);
+		const Column<T>* pColumn = findColumn<T>(pos);
+		if (!pColumn)
+		{
+			// a later column with the same name may have the requested type
+			std::size_t count = columnCount();
+			for (++pos; !pColumn && pos < count; ++pos)
+			{
+				if (0 == Poco::icompare(name, columnName(pos)))
+					pColumn = findColumn<T>(pos);
+			}
+			if (!pColumn) throw NotFoundException(format("Unknown column name: %s", name));
+		}
+		return *pColumn;
 	}
 
 	template<class T>
 	const Column<T>& column(std::size_t pos) const
 		/// Returns the reference to column at specified location.
 	{
-		typedef const InternalExtraction<T>* ExtractionVecPtr;
-
-		const AbstractExtractionVec& rExtractions = extractions();
-
-		std::size_t s = rExtractions.size();
-		if (0 == s || pos >= s)
-			throw RangeException(format("Invalid column index: %z", pos));
-		
-		ExtractionVecPtr pExtraction = dynamic_cast<ExtractionVecPtr>(rExtractions[pos].get());
-
-		if (pExtraction)
-		{
-			return pExtraction->column();
-		}
-		else 
+		const Column<T>* pColumn = findColumn<T>(pos);
+		if (!pColumn)
 		{
 			throw Poco::BadCastException(format("Type cast failed!\nColumn: %z\nTarget type:\t%s",  
 				pos,
 				std::string(typeid(T).name())));
 		}
+		return *pColumn;
+	}
+
+	template<class T>
+	const std::vector<T>& columnData(std::size_t pos) const
+		/// Returns the reference to the contiguous storage of the values 
+		/// of the column at specified location, indexed by row.
+	{
+		return column<T>(pos).data();
+	}
+
+	template<class T>
+	const std::vector<T>& columnData(const std::string& name) const
+		/// Returns the reference to the contiguous storage of the values 
+		/// of the first column with the specified name, indexed by row.
+	{
+		return column<T>(name).data();
 	}
 
 	template<class T>
@@ -178,6 +213,22 @@ public:
 	DynamicAny operator [] (std::size_t index);
 		/// Returns the value in the named column of the current row.
 
+	template<class T>
+	const T& get(std::size_t col) const
+		/// Returns the reference to the value in the given column
+		/// of the current row.
+	{
+		return column<T>(col).value(_currentRow);
+	}
+
+	template<class T>
+	const T& get(const std::string& name) const
+		/// Returns the reference to the value in the named column
+		/// of the current row.
+	{
+		return column<T>(name).value(_currentRow);
+	}
+
 	MetaColumn::ColumnDataType columnType(std::size_t pos) const;
 		/// Returns the type for the column at specified position.
 
@@ -202,34 +253,47 @@ public:
 		/// Valid for floating point fields only (zero for other data types).
 
 private:
+	typedef std::map<std::string, std::size_t> PositionMap;
+
+	struct TypedColumn
+		/// The Column found by the last typed access to a position.
+	{
+		const std::type_info* pType;
+		const void*           pColumn;
+	};
+	typedef std::vector<TypedColumn> TypedColumnVec;
+
 	RecordSet();
 
+	void buildPositionMap();
+		/// Maps the (lower case) column names to column positions,
+		/// and resets the typed Column cache.
+
 	template<class T>
-	std::size_t columnPosition(const std::string& name) const
-		/// Returns the position of the column with specified name.
+	const Column<T>* findColumn(std::size_t pos) const
+		/// Returns the column at the specified location, or null
+		/// if the column's type is not T.
 	{
 		typedef const InternalExtraction<T>* ExtractionVecPtr;
 
-		const AbstractExtractionVec& rExtractions = extractions();
-		AbstractExtractionVec::const_iterator it = rExtractions.begin();
-		AbstractExtractionVec::const_iterator end = rExtractions.end();
-		
-		for (; it != end; ++it)
-		{
-			ExtractionVecPtr pExtraction = dynamic_cast<ExtractionVecPtr>(it->get());
+		if (pos >= _typedColumns.size())
+			throw RangeException(format("Invalid column index: %z", pos));
 
-			if (pExtraction)
-			{
-				const Column<T>& col = pExtraction->column();
-				if (0 == Poco::icompare(name, col.name()))
-					return col.position();
-			}
-		}
+		TypedColumn& cached = _typedColumns[pos];
+		if (cached.pType && *cached.pType == typeid(T))
+			return static_cast<const Column<T>*>(cached.pColumn);
+
+		ExtractionVecPtr pExtraction = dynamic_cast<ExtractionVecPtr>(extractions()[pos].get());
+		if (!pExtraction) return 0;
 
-		throw NotFoundException(format("Unknown column name: %s", name));
+		cached.pType   = &typeid(T);
+		cached.pColumn = &pExtraction->column();
+		return &pExtraction->column();
 	}
 
-	std::size_t _currentRow;
+	std::size_t            _currentRow;
+	PositionMap            _positions;
+	mutable TypedColumnVec _typedColumns;
 };
 
 
@@ -252,7 +316,9 @@ inline std::size_t RecordSet::columnCount() const
 inline Statement& RecordSet::operator = (const Statement& stmt)
 {
 	_currentRow = 0;
-	return Statement::operator = (stmt);
+	Statement::operator = (stmt);
+	buildPositionMap();
+	return *this;
 }
 
 
@@ -288,7 +354,7 @@ inline MetaColumn::ColumnDataType RecordSet::columnType(std::size_t pos)const
 
 inline MetaColumn::ColumnDataType RecordSet::columnType(const std::string& name)const
 {
-	return metaColumn(name).type();
+	return columnType(columnPosition(name));
 }
 
 
@@ -306,7 +372,7 @@ inline std::size_t RecordSet::columnLength(std::size_t pos) const
 
 inline std::size_t RecordSet::columnLength(const std::string& name)const
 {
-	return metaColumn(name).length();
+	return columnLength(columnPosition(name));
 }
 
 
@@ -318,7 +384,7 @@ inline std::size_t RecordSet::columnPrecision(std::size_t pos) const
 
 inline std::size_t RecordSet::columnPrecision(const std::string& name)const
 {
-	return metaColumn(name).precision();
+	return columnPrecision(columnPosition(name));
 }
 
 
@@ -45,7 +45,9 @@
 #include "Poco/Data/PooledSessionImpl.h"
 #include "Poco/Data/Session.h"
 #include "Poco/Timer.h"
+#include "Poco/Timestamp.h"
 #include "Poco/Mutex.h"
+#include "Poco/Condition.h"
 #include <list>
 
 
@@ -74,10 +76,24 @@ class Data_API SessionPool
 	/// from the pool whenever one of the following events occurs:
 	/// 
 	///   - JanitorTimer event
-	///   - get() request
 	///   - putBack() request
+	///   - get() request, if the janitor timer is disabled (idleTime is 0)
 	///
-	/// Not connected idle sessions can not exist.
+	/// The pool mutex is only held for bookkeeping. Connecting new
+	/// sessions, validating sessions and closing expired sessions is
+	/// done outside of it, so a slow database server does not stall
+	/// threads that could be served from the idle list.
+	///
+	/// The pool can be pre-filled with minSessions connected sessions
+	/// at construction time. The janitor timer validates idle sessions
+	/// one at a time, and replenishes the pool in the background
+	/// whenever it has fallen below minSessions. As sessions are also
+	/// validated when they are returned to the pool, get() hands out
+	/// idle sessions without checking them, unless the janitor timer
+	/// is disabled.
+	///
+	/// Checkout statistics (number of checkouts, exhaustion count and a
+	/// histogram of the time spent in get()) are available via statistics().
 	///
 	/// Usage example:
 	///
@@ -87,7 +103,34 @@ class Data_API SessionPool
 	///     ...
 {
 public:
-	SessionPool(const std::string& sessionKey, const std::string& connectionString, int minSessions = 1, int maxSessions = 32, int idleTime = 60);
+	enum
+	{
+		WAIT_BUCKETS = 6
+			/// Number of buckets in the checkout wait time histogram.
+	};
+
+	struct Statistics
+		/// Checkout statistics of a SessionPool.
+	{
+		Statistics();
+
+		Poco::UInt64 checkouts;
+			/// Number of sessions handed out by get().
+		Poco::UInt64 exhausted;
+			/// Number of get() calls that failed because the pool was exhausted.
+		Poco::UInt64 created;
+			/// Number of sessions created by the pool.
+		Poco::UInt64 purged;
+			/// Number of sessions discarded because they were dead or expired.
+		Poco::UInt64 waitHistogram[WAIT_BUCKETS];
+			/// Checkout wait times; bucket i counts the get() calls that
+			/// took less than waitLimit(i) microseconds (and at least
+			/// waitLimit(i - 1)). The last bucket is unbounded.
+		Poco::Timestamp since;
+			/// Time the statistics have been collected from.
+	};
+
+	SessionPool(const std::string& sessionKey, const std::string& connectionString, int minSessions = 1, int maxSessions = 32, int idleTime = 60, bool prefill = false);
 		/// Creates the SessionPool for sessions with the given sessionKey
 		/// and connectionString.
 		///
@@ -95,7 +138,11 @@ public:
 		/// If a session has been idle for more than idleTime seconds, and more than
 		/// minSessions sessions are in the pool, the session is automatically destroyed.
 		///
-		/// If idleTime is 0, automatic cleanup of unused sessions is disabled.
+		/// If idleTime is 0, automatic cleanup of unused sessions, as well as
+		/// background validation and replenishment, is disabled.
+		///
+		/// If prefill is true, minSessions sessions are created before the
+		/// constructor returns.
 
 	virtual ~SessionPool();
 		/// Destroys the SessionPool.
@@ -104,12 +151,39 @@ public:
 		/// Returns a Session.
 		///
 		/// If there are unused sessions available, one of the
-		/// unused sessions is recycled. Otherwise, a new session
-		/// is created. 
+		/// unused sessions is recycled (without talking to the
+		/// database, unless idleTime is 0). Otherwise, a new
+		/// session is created. 
 		///
 		/// If the maximum number of sessions for this pool has
 		/// already been created, a SessionPoolExhaustedException
 		/// is thrown.
+
+	Session get(long milliseconds);
+		/// Returns a Session.
+		///
+		/// Same as get(), except that if the pool is exhausted,
+		/// waits up to the given number of milliseconds for a session
+		/// to be returned to the pool before throwing a
+		/// SessionPoolExhaustedException.
+
+	void prefill();
+		/// Creates new sessions until at least minSessions sessions
+		/// have been allocated.
+
+	Statistics statistics() const;
+		/// Returns a snapshot of the checkout statistics.
+
+	double checkoutRate() const;
+		/// Returns the average number of checkouts per second since
+		/// the statistics have been reset.
+
+	void resetStatistics();
+		/// Resets the checkout statistics.
+
+	static Poco::UInt64 waitLimit(int bucket);
+		/// Returns the upper limit, in microseconds, of the given bucket
+		/// of the checkout wait time histogram.
 		
 	int capacity() const;
 		/// Returns the maximum number of sessions the SessionPool will manage.
@@ -140,10 +214,20 @@ protected:
 	typedef Poco::AutoPtr<PooledSessionImpl>   PooledSessionImplPtr;
 	typedef std::list<PooledSessionHolderPtr>  SessionList;
 
-	void purgeDeadSessions();
 	int deadImpl(SessionList& rSessions);
 	void putBack(PooledSessionHolderPtr pHolder);
 	void onJanitorTimer(Poco::Timer&);
+	PooledSessionHolderPtr newSession();
+		/// Creates and customizes a new session. The caller must have
+		/// reserved a slot in _nSessions and must not hold the mutex.
+	void replenish();
+		/// Creates sessions until minSessions sessions have been allocated.
+	void recordWait(const Poco::Timestamp& start);
+	static bool isConnected(PooledSessionHolderPtr pHolder);
+		/// Returns true if the session is connected, false if it is
+		/// not or if the check fails. Must be called without holding
+		/// the mutex, as the check may have to talk to the server.
+	static void closeSessions(SessionList& rSessions);
 
 private:
 	SessionPool(const SessionPool&);
@@ -158,6 +242,8 @@ private:
 	SessionList _idleSessions;
 	SessionList _activeSessions;
 	Poco::Timer _janitorTimer;
+	Statistics _statistics;
+	Poco::Condition _sessionReturned;
 	mutable Poco::FastMutex _mutex;
 	
 	friend class PooledSessionImpl;
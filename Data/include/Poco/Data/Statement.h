@@ -43,6 +43,8 @@
 #include "Poco/Data/Data.h"
 #include "Poco/Data/StatementImpl.h"
 #include "Poco/Data/Range.h"
+#include "Poco/Data/AsyncStarter.h"
+#include "Poco/ActiveResult.h"
 #include "Poco/SharedPtr.h"
 
 
@@ -60,9 +62,34 @@ class Data_API Statement
 	/// A Statement is used to execute SQL statements. 
 	/// It does not contain code of its own.
 	/// Its main purpose is to forward calls to the concrete StatementImpl stored inside.
+	///
+	/// A Statement can also be executed asynchronously (see executeAsync()).
+	/// As a Session must not be used by more than one thread at a time,
+	/// statements running concurrently must be created from different
+	/// sessions, e.g. from a SessionPool:
+	///
+	///     Session s1(pool.get());
+	///     Session s2(pool.get());
+	///     Statement stmt1 = (s1 << "SELECT ...", into(v1));
+	///     Statement stmt2 = (s2 << "SELECT ...", into(v2));
+	///     Statement::Result result1 = stmt1.executeAsync();
+	///     Statement::Result result2 = stmt2.executeAsync();
+	///     result1.wait();
+	///     result2.wait();
+	///     Poco::UInt32 rows = result1.data() + result2.data();
+	///
+	/// Alternatively, Statement::wait() waits for the completion of the
+	/// last asynchronous execution and rethrows its exception, if any.
 {
 public:
 	typedef void (*Manipulator)(Statement&);
+
+	typedef ActiveResult<Poco::UInt32> Result;
+
+	enum
+	{
+		WAIT_FOREVER = -1
+	};
 	
 	Statement(StatementImpl* pImpl);
 		/// Creates the Statement.
@@ -126,6 +153,62 @@ public:
 	Poco::UInt32 execute();
 		/// Executes the whole statement. Stops when either a limit is hit or the whole statement was executed.
 		/// Returns the number of rows extracted from the Database.
+		///
+		/// Waits for a pending asynchronous execution to complete first.
+
+	Result executeAsync();
+		/// Executes the statement like execute(), but in a thread from the
+		/// Data library's thread pool (see AsyncStarter), and returns immediately.
+		///
+		/// The returned ActiveResult receives the number of rows extracted,
+		/// or the exception thrown by the execution. It is returned by value
+		/// and stays valid after the statement has been executed again.
+		/// The containers registered with into() must not be accessed, and
+		/// the Statement and its Session must not be used otherwise, until
+		/// the execution has completed.
+		///
+		/// The execution is shared by all copies of the Statement: each of
+		/// them sees it as pending, and waits for its completion before it
+		/// executes or fetches, or when it is destroyed.
+		///
+		/// Throws an ExecutionException if an asynchronous execution 
+		/// of the statement is already in progress.
+
+	Poco::UInt32 wait(long milliseconds = WAIT_FOREVER);
+		/// Waits for the completion of an asynchronous execution started with
+		/// executeAsync() and returns the number of rows extracted. If the
+		/// execution failed, the exception thrown by it is rethrown.
+		///
+		/// Throws a TimeoutException if the execution does not complete
+		/// within the given interval, or an InvalidAccessException if the
+		/// statement has not been executed asynchronously.
+
+	bool isAsyncPending() const;
+		/// Returns true if an asynchronous execution
+		/// of the statement is in progress.
+
+	Poco::UInt32 fetch(Poco::UInt32 rows);
+		/// Forward-only cursor access to the result set.
+		///
+		/// Clears the containers registered with into() and fills
+		/// them with at most the given number of rows, continuing where the
+		/// previous call to fetch() stopped. Returns the number of rows
+		/// fetched; zero means that the result set has been exhausted.
+		/// The result set is never materialized as a whole, so arbitrarily
+		/// large results can be processed in constant memory:
+		///
+		///     std::vector<std::string> names;
+		///     Statement select = (session << "SELECT Name FROM Person", into(names));
+		///     while (select.fetch(1000))
+		///     {
+		///         // process up to 1000 names
+		///     }
+		///
+		/// If the statement has no into() containers, a RecordSet created
+		/// from the statement after the first fetch() shows the rows of the
+		/// last fetch().
+		/// Limits and ranges are ignored by fetch(). Once the result set has
+		/// been exhausted, execute() restarts the statement.
 
 	bool done();
 		/// Returns if the statement was completely executed or if a previously set limit stopped it
@@ -143,6 +226,14 @@ protected:
 
 private:
 	typedef Poco::SharedPtr<StatementImpl> StatementImplPtr;
+	typedef Poco::SharedPtr<Result> ResultPtr;
+
+	ResultPtr asyncResult() const;
+		/// Returns the result of the last asynchronous execution
+		/// of the StatementImpl, or null if there was none.
+
+	void waitAsync();
+		/// Waits for a pending asynchronous execution to complete.
 
 	bool _executed;
 	StatementImplPtr _ptr;
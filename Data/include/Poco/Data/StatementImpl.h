@@ -48,6 +48,9 @@
 #include "Poco/Data/Extraction.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/ActiveResult.h"
+#include "Poco/Mutex.h"
 #include "Poco/String.h"
 #include "Poco/Format.h"
 #include "Poco/Exception.h"
@@ -101,6 +104,12 @@ public:
 	Poco::UInt32 execute();
 		/// Executes a statement. Returns the number of rows extracted.
 
+	Poco::UInt32 fetch(Poco::UInt32 rows);
+		/// Clears the result containers and extracts at most the given 
+		/// number of rows, continuing where the previous fetch() stopped.
+		/// Returns the number of rows extracted, which is zero once the
+		/// result set is exhausted.
+
 	void reset();
 		/// Resets the statement, so that we can reuse all bindings and re-execute again.
 
@@ -189,6 +198,9 @@ private:
 	void resetExtraction();
 		/// Resets binding so we can reuse it again.
 
+	void clearExtraction();
+		/// Removes previously extracted values from the result containers.
+
 	template <class T, class C>
 	void addInternalExtract(const MetaColumn& mc)
 		/// Utility function to create and add an internal extraction.
@@ -208,6 +220,8 @@ private:
 	std::ostringstream    _ostr;
 	AbstractBindingVec    _bindings;
 	AbstractExtractionVec _extractors;
+	Poco::SharedPtr<Poco::ActiveResult<Poco::UInt32> > _pAsyncResult;
+	mutable Poco::FastMutex _asyncMutex;
 
 	friend class Statement; 
 };
@@ -0,0 +1,213 @@
+//
+// StringArena.h
+//
+// $Id: //poco/1.4/Data/include/Poco/Data/StringArena.h#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  StringArena
+//
+// Definition of the StringArena class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Data_StringArena_INCLUDED
+#define Data_StringArena_INCLUDED
+
+
+#include "Poco/Data/Data.h"
+#include "Poco/Exception.h"
+#include <vector>
+#include <string>
+
+
+namespace Poco {
+namespace Data {
+
+
+class Data_API StringArena
+	/// A compact, append-only container for the values of a string column.
+	///
+	/// Extracting a string column into a std::vector<std::string> allocates
+	/// one string per cell. StringArena instead copies all cell values into
+	/// a single contiguous character buffer and only records the offset of
+	/// each value, so that extracting a result set needs a handful of
+	/// amortized allocations regardless of the number of rows. clear() keeps
+	/// the allocated memory, so a StringArena used with Statement::fetch()
+	/// does not allocate at all once it has grown to the size of a window.
+	///
+	/// Values are accessed by index, either as a pointer/length pair or
+	/// as a std::string copy. Pointers returned by data() remain valid until
+	/// the next call to a non-const member function.
+	///
+	/// Usage example:
+	///     StringArena names;
+	///     session << "SELECT name FROM Person", into(names), now;
+	///     for (std::size_t i = 0; i < names.size(); ++i)
+	///         std::cout.write(names.data(i), names.length(i));
+{
+public:
+	StringArena();
+		/// Creates an empty StringArena.
+
+	~StringArena();
+		/// Destroys the StringArena.
+
+	void append(const char* pData, std::size_t length);
+		/// Appends a value.
+
+	void append(const std::string& value);
+		/// Appends a value.
+
+	void appendNull();
+		/// Appends a null value, which has a length of zero.
+
+	std::size_t size() const;
+		/// Returns the number of values.
+
+	bool empty() const;
+		/// Returns true if the arena holds no values.
+
+	std::size_t bytes() const;
+		/// Returns the total length of all values.
+
+	const char* data(std::size_t index) const;
+		/// Returns a pointer to the characters of the value with
+		/// the given index. The characters are not zero-terminated.
+
+	std::size_t length(std::size_t index) const;
+		/// Returns the length of the value with the given index.
+
+	bool isNull(std::size_t index) const;
+		/// Returns true if the value with the given index is null.
+
+	std::string get(std::size_t index) const;
+		/// Returns a copy of the value with the given index.
+
+	std::string operator [] (std::size_t index) const;
+		/// Returns a copy of the value with the given index.
+
+	bool equals(std::size_t index, const std::string& value) const;
+		/// Returns true if the value with the given index equals
+		/// the given string, without copying the value.
+
+	void reserve(std::size_t values, std::size_t bytes);
+		/// Reserves storage for the given number of values
+		/// with the given total length.
+
+	void clear();
+		/// Removes all values, but keeps the allocated storage.
+
+	void swap(StringArena& other);
+		/// Swaps the contents with another StringArena.
+
+private:
+	void checkIndex(std::size_t index) const;
+
+	std::string              _buffer;
+	std::vector<std::size_t> _offsets; // begin of value i is _offsets[i], its end is _offsets[i + 1]
+	std::vector<bool>        _nulls;
+};
+
+
+//
+// inlines
+//
+inline void StringArena::append(const std::string& value)
+{
+	append(value.data(), value.size());
+}
+
+
+inline std::size_t StringArena::size() const
+{
+	return _nulls.size();
+}
+
+
+inline bool StringArena::empty() const
+{
+	return _nulls.empty();
+}
+
+
+inline std::size_t StringArena::bytes() const
+{
+	return _buffer.size();
+}
+
+
+inline void StringArena::checkIndex(std::size_t index) const
+{
+	if (index >= _nulls.size()) throw RangeException("StringArena index out of range");
+}
+
+
+inline const char* StringArena::data(std::size_t index) const
+{
+	checkIndex(index);
+	return _buffer.data() + _offsets[index];
+}
+
+
+inline std::size_t StringArena::length(std::size_t index) const
+{
+	checkIndex(index);
+	return _offsets[index + 1] - _offsets[index];
+}
+
+
+inline bool StringArena::isNull(std::size_t index) const
+{
+	checkIndex(index);
+	return _nulls[index];
+}
+
+
+inline std::string StringArena::get(std::size_t index) const
+{
+	return std::string(data(index), length(index));
+}
+
+
+inline std::string StringArena::operator [] (std::size_t index) const
+{
+	return get(index);
+}
+
+
+inline void swap(StringArena& a1, StringArena& a2)
+{
+	a1.swap(a2);
+}
+
+
+} } // namespace Poco::Data
+
+
+#endif // Data_StringArena_INCLUDED
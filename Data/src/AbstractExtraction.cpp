@@ -53,4 +53,9 @@ AbstractExtraction::~AbstractExtraction()
 }
 
 
+void AbstractExtraction::clear()
+{
+}
+
+
 } } // namespace Poco::Data
@@ -35,6 +35,7 @@
 
 
 #include "Poco/Data/AbstractExtractor.h"
+#include "Poco/Data/StringArena.h"
 
 
 namespace Poco {
@@ -51,4 +52,12 @@ AbstractExtractor::~AbstractExtractor()
 }
 
 
+bool AbstractExtractor::extract(std::size_t pos, StringArena& val)
+{
+	if (!extract(pos, _string)) return false;
+	val.append(_string);
+	return true;
+}
+
+
 } } // namespace Poco::Data
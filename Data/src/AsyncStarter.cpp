@@ -0,0 +1,95 @@
+//
+// AsyncStarter.cpp
+//
+// $Id: //poco/1.4/Data/src/AsyncStarter.cpp#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  AsyncStarter
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Data/AsyncStarter.h"
+#include "Poco/Mutex.h"
+
+
+namespace Poco {
+namespace Data {
+
+
+namespace
+{
+	class AsyncPoolHolder
+	{
+	public:
+		AsyncPoolHolder():
+			_pPool(0)
+		{
+		}
+
+		~AsyncPoolHolder()
+		{
+			delete _pPool;
+		}
+
+		ThreadPool* pool()
+		{
+			FastMutex::ScopedLock lock(_mutex);
+
+			if (!_pPool)
+			{
+				_pPool = new ThreadPool("Data", AsyncStarter::MIN_THREADS, AsyncStarter::MAX_THREADS);
+				if (POCO_THREAD_STACK_SIZE > 0)
+					_pPool->setStackSize(POCO_THREAD_STACK_SIZE);
+			}
+			return _pPool;
+		}
+
+	private:
+		ThreadPool* _pPool;
+		FastMutex   _mutex;
+	};
+
+	static AsyncPoolHolder sh;
+}
+
+
+void AsyncStarter::start(StatementImpl* pOwner, ActiveRunnableBase::Ptr pRunnable)
+{
+	pool().start(*pRunnable);
+	pRunnable->duplicate(); // The runnable will release itself.
+}
+
+
+ThreadPool& AsyncStarter::pool()
+{
+	return *sh.pool();
+}
+
+
+} } // namespace Poco::Data
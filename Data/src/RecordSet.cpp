@@ -45,6 +45,7 @@ RecordSet::RecordSet(const Statement& rStatement):
 	Statement(rStatement),
 	_currentRow(0)
 {
+	buildPositionMap();
 }
 
 
@@ -78,23 +79,30 @@ DynamicAny RecordSet::value(std::size_t col, std::size_t row) const
 
 DynamicAny RecordSet::value(const std::string& name, std::size_t row) const
 {
-	switch (columnType(name))
+	return value(columnPosition(name), row);
+}
+
+
+std::size_t RecordSet::columnPosition(const std::string& name) const
+{
+	PositionMap::const_iterator it = _positions.find(Poco::toLower(name));
+	if (it == _positions.end())
+		throw NotFoundException(format("Unknown column name: %s", name));
+
+	return it->second;
+}
+
+
+void RecordSet::buildPositionMap()
+{
+	_positions.clear();
+	std::size_t count = columnCount();
+	TypedColumn none = { 0, 0 };
+	_typedColumns.assign(count, none);
+	for (std::size_t pos = 0; pos < count; ++pos)
 	{
-		case MetaColumn::FDT_BOOL:
-		case MetaColumn::FDT_INT8:   return value<Int8>(name, row);        
-		case MetaColumn::FDT_UINT8:  return value<UInt8>(name, row);       
-		case MetaColumn::FDT_INT16:  return value<Int16>(name, row);       
-		case MetaColumn::FDT_UINT16: return value<UInt16>(name, row);      
-		case MetaColumn::FDT_INT32:  return value<Int32>(name, row);       
-		case MetaColumn::FDT_UINT32: return value<UInt32>(name, row);      
-		case MetaColumn::FDT_INT64:  return value<Int64>(name, row);       
-		case MetaColumn::FDT_UINT64: return value<UInt64>(name, row);      
-		case MetaColumn::FDT_FLOAT:  return value<float>(name, row);       
-		case MetaColumn::FDT_DOUBLE: return value<double>(name, row);      
-		case MetaColumn::FDT_STRING: return value<std::string>(name, row); 
-		case MetaColumn::FDT_BLOB:   return value<BLOB>(name, row);        
-		default:
-			throw Poco::InvalidArgumentException("Data type not supported.");
+		// insert() keeps the first column if several columns have the same name
+		_positions.insert(PositionMap::value_type(Poco::toLower(columnName(pos)), pos));
 	}
 }
 
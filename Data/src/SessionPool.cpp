@@ -38,13 +38,25 @@
 #include "Poco/Data/SessionFactory.h"
 #include "Poco/Data/DataException.h"
 #include <algorithm>
+#include <limits>
+#include <set>
 
 
 namespace Poco {
 namespace Data {
 
 
-SessionPool::SessionPool(const std::string& sessionKey, const std::string& connectionString, int minSessions, int maxSessions, int idleTime):
+SessionPool::Statistics::Statistics():
+	checkouts(0),
+	exhausted(0),
+	created(0),
+	purged(0)
+{
+	std::fill(waitHistogram, waitHistogram + WAIT_BUCKETS, 0);
+}
+
+
+SessionPool::SessionPool(const std::string& sessionKey, const std::string& connectionString, int minSessions, int maxSessions, int idleTime, bool prefill):
 	_sessionKey(sessionKey),
 	_connectionString(connectionString),
 	_minSessions(minSessions),
@@ -53,6 +65,8 @@ SessionPool::SessionPool(const std::string& sessionKey, const std::string& conne
 	_nSessions(0),
 	_janitorTimer(1000*idleTime, 1000*idleTime/4)
 {
+	if (prefill) replenish();
+
 	Poco::TimerCallback<SessionPool> callback(*this, &SessionPool::onJanitorTimer);
 	if (_idleTime > 0) _janitorTimer.start(callback);
 }
@@ -66,41 +80,127 @@ SessionPool::~SessionPool()
 
 Session SessionPool::get()
 {
-	Poco::FastMutex::ScopedLock lock(_mutex);
-	
-	purgeDeadSessions();
+	return get(0);
+}
 
-	if (_idleSessions.empty())
+
+Session SessionPool::get(long milliseconds)
+{
+	Poco::Timestamp start;
+	PooledSessionHolderPtr pHolder;
+	for (;;)
 	{
-		if (_nSessions < _maxSessions)
+		bool create = false;
 		{
-			Session newSession(SessionFactory::instance().create(_sessionKey, _connectionString));
-			customizeSession(newSession);
-			PooledSessionHolderPtr pHolder(new PooledSessionHolder(*this, newSession.impl()));
-			_idleSessions.push_front(pHolder);
-			++_nSessions;
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			while (_idleSessions.empty() && _nSessions >= _maxSessions)
+			{
+				long remaining = milliseconds - static_cast<long>(start.elapsed()/1000);
+				if (remaining <= 0 || !_sessionReturned.tryWait(_mutex, remaining))
+				{
+					++_statistics.exhausted;
+					throw SessionPoolExhaustedException(_sessionKey, _connectionString);
+				}
+			}
+			if (!_idleSessions.empty())
+			{
+				pHolder = _idleSessions.front();
+				_idleSessions.pop_front();
+			}
+			else
+			{
+				// reserve the slot, connect without holding the mutex
+				++_nSessions;
+				create = true;
+			}
+		}
+
+		if (create)
+		{
+			try
+			{
+				pHolder = newSession();
+			}
+			catch (...)
+			{
+				Poco::FastMutex::ScopedLock lock(_mutex);
+				--_nSessions;
+				_sessionReturned.signal();
+				throw;
+			}
+			break;
+		}
+		else if (_idleTime > 0 || pHolder->session()->isConnected())
+		{
+			// idle sessions have been validated when they were returned,
+			// and are validated periodically by the janitor timer
+			break;
+		}
+		else
+		{
+			{
+				Poco::FastMutex::ScopedLock lock(_mutex);
+				--_nSessions;
+				++_statistics.purged;
+			}
+			pHolder = 0;
 		}
-		else throw SessionPoolExhaustedException(_sessionKey, _connectionString);
 	}
-	PooledSessionHolderPtr pHolder(_idleSessions.front());
+
 	PooledSessionImplPtr pPSI(new PooledSessionImpl(pHolder));
+	Poco::FastMutex::ScopedLock lock(_mutex);
 	_activeSessions.push_front(pHolder);
-	_idleSessions.pop_front();
+	++_statistics.checkouts;
+	recordWait(start);
 	return Session(pPSI);
 }
 
 
-void SessionPool::purgeDeadSessions()
+void SessionPool::prefill()
+{
+	replenish();
+}
+
+
+SessionPool::PooledSessionHolderPtr SessionPool::newSession()
 {
-	SessionList::iterator it = _idleSessions.begin();
-	for (; it != _idleSessions.end(); )
+	Session newSession(SessionFactory::instance().create(_sessionKey, _connectionString));
+	customizeSession(newSession);
+	PooledSessionHolderPtr pHolder(new PooledSessionHolder(*this, newSession.impl()));
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	++_statistics.created;
+	return pHolder;
+}
+
+
+void SessionPool::replenish()
+{
+	int missing;
 	{
-		if (!(*it)->session()->isConnected())
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		missing = _minSessions - _nSessions;
+		if (missing <= 0) return;
+		_nSessions += missing;
+	}
+	for (int i = 0; i < missing; ++i)
+	{
+		PooledSessionHolderPtr pHolder;
+		try
 		{
-			it = _idleSessions.erase(it);
-			--_nSessions;
+			pHolder = newSession();
 		}
-		else ++it;
+		catch (...)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_nSessions -= missing - i;
+			throw;
+		}
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		_idleSessions.push_front(pHolder);
+		_sessionReturned.signal();
 	}
 }
 
@@ -159,6 +259,54 @@ int SessionPool::available() const
 }
 
 
+SessionPool::Statistics SessionPool::statistics() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _statistics;
+}
+
+
+double SessionPool::checkoutRate() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	Poco::Timestamp::TimeDiff elapsed = _statistics.since.elapsed();
+	if (elapsed <= 0) return 0;
+	return double(_statistics.checkouts)*Poco::Timestamp::resolution()/elapsed;
+}
+
+
+void SessionPool::resetStatistics()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_statistics = Statistics();
+}
+
+
+Poco::UInt64 SessionPool::waitLimit(int bucket)
+{
+	static const Poco::UInt64 limits[WAIT_BUCKETS - 1] = { 10, 100, 1000, 10000, 100000 };
+
+	poco_assert (bucket >= 0 && bucket < WAIT_BUCKETS);
+
+	if (bucket < WAIT_BUCKETS - 1)
+		return limits[bucket];
+	else
+		return std::numeric_limits<Poco::UInt64>::max();
+}
+
+
+void SessionPool::recordWait(const Poco::Timestamp& start)
+{
+	Poco::UInt64 waited = static_cast<Poco::UInt64>(start.elapsed());
+	int bucket = 0;
+	while (bucket < WAIT_BUCKETS - 1 && waited >= waitLimit(bucket)) ++bucket;
+	++_statistics.waitHistogram[bucket];
+}
+
+
 void SessionPool::customizeSession(Session&)
 {
 }
@@ -166,19 +314,26 @@ void SessionPool::customizeSession(Session&)
 
 void SessionPool::putBack(PooledSessionHolderPtr pHolder)
 {
+	bool connected = isConnected(pHolder);
+
 	Poco::FastMutex::ScopedLock lock(_mutex);
 	
 	SessionList::iterator it = std::find(_activeSessions.begin(), _activeSessions.end(), pHolder);
 	if (it != _activeSessions.end())
 	{
-		if (pHolder->session()->isConnected())
+		if (connected)
 		{
 			pHolder->access();
 			_idleSessions.push_front(pHolder);
 		}
-		else --_nSessions;
+		else
+		{
+			--_nSessions;
+			++_statistics.purged;
+		}
 
 		_activeSessions.erase(it);
+		_sessionReturned.signal();
 	}
 	else
 	{
@@ -189,24 +344,91 @@ void SessionPool::putBack(PooledSessionHolderPtr pHolder)
 
 void SessionPool::onJanitorTimer(Poco::Timer&)
 {
-	Poco::FastMutex::ScopedLock lock(_mutex);
-	
-	SessionList::iterator it = _idleSessions.begin(); 
-	while (_nSessions > _minSessions && it != _idleSessions.end())
+	SessionList expired;
+	int candidates;
 	{
-		if ((*it)->idle() > _idleTime || !(*it)->session()->isConnected())
-		{	
-			try
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SessionList::iterator it = _idleSessions.begin(); 
+		while (it != _idleSessions.end())
+		{
+			if (_nSessions > _minSessions && (*it)->idle() > _idleTime)
 			{
-				(*it)->session()->close();
-			}
-			catch (...)
-			{			
+				expired.push_back(*it);
+				it = _idleSessions.erase(it);
+				--_nSessions;
+				++_statistics.purged;
 			}
-			it = _idleSessions.erase(it);
+			else ++it;
+		}
+		candidates = static_cast<int>(_idleSessions.size());
+	}
+
+	// isConnected() may have to talk to the server, so the mutex
+	// is not held while a session is validated. Only the session
+	// being validated is taken out of the idle list (it still
+	// counts in _nSessions); all others remain available to get().
+	// The least recently used session is validated first, and is
+	// put back at the end of the list, where it came from.
+	std::set<PooledSessionHolder*> checked;
+	for (int i = 0; i < candidates; ++i)
+	{
+		PooledSessionHolderPtr pHolder;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			SessionList::reverse_iterator it = _idleSessions.rbegin();
+			while (it != _idleSessions.rend() && checked.find(it->get()) != checked.end()) ++it;
+			if (it == _idleSessions.rend()) break;
+			pHolder = *it;
+			_idleSessions.erase(--it.base());
+		}
+		checked.insert(pHolder.get());
+		bool connected = isConnected(pHolder);
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (connected)
+		{
+			_idleSessions.push_back(pHolder);
+			_sessionReturned.signal();
+		}
+		else
+		{
+			expired.push_back(pHolder);
 			--_nSessions;
+			++_statistics.purged;
+		}
+	}
+	closeSessions(expired);
+	replenish();
+}
+
+
+bool SessionPool::isConnected(PooledSessionHolderPtr pHolder)
+{
+	try
+	{
+		return pHolder->session()->isConnected();
+	}
+	catch (...)
+	{
+		return false;
+	}
+}
+
+
+void SessionPool::closeSessions(SessionList& rSessions)
+{
+	for (SessionList::iterator it = rSessions.begin(); it != rSessions.end(); ++it)
+	{
+		try
+		{
+			(*it)->session()->close();
+		}
+		catch (...)
+		{
 		}
-		else ++it;
 	}
 }
 
@@ -47,6 +47,50 @@ namespace Poco {
 namespace Data {
 
 
+namespace
+{
+	class AsyncExecRunnable: public ActiveRunnableBase
+		/// Executes a StatementImpl for Statement::executeAsync().
+		/// The runnable shares ownership of the StatementImpl,
+		/// which thus outlives the execution even if all
+		/// Statements referring to it are gone.
+	{
+	public:
+		AsyncExecRunnable(const SharedPtr<StatementImpl>& pImpl, const Statement::Result& result):
+			_pImpl(pImpl),
+			_result(result)
+		{
+		}
+
+		void run()
+		{
+			ActiveRunnableBase::Ptr guard(this, false); // ensure automatic release when done
+			try
+			{
+				_result.data(new Poco::UInt32(_pImpl->execute()));
+			}
+			catch (Exception& e)
+			{
+				_result.error(e);
+			}
+			catch (std::exception& e)
+			{
+				_result.error(e.what());
+			}
+			catch (...)
+			{
+				_result.error("unknown exception");
+			}
+			_result.notify();
+		}
+
+	private:
+		SharedPtr<StatementImpl> _pImpl;
+		Statement::Result        _result;
+	};
+}
+
+
 Statement::Statement(StatementImpl* pImpl):
 	_executed(false),
 	_ptr(pImpl)
@@ -72,6 +116,9 @@ Statement::Statement(const Statement& stmt):
 
 Statement::~Statement()
 {
+	// the containers and the session used by a pending
+	// asynchronous execution may go away with the Statement
+	if (_ptr) waitAsync();
 }
 
 
@@ -92,6 +139,7 @@ void Statement::swap(Statement& other)
 
 Poco::UInt32 Statement::execute()
 {
+	waitAsync();
 	if (done())
 	{
 		_ptr->reset();
@@ -101,6 +149,74 @@ Poco::UInt32 Statement::execute()
 }
 
 
+Statement::Result Statement::executeAsync()
+{
+	FastMutex::ScopedLock lock(_ptr->_asyncMutex);
+
+	if (_ptr->_pAsyncResult && !_ptr->_pAsyncResult->available())
+		throw ExecutionException("Asynchronous execution already in progress", toString());
+
+	if (done())
+	{
+		_ptr->reset();
+	}
+	_executed = true;
+	ResultPtr pResult = new Result(new Result::ActiveResultHolderType);
+	ActiveRunnableBase::Ptr pRunnable(new AsyncExecRunnable(_ptr, *pResult));
+	AsyncStarter::start(_ptr.get(), pRunnable);
+	_ptr->_pAsyncResult = pResult;
+	return *pResult;
+}
+
+
+Poco::UInt32 Statement::wait(long milliseconds)
+{
+	ResultPtr pResult = asyncResult();
+	if (!pResult)
+		throw InvalidAccessException("Statement has not been executed asynchronously");
+
+	if (WAIT_FOREVER == milliseconds)
+		pResult->wait();
+	else
+		pResult->wait(milliseconds);
+
+	if (pResult->failed())
+		pResult->exception()->rethrow();
+
+	return pResult->data();
+}
+
+
+bool Statement::isAsyncPending() const
+{
+	ResultPtr pResult = asyncResult();
+	return pResult && !pResult->available();
+}
+
+
+Statement::ResultPtr Statement::asyncResult() const
+{
+	FastMutex::ScopedLock lock(_ptr->_asyncMutex);
+
+	return _ptr->_pAsyncResult;
+}
+
+
+void Statement::waitAsync()
+{
+	ResultPtr pResult = asyncResult();
+	if (pResult) pResult->wait();
+}
+
+
+Poco::UInt32 Statement::fetch(Poco::UInt32 rows)
+{
+	waitAsync();
+	_executed = true;
+	return _ptr->fetch(rows);
+}
+
+
 bool Statement::done()
 {
 	return _ptr->getState() == StatementImpl::ST_DONE;
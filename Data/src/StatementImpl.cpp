@@ -135,6 +135,35 @@ Poco::UInt32 StatementImpl::executeWithoutLimit()
 }
 
 
+Poco::UInt32 StatementImpl::fetch(Poco::UInt32 rows)
+{
+	poco_assert (rows > 0);
+
+	if (_state == ST_DONE) return 0;
+
+	clearExtraction();
+	resetExtraction();
+	compile();
+
+	Poco::UInt32 count = 0;
+	do
+	{
+		bind();
+		while (count < rows && hasNext())
+		{
+			next();
+			++count;
+		}
+	}
+	while (count < rows && canBind());
+
+	if (count < rows) 
+		_state = ST_DONE;
+
+	return count;
+}
+
+
 void StatementImpl::compile()
 {
 	if (_state == ST_INITIALIZED)
@@ -255,6 +284,17 @@ void StatementImpl::resetExtraction()
 }
 
 
+void StatementImpl::clearExtraction()
+{
+	Poco::Data::AbstractExtractionVec::iterator it = extractions().begin();
+	Poco::Data::AbstractExtractionVec::iterator itEnd = extractions().end();
+	for (; it != itEnd; ++it)
+	{
+		(*it)->clear();
+	}
+}
+
+
 void StatementImpl::makeExtractors(Poco::UInt32 count)
 {
 	for (int i = 0; i < count; ++i)
@@ -0,0 +1,102 @@
+//
+// StringArena.cpp
+//
+// $Id: //poco/1.4/Data/src/StringArena.cpp#1 $
+//
+// Library: Data
+// Package: DataCore
+// Module:  StringArena
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Data/StringArena.h"
+#include <cstring>
+
+
+namespace Poco {
+namespace Data {
+
+
+StringArena::StringArena()
+{
+	_offsets.push_back(0);
+}
+
+
+StringArena::~StringArena()
+{
+}
+
+
+void StringArena::append(const char* pData, std::size_t length)
+{
+	_buffer.append(pData, length);
+	_offsets.push_back(_buffer.size());
+	_nulls.push_back(false);
+}
+
+
+void StringArena::appendNull()
+{
+	_offsets.push_back(_buffer.size());
+	_nulls.push_back(true);
+}
+
+
+bool StringArena::equals(std::size_t index, const std::string& value) const
+{
+	std::size_t len = length(index);
+	return len == value.size() && (len == 0 || std::memcmp(data(index), value.data(), len) == 0);
+}
+
+
+void StringArena::reserve(std::size_t values, std::size_t bytes)
+{
+	_buffer.reserve(bytes);
+	_offsets.reserve(values + 1);
+	_nulls.reserve(values);
+}
+
+
+void StringArena::clear()
+{
+	_buffer.clear();
+	_offsets.resize(1);
+	_nulls.clear();
+}
+
+
+void StringArena::swap(StringArena& other)
+{
+	_buffer.swap(other._buffer);
+	_offsets.swap(other._offsets);
+	_nulls.swap(other._nulls);
+}
+
+
+} } // namespace Poco::Data
@@ -38,6 +38,7 @@
 #include "Poco/Data/BLOBStream.h"
 #include "Poco/Data/MetaColumn.h"
 #include "Poco/Data/Column.h"
+#include "Poco/Data/StringArena.h"
 #include "Connector.h"
 #include "Poco/BinaryReader.h"
 #include "Poco/BinaryWriter.h"
@@ -421,6 +422,63 @@ void DataTest::testColumn()
 }
 
 
+void DataTest::testStringArena()
+{
+	StringArena arena;
+	assert (arena.empty());
+	assert (arena.size() == 0);
+	assert (arena.bytes() == 0);
+
+	arena.append("abc", 3);
+	arena.appendNull();
+	arena.append(std::string());
+	arena.append(std::string("defgh"));
+
+	assert (!arena.empty());
+	assert (arena.size() == 4);
+	assert (arena.bytes() == 8);
+
+	assert (arena.length(0) == 3);
+	assert (std::memcmp(arena.data(0), "abc", 3) == 0);
+	assert (!arena.isNull(0));
+	assert (arena.get(0) == "abc");
+
+	assert (arena.isNull(1));
+	assert (arena.length(1) == 0);
+	assert (arena[1].empty());
+
+	assert (!arena.isNull(2));
+	assert (arena.length(2) == 0);
+	assert (arena.equals(2, ""));
+
+	assert (arena[3] == "defgh");
+	assert (arena.equals(3, "defgh"));
+	assert (!arena.equals(3, "defg"));
+	assert (!arena.equals(3, "defgx"));
+
+	try
+	{
+		arena.data(4);
+		fail ("must fail");
+	}
+	catch (RangeException&)
+	{
+	}
+
+	StringArena other;
+	other.append("x", 1);
+	swap(arena, other);
+	assert (arena.size() == 1 && arena[0] == "x");
+	assert (other.size() == 4 && other[3] == "defgh");
+
+	other.clear();
+	assert (other.empty());
+	assert (other.bytes() == 0);
+	other.append("y", 1);
+	assert (other.size() == 1 && other[0] == "y");
+}
+
+
 void DataTest::setUp()
 {
 }
@@ -441,6 +499,7 @@ CppUnit::Test* DataTest::suite()
 	CppUnit_addTest(pSuite, DataTest, testBLOB);
 	CppUnit_addTest(pSuite, DataTest, testBLOBStreams);
 	CppUnit_addTest(pSuite, DataTest, testColumn);
+	CppUnit_addTest(pSuite, DataTest, testStringArena);
 
 	return pSuite;
 }
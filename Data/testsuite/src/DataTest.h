@@ -54,6 +54,7 @@ public:
 	void testBLOB();
 	void testBLOBStreams();
 	void testColumn();
+	void testStringArena();
 
 	void setUp();
 	void tearDown();
@@ -184,6 +184,80 @@ void SessionPoolTest::testSessionPool()
 }
 
 
+void SessionPoolTest::testSessionPoolPrefill()
+{
+	SessionPool pool("test", "cs", 2, 4, 1, true);
+
+	assert (pool.allocated() == 2);
+	assert (pool.idle() == 2);
+	assert (pool.statistics().created == 2);
+
+	{
+		Session s1(pool.get());
+		Session s2(pool.get());
+		assert (pool.allocated() == 2);
+		assert (pool.idle() == 0);
+		assert (pool.statistics().created == 2);
+
+		s1.setFeature("connected", false);
+		s2.setFeature("connected", false);
+	}
+	assert (pool.allocated() == 0);
+	assert (pool.statistics().purged == 2);
+
+	Thread::sleep(2000); // time to replenish
+	
+	assert (pool.allocated() == 2);
+	assert (pool.idle() == 2);
+	assert (pool.used() == 0);
+	assert (pool.statistics().created == 4);
+}
+
+
+void SessionPoolTest::testSessionPoolStatistics()
+{
+	SessionPool pool("test", "cs", 1, 2, 0);
+
+	Session s1(pool.get());
+	Session s2(pool.get(100));
+	
+	Poco::Timestamp start;
+	try
+	{
+		Session s3(pool.get(200));
+		fail("pool exhausted - must throw");
+	}
+	catch (SessionPoolExhaustedException&)
+	{
+	}
+	assert (start.elapsed() >= 190000);
+
+	SessionPool::Statistics stats = pool.statistics();
+	assert (stats.checkouts == 2);
+	assert (stats.exhausted == 1);
+	assert (stats.created == 2);
+	assert (stats.purged == 0);
+	
+	Poco::UInt64 waits = 0;
+	for (int i = 0; i < SessionPool::WAIT_BUCKETS; ++i)
+	{
+		waits += stats.waitHistogram[i];
+		if (i > 0) assert (SessionPool::waitLimit(i) > SessionPool::waitLimit(i - 1));
+	}
+	assert (waits == 2);
+	assert (pool.checkoutRate() > 0);
+	
+	s2.close();
+	Session s4(pool.get(100));
+	assert (pool.statistics().checkouts == 3);
+	assert (pool.statistics().created == 2);
+
+	pool.resetStatistics();
+	assert (pool.statistics().checkouts == 0);
+	assert (pool.statistics().exhausted == 0);
+}
+
+
 void SessionPoolTest::setUp()
 {
 }
@@ -199,6 +273,8 @@ CppUnit::Test* SessionPoolTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SessionPoolTest");
 
 	CppUnit_addTest(pSuite, SessionPoolTest, testSessionPool);
+	CppUnit_addTest(pSuite, SessionPoolTest, testSessionPoolPrefill);
+	CppUnit_addTest(pSuite, SessionPoolTest, testSessionPoolStatistics);
 
 	return pSuite;
 }
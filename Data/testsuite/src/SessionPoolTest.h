@@ -47,6 +47,8 @@ public:
 	~SessionPoolTest();
 
 	void testSessionPool();
+	void testSessionPoolPrefill();
+	void testSessionPoolStatistics();
 
 	void setUp();
 	void tearDown();
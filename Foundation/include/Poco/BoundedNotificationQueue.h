@@ -0,0 +1,252 @@
+//
+// BoundedNotificationQueue.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/BoundedNotificationQueue.h#1 $
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Definition of the BoundedNotificationQueue class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_BoundedNotificationQueue_INCLUDED
+#define Foundation_BoundedNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#include "Poco/Mutex.h"
+#include "Poco/Semaphore.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class NotificationCenter;
+
+
+class Foundation_API BoundedNotificationQueue
+	/// A BoundedNotificationQueue is a NotificationQueue with
+	/// a fixed capacity. It can be used in place of a
+	/// NotificationQueue, as it provides the same member functions.
+	///
+	/// The notifications are kept in a ring buffer that is
+	/// allocated once, when the queue is created. In contrast to
+	/// NotificationQueue, neither enqueueing a notification nor
+	/// waiting for one ever allocates memory.
+	///
+	/// On platforms with GCC atomic builtins (POCO_HAVE_GCC_ATOMICS),
+	/// the queue is lock-free: the ring buffer is a bounded
+	/// multi-producer/multi-consumer queue based on per-slot sequence
+	/// numbers and compare-and-swap (after Dmitry Vyukov), and the
+	/// number of notifications is maintained with atomic operations.
+	/// Only urgent notifications, which are kept in a separate list
+	/// in front of the ring buffer, are guarded by a mutex.
+	/// On other platforms, every operation is a single short
+	/// critical section.
+	///
+	/// Threads are only parked (on one of two semaphores) if
+	/// the queue is empty (consumers) or full (producers),
+	/// and a semaphore is only signalled if a thread is actually
+	/// waiting on it.
+	///
+	/// If the queue is full, enqueueNotification() and
+	/// enqueueUrgentNotification() wait until another thread
+	/// has dequeued a notification.
+	///
+	/// See NotificationQueue for the recommended sequence to
+	/// shut down a queue with worker threads waiting for notifications.
+{
+public:
+	enum
+	{
+		DEFAULT_CAPACITY = 1024
+	};
+
+	explicit BoundedNotificationQueue(int capacity = DEFAULT_CAPACITY);
+		/// Creates the BoundedNotificationQueue, which can
+		/// hold up to capacity notifications.
+
+	~BoundedNotificationQueue();
+		/// Destroys the BoundedNotificationQueue.
+
+	void enqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO).
+		/// If the queue is full, waits until there is room
+		/// for the notification.
+		/// The queue takes ownership of the notification, thus
+		/// a call like
+		///     notificationQueue.enqueueNotification(new MyNotification);
+		/// does not result in a memory leak.
+
+	void enqueueUrgentNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the front of the queue (LIFO). The event therefore gets processed
+		/// before all other events already in the queue.
+		/// If the queue is full, waits until there is room
+		/// for the notification.
+		/// The queue takes ownership of the notification, thus
+		/// a call like
+		///     notificationQueue.enqueueUrgentNotification(new MyNotification);
+		/// does not result in a memory leak.
+
+	Notification* dequeueNotification();
+		/// Dequeues the next pending notification.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification();
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		/// This method returns 0 (null) if wakeUpAll()
+		/// has been called by another thread.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification(long milliseconds);
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued up to the specified time.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	void dispatch(NotificationCenter& notificationCenter);
+		/// Dispatches all queued notifications to the given
+		/// notification center.
+
+	void wakeUpAll();
+		/// Wakes up all threads that wait for a notification.
+
+	bool empty() const;
+		/// Returns true iff the queue is empty.
+
+	int size() const;
+		/// Returns the number of notifications in the queue.
+
+	int capacity() const;
+		/// Returns the maximum number of notifications
+		/// the queue can hold.
+
+	void clear();
+		/// Removes all notifications from the queue.
+
+	bool hasIdleThreads() const;
+		/// Returns true if the queue has at least one thread waiting
+		/// for a notification.
+
+private:
+	BoundedNotificationQueue(const BoundedNotificationQueue&);
+	BoundedNotificationQueue& operator = (const BoundedNotificationQueue&);
+
+	void enqueue(Notification* pNotification, bool urgent);
+
+#if defined(POCO_HAVE_GCC_ATOMICS)
+	struct Cell
+	{
+		volatile std::size_t   sequence;
+		Notification* volatile pNotification;
+	};
+
+	enum
+	{
+		CACHE_LINE_SIZE = 64
+	};
+
+	void push(Notification* pNotification);
+	Notification* pop();
+	Notification* dequeueOne();
+	static bool claimWaiter(volatile unsigned& waiting);
+	static void unregisterWaiter(volatile unsigned& waiting, Semaphore& sem);
+
+	Cell*                      _pCells;
+	std::size_t                _mask;
+	int                        _capacity;
+	char                       _pad1[CACHE_LINE_SIZE];
+	volatile std::size_t       _enqueuePos;
+	char                       _pad2[CACHE_LINE_SIZE];
+	volatile std::size_t       _dequeuePos;
+	char                       _pad3[CACHE_LINE_SIZE];
+	volatile int               _count;
+	volatile int               _urgentCount;
+	volatile unsigned          _waitingConsumers;
+	volatile unsigned          _waitingProducers;
+	std::vector<Notification*> _urgent;
+	FastMutex                  _urgentMutex;
+#else
+	Notification* dequeueOne(bool& wakeProducer);
+
+	typedef std::vector<Notification*> Ring;
+
+	Ring              _ring;
+	int               _capacity;
+	int               _head;
+	int               _count;
+	int               _waitingConsumers;
+	int               _waitingProducers;
+	int               _generation;
+	mutable FastMutex _mutex;
+#endif
+	Semaphore         _nfAvailable;
+	Semaphore         _spaceAvailable;
+};
+
+
+//
+// inlines
+//
+inline int BoundedNotificationQueue::capacity() const
+{
+	return _capacity;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BoundedNotificationQueue_INCLUDED
@@ -81,7 +81,7 @@ public:
 		if (preserveContent)
 		{
 			std::size_t n = newSize > _size ? _size : newSize;
-			std::memcpy(ptr, _ptr, n);
+			std::memcpy(ptr, _ptr, n*sizeof(T));
 		}
 		delete [] _ptr;
 		_ptr  = ptr;
@@ -0,0 +1,451 @@
+//
+// ConcurrentCache.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/ConcurrentCache.h#1 $
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ConcurrentCache
+//
+// Definition of the ConcurrentCache class template.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ConcurrentCache_INCLUDED
+#define Foundation_ConcurrentCache_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/HashMap.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Environment.h"
+#include "Poco/Mutex.h"
+#include "Poco/Exception.h"
+#include <vector>
+#include <set>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <class TKey, class TValue, class THash = Hash<TKey>, class TMutex = FastMutex>
+class ConcurrentCache
+	/// A ConcurrentCache is a size-limited, optionally expiring
+	/// cache built for many threads accessing it at the same time.
+	///
+	/// In contrast to AbstractCache, which keeps all entries in a
+	/// single std::map protected by a single mutex, and informs its
+	/// strategies of every access through events, the entries of a
+	/// ConcurrentCache are distributed over a number of shards, by
+	/// the hash value of their keys. Each shard has its own mutex,
+	/// a hash index and two intrusive lists: one keeping its entries
+	/// in least recently used order, the other in the order they were
+	/// added or updated. All operations on a single key are O(1) and
+	/// only lock the shard the key belongs to.
+	///
+	/// Since the expiration time is the same for all entries, the
+	/// entries of a shard expire in the order they were added, so
+	/// expired entries can be found without searching.
+	///
+	/// Each shard holds an equal part of the cache's size. When a shard
+	/// is full, its least recently used entry is replaced, which is not
+	/// necessarily the least recently used entry of the whole cache.
+	/// With a single shard, a ConcurrentCache replaces exactly like an
+	/// LRUCache.
+	///
+	/// A ConcurrentCache has no events and no pluggable strategies.
+	/// ConcurrentLRUCache and ConcurrentExpireLRUCache provide the
+	/// same interface as LRUCache and ExpireLRUCache.
+{
+public:
+	typedef std::set<TKey> KeySet;
+
+	ConcurrentCache(long size, Timestamp::TimeDiff expire = 0, int shards = 0):
+		_expire(expire*1000)
+		/// Creates the ConcurrentCache, holding up to size entries
+		/// for at most expire milliseconds. If expire is 0, entries
+		/// never expire.
+		///
+		/// If shards is 0, twice the number of processors (see
+		/// Environment::processorCount()) are used. The number of
+		/// shards is limited to the size of the cache.
+	{
+		if (size < 1) throw InvalidArgumentException("size must be > 0");
+		if (expire < 0 || (expire > 0 && expire < 25)) throw InvalidArgumentException("expireTime must be at least 25 ms");
+
+		std::size_t n = shards > 0 ? shards : 2*Environment::processorCount();
+		std::size_t total = static_cast<std::size_t>(size);
+		if (n > total) n = total;
+		_shards.reserve(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			Shard* pShard = new Shard;
+			pShard->capacity = total/n + (i < total % n ? 1 : 0);
+			_shards.push_back(pShard);
+		}
+	}
+
+	~ConcurrentCache()
+		/// Destroys the ConcurrentCache.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			clearShard(**it);
+			delete *it;
+		}
+	}
+
+	void add(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If for the key already an entry exists, it will be overwritten.
+	{
+		add(key, SharedPtr<TValue>(new TValue(val)));
+	}
+
+	void add(const TKey& key, SharedPtr<TValue> val)
+		/// Adds the key value pair to the cache. Note that adding a NULL SharedPtr will fail!
+		/// If for the key already an entry exists, it will be overwritten.
+	{
+		Shard& s = shard(key);
+		typename TMutex::ScopedLock lock(s.mutex);
+
+		typename Index::Iterator it = s.index.find(key);
+		if (it != s.index.end())
+		{
+			Node* pNode = it->second;
+			pNode->value = val;
+			pNode->created.update();
+			unlinkAge(s, pNode);
+			linkAge(s, pNode);
+			touch(s, pNode);
+		}
+		else
+		{
+			Node* pNode = new Node(key, val);
+			s.index.insert(typename Index::ValueType(key, pNode));
+			linkAge(s, pNode);
+			linkUse(s, pNode);
+		}
+		purge(s);
+		while (s.index.size() > s.capacity) removeNode(s, s.pLeastRecent);
+	}
+
+	void update(const TKey& key, const TValue& val)
+		/// Same as add(), as there are no events to distinguish
+		/// an update from a remove followed by an add.
+	{
+		add(key, val);
+	}
+
+	void update(const TKey& key, SharedPtr<TValue> val)
+		/// Same as add(), as there are no events to distinguish
+		/// an update from a remove followed by an add.
+	{
+		add(key, val);
+	}
+
+	void remove(const TKey& key)
+		/// Removes an entry from the cache. If the entry is not found,
+		/// the remove is ignored.
+	{
+		Shard& s = shard(key);
+		typename TMutex::ScopedLock lock(s.mutex);
+
+		typename Index::Iterator it = s.index.find(key);
+		if (it != s.index.end()) removeNode(s, it->second);
+	}
+
+	bool has(const TKey& key) const
+		/// Returns true if the cache contains a value for the key.
+	{
+		Shard& s = shard(key);
+		typename TMutex::ScopedLock lock(s.mutex);
+
+		typename Index::Iterator it = s.index.find(key);
+		return it != s.index.end() && !isExpired(it->second);
+	}
+
+	SharedPtr<TValue> get(const TKey& key)
+		/// Returns a SharedPtr of the value. The SharedPointer will remain valid
+		/// even when cache replacement removes the element.
+		/// If for the key no value exists, an empty SharedPtr is returned.
+	{
+		Shard& s = shard(key);
+		typename TMutex::ScopedLock lock(s.mutex);
+
+		typename Index::Iterator it = s.index.find(key);
+		if (it != s.index.end())
+		{
+			Node* pNode = it->second;
+			if (isExpired(pNode))
+			{
+				removeNode(s, pNode);
+			}
+			else
+			{
+				touch(s, pNode);
+				return pNode->value;
+			}
+		}
+		return SharedPtr<TValue>();
+	}
+
+	void clear()
+		/// Removes all elements from the cache.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			typename TMutex::ScopedLock lock((*it)->mutex);
+			clearShard(**it);
+		}
+	}
+
+	std::size_t size()
+		/// Returns the number of cached elements.
+		///
+		/// As the shards are visited one after the other, the result
+		/// is only a snapshot if other threads modify the cache.
+	{
+		std::size_t result = 0;
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			typename TMutex::ScopedLock lock((*it)->mutex);
+			purge(**it);
+			result += (*it)->index.size();
+		}
+		return result;
+	}
+
+	void forceReplace()
+		/// Removes all expired entries from the cache.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			typename TMutex::ScopedLock lock((*it)->mutex);
+			purge(**it);
+		}
+	}
+
+	KeySet getAllKeys()
+		/// Returns a copy of all keys stored in the cache.
+	{
+		KeySet result;
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			typename TMutex::ScopedLock lock((*it)->mutex);
+			purge(**it);
+			for (Node* pNode = (*it)->pMostRecent; pNode; pNode = pNode->pLessRecent)
+				result.insert(pNode->key);
+		}
+		return result;
+	}
+
+	int shards() const
+		/// Returns the number of shards.
+	{
+		return static_cast<int>(_shards.size());
+	}
+
+private:
+	ConcurrentCache();
+	ConcurrentCache(const ConcurrentCache&);
+	ConcurrentCache& operator = (const ConcurrentCache&);
+
+	struct Node
+		/// A cache entry, linked into the use list and
+		/// the age list of its shard.
+	{
+		Node(const TKey& k, const SharedPtr<TValue>& v):
+			key(k),
+			value(v),
+			pMoreRecent(0),
+			pLessRecent(0),
+			pNewer(0),
+			pOlder(0)
+		{
+		}
+
+		TKey              key;
+		SharedPtr<TValue> value;
+		Timestamp         created;
+		Node*             pMoreRecent;
+		Node*             pLessRecent;
+		Node*             pNewer;
+		Node*             pOlder;
+	};
+
+	typedef HashMap<TKey, Node*, THash> Index;
+
+	struct Shard
+	{
+		enum
+		{
+			CACHE_LINE_SIZE = 64
+		};
+
+		Shard():
+			capacity(0),
+			pMostRecent(0),
+			pLeastRecent(0),
+			pNewest(0),
+			pOldest(0)
+		{
+		}
+
+		TMutex      mutex;
+		Index       index;
+		std::size_t capacity;
+		Node*       pMostRecent;
+		Node*       pLeastRecent;
+		Node*       pNewest;
+		Node*       pOldest;
+		char        padding[CACHE_LINE_SIZE];
+			/// keeps the mutexes of adjacent shards
+			/// out of the same cache line
+	};
+
+	typedef std::vector<Shard*> ShardVec;
+
+	Shard& shard(const TKey& key) const
+	{
+		// The hash value is mixed once more, as the index of each
+		// shard would otherwise only see hash values with identical
+		// remainders, leaving most of its buckets empty.
+		std::size_t h = _hash(key);
+		h ^= h >> 15;
+		h *= 0x2C1B3C6DU;
+		h ^= h >> 12;
+		return *_shards[h % _shards.size()];
+	}
+
+	bool isExpired(const Node* pNode) const
+	{
+		return _expire > 0 && pNode->created.isElapsed(_expire);
+	}
+
+	static void linkUse(Shard& s, Node* pNode)
+	{
+		pNode->pMoreRecent = 0;
+		pNode->pLessRecent = s.pMostRecent;
+		if (s.pMostRecent)
+			s.pMostRecent->pMoreRecent = pNode;
+		else
+			s.pLeastRecent = pNode;
+		s.pMostRecent = pNode;
+	}
+
+	static void unlinkUse(Shard& s, Node* pNode)
+	{
+		if (pNode->pMoreRecent)
+			pNode->pMoreRecent->pLessRecent = pNode->pLessRecent;
+		else
+			s.pMostRecent = pNode->pLessRecent;
+		if (pNode->pLessRecent)
+			pNode->pLessRecent->pMoreRecent = pNode->pMoreRecent;
+		else
+			s.pLeastRecent = pNode->pMoreRecent;
+	}
+
+	static void linkAge(Shard& s, Node* pNode)
+	{
+		pNode->pNewer = 0;
+		pNode->pOlder = s.pNewest;
+		if (s.pNewest)
+			s.pNewest->pNewer = pNode;
+		else
+			s.pOldest = pNode;
+		s.pNewest = pNode;
+	}
+
+	static void unlinkAge(Shard& s, Node* pNode)
+	{
+		if (pNode->pNewer)
+			pNode->pNewer->pOlder = pNode->pOlder;
+		else
+			s.pNewest = pNode->pOlder;
+		if (pNode->pOlder)
+			pNode->pOlder->pNewer = pNode->pNewer;
+		else
+			s.pOldest = pNode->pNewer;
+	}
+
+	static void touch(Shard& s, Node* pNode)
+		/// Makes the node the most recently used one.
+	{
+		if (s.pMostRecent != pNode)
+		{
+			unlinkUse(s, pNode);
+			linkUse(s, pNode);
+		}
+	}
+
+	static void removeNode(Shard& s, Node* pNode)
+	{
+		unlinkUse(s, pNode);
+		unlinkAge(s, pNode);
+		s.index.erase(pNode->key);
+		delete pNode;
+	}
+
+	void purge(Shard& s)
+		/// Removes the expired entries, which are all
+		/// at the old end of the age list.
+	{
+		if (_expire > 0)
+		{
+			Timestamp now;
+			while (s.pOldest && now - s.pOldest->created >= _expire)
+				removeNode(s, s.pOldest);
+		}
+	}
+
+	static void clearShard(Shard& s)
+	{
+		Node* pNode = s.pMostRecent;
+		while (pNode)
+		{
+			Node* pNext = pNode->pLessRecent;
+			delete pNode;
+			pNode = pNext;
+		}
+		s.index.clear();
+		s.pMostRecent = s.pLeastRecent = s.pNewest = s.pOldest = 0;
+	}
+
+	Timestamp::TimeDiff _expire;
+	ShardVec            _shards;
+	THash               _hash;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentCache_INCLUDED
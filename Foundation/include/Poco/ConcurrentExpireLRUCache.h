@@ -0,0 +1,82 @@
+//
+// ConcurrentExpireLRUCache.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/ConcurrentExpireLRUCache.h#1 $
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ConcurrentExpireLRUCache
+//
+// Definition of the ConcurrentExpireLRUCache class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ConcurrentExpireLRUCache_INCLUDED
+#define Foundation_ConcurrentExpireLRUCache_INCLUDED
+
+
+#include "Poco/ConcurrentCache.h"
+
+
+namespace Poco {
+
+
+template <
+	class TKey, 
+	class TValue,
+	class THash = Hash<TKey>,
+	class TMutex = FastMutex
+> 
+class ConcurrentExpireLRUCache: public ConcurrentCache<TKey, TValue, THash, TMutex>
+	/// A ConcurrentExpireLRUCache is a drop-in replacement for ExpireLRUCache
+	/// for caches shared by many threads. It caches entries for a fixed time
+	/// period (per default 10 minutes), but also limits the size of the cache
+	/// (per default: 1024). See ConcurrentCache for details.
+{
+public:
+	ConcurrentExpireLRUCache(long cacheSize = 1024, Timestamp::TimeDiff expire = 600000, int shards = 0):
+		ConcurrentCache<TKey, TValue, THash, TMutex>(cacheSize, expire, shards)
+		/// Creates the ConcurrentExpireLRUCache. If shards is 0, the number of
+		/// shards is chosen according to the number of processors.
+	{
+	}
+
+	~ConcurrentExpireLRUCache()
+	{
+	}
+
+private:
+	ConcurrentExpireLRUCache(const ConcurrentExpireLRUCache& aCache);
+	ConcurrentExpireLRUCache& operator = (const ConcurrentExpireLRUCache& aCache);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentExpireLRUCache_INCLUDED
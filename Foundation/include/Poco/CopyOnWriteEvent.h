@@ -0,0 +1,94 @@
+//
+// CopyOnWriteEvent.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/CopyOnWriteEvent.h#1 $
+//
+// Library: Foundation
+// Package: Events
+// Module:  CopyOnWriteEvent
+//
+// Implementation of the CopyOnWriteEvent template.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_CopyOnWriteEvent_INCLUDED
+#define Foundation_CopyOnWriteEvent_INCLUDED
+
+
+#include "Poco/AbstractEvent.h"
+#include "Poco/CopyOnWriteStrategy.h"
+#include "Poco/AbstractDelegate.h"
+#include "Poco/Mutex.h"
+
+
+namespace Poco {
+
+
+template <class TArgs, class TMutex = NullMutex> 
+class CopyOnWriteEvent: public AbstractEvent < 
+	TArgs, CopyOnWriteStrategy<TArgs, AbstractDelegate<TArgs> >,
+	AbstractDelegate<TArgs>,
+	TMutex
+>
+	/// A CopyOnWriteEvent uses the CopyOnWriteStrategy, which
+	/// invokes delegates in the order they have been registered.
+	///
+	/// In contrast to BasicEvent, notify() neither allocates
+	/// memory nor acquires a lock, while adding and removing
+	/// delegates is more expensive. CopyOnWriteEvent is
+	/// therefore well suited for events that are fired
+	/// frequently, possibly from many threads at once, but
+	/// whose delegates rarely change.
+	///
+	/// Since the CopyOnWriteStrategy synchronizes itself, the
+	/// event uses a NullMutex by default. Note that enable()
+	/// and disable() are then not synchronized with notify()
+	/// calls in progress in other threads.
+	///
+	/// Please see the AbstractEvent class template documentation
+	/// for more information.
+{
+public:
+	CopyOnWriteEvent()
+	{
+	}
+
+	~CopyOnWriteEvent()
+	{
+	}
+
+private:
+	CopyOnWriteEvent(const CopyOnWriteEvent& e);
+	CopyOnWriteEvent& operator = (const CopyOnWriteEvent& e);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CopyOnWriteEvent_INCLUDED
@@ -0,0 +1,254 @@
+//
+// CopyOnWriteStrategy.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/CopyOnWriteStrategy.h#1 $
+//
+// Library: Foundation
+// Package: Events
+// Module:  CopyOnWriteStrategy
+//
+// Implementation of the CopyOnWriteStrategy template.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_CopyOnWriteStrategy_INCLUDED
+#define Foundation_CopyOnWriteStrategy_INCLUDED
+
+
+#include "Poco/NotificationStrategy.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+template <class TArgs, class TDelegate> 
+class CopyOnWriteStrategy: public NotificationStrategy<TArgs, TDelegate>
+	/// A notification strategy that keeps its delegates in an
+	/// immutable, reference counted snapshot.
+	///
+	/// Delegates are invoked in the order in which they have
+	/// been registered, just as with DefaultStrategy.
+	///
+	/// add(), remove() and clear() build a new snapshot and swap
+	/// it in, while copying the strategy (which AbstractEvent::notify()
+	/// does for every notification) only duplicates the current
+	/// snapshot. Copying and notifying therefore neither allocate
+	/// memory nor acquire a lock, which makes this strategy the
+	/// right choice for events that are fired often but rarely
+	/// change their delegates. Modifications are serialized
+	/// by a mutex and cost O(n).
+	///
+	/// CopyOnWriteStrategy is thread safe on its own, so an
+	/// AbstractEvent using it does not need a mutex. See
+	/// CopyOnWriteEvent.
+{
+public:
+	typedef SharedPtr<TDelegate>              DelegatePtr;
+	typedef std::vector<DelegatePtr>          Delegates;
+	typedef typename Delegates::iterator        Iterator;
+
+	CopyOnWriteStrategy():
+		_pSnapshot(0),
+		_pMutex(new FastMutex)
+	{
+	}
+
+	CopyOnWriteStrategy(const CopyOnWriteStrategy& s):
+		_pSnapshot(s.acquire()),
+		_pMutex(0)
+	{
+		// A copy is normally only used for a single notification,
+		// so its mutex is not created before it is actually modified.
+	}
+
+	~CopyOnWriteStrategy()
+	{
+		releaseRetired();
+		if (_pSnapshot) _pSnapshot->release();
+		delete _pMutex;
+	}
+
+	void notify(const void* sender, TArgs& arguments)
+		/// Invokes all delegates in the current snapshot.
+		///
+		/// Like with DefaultStrategy, this must not be called
+		/// concurrently with add(), remove() or clear(); AbstractEvent
+		/// notifies a copy of its strategy instead.
+	{
+		Snapshot* pSnapshot = _pSnapshot;
+		if (pSnapshot)
+		{
+			for (Iterator it = pSnapshot->delegates.begin(); it != pSnapshot->delegates.end(); ++it)
+			{
+				(*it)->notify(sender, arguments);
+			}
+		}
+	}
+
+	void add(const TDelegate& delegate)
+	{
+		DelegatePtr pDelegate(static_cast<TDelegate*>(delegate.clone()));
+		FastMutex::ScopedLock lock(mutex());
+		Snapshot* pNew = new Snapshot;
+		if (_pSnapshot)
+		{
+			pNew->delegates.reserve(_pSnapshot->delegates.size() + 1);
+			pNew->delegates = _pSnapshot->delegates;
+		}
+		pNew->delegates.push_back(pDelegate);
+		publish(pNew);
+	}
+
+	void remove(const TDelegate& delegate)
+	{
+		FastMutex::ScopedLock lock(mutex());
+		if (!_pSnapshot) return;
+
+		Delegates& delegates = _pSnapshot->delegates;
+		for (Iterator it = delegates.begin(); it != delegates.end(); ++it)
+		{
+			if (delegate.equals(**it))
+			{
+				(*it)->disable();
+				Snapshot* pNew = 0;
+				if (delegates.size() > 1)
+				{
+					pNew = new Snapshot;
+					pNew->delegates.reserve(delegates.size() - 1);
+					pNew->delegates.insert(pNew->delegates.end(), delegates.begin(), it);
+					pNew->delegates.insert(pNew->delegates.end(), it + 1, delegates.end());
+				}
+				publish(pNew);
+				return;
+			}
+		}
+	}
+
+	CopyOnWriteStrategy& operator = (const CopyOnWriteStrategy& s)
+	{
+		if (this != &s)
+		{
+			Snapshot* pNew = s.acquire();
+			FastMutex::ScopedLock lock(mutex());
+			publish(pNew);
+		}
+		return *this;
+	}
+
+	void clear()
+	{
+		FastMutex::ScopedLock lock(mutex());
+		if (!_pSnapshot) return;
+
+		for (Iterator it = _pSnapshot->delegates.begin(); it != _pSnapshot->delegates.end(); ++it)
+		{
+			(*it)->disable();
+		}
+		publish(0);
+	}
+
+	bool empty() const
+	{
+		return _pSnapshot == 0;
+	}
+
+protected:
+	class Snapshot: public RefCountedObject
+		/// An immutable list of delegates. An empty list
+		/// is represented by a null pointer.
+	{
+	public:
+		Delegates delegates;
+
+	protected:
+		~Snapshot()
+		{
+		}
+	};
+
+	Snapshot* acquire() const
+		/// Returns the current snapshot, with its reference
+		/// count incremented, or null if there are no delegates.
+	{
+		// _readers tells publish() that a snapshot pointer may
+		// have been loaded, but not yet been duplicated.
+		++_readers;
+		Snapshot* pSnapshot = _pSnapshot;
+		if (pSnapshot) pSnapshot->duplicate();
+		--_readers;
+		return pSnapshot;
+	}
+
+	void publish(Snapshot* pNew)
+		/// Replaces the current snapshot with pNew, taking
+		/// ownership of it. The mutex must be locked.
+	{
+		Snapshot* pOld = _pSnapshot;
+		if (pOld) _retired.push_back(pOld);
+		_pSnapshot = pNew;
+
+		// Incrementing _readers is a full memory barrier, so any
+		// acquire() that starts afterwards sees the new snapshot.
+		// If no other thread is inside acquire() at this point,
+		// the retired snapshots can no longer be duplicated and are
+		// released. Otherwise, this is deferred to the next publish().
+		if (++_readers == 1) releaseRetired();
+		--_readers;
+	}
+
+	void releaseRetired()
+	{
+		for (typename std::vector<Snapshot*>::iterator it = _retired.begin(); it != _retired.end(); ++it)
+		{
+			(*it)->release();
+		}
+		_retired.clear();
+	}
+
+	FastMutex& mutex()
+	{
+		if (!_pMutex) _pMutex = new FastMutex;
+		return *_pMutex;
+	}
+
+	Snapshot* volatile     _pSnapshot;
+	mutable AtomicCounter  _readers;
+	std::vector<Snapshot*> _retired;
+	FastMutex*             _pMutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CopyOnWriteStrategy_INCLUDED
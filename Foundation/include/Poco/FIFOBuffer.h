@@ -0,0 +1,240 @@
+//
+// FIFOBuffer.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/FIFOBuffer.h#1 $
+//
+// Library: Foundation
+// Package: Core
+// Module:  FIFOBuffer
+//
+// Definition of the FIFOBuffer class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_FIFOBuffer_INCLUDED
+#define Foundation_FIFOBuffer_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Buffer.h"
+#include <cstring>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <class T>
+class BasicFIFOBuffer
+	/// A simple, non-thread-safe first-in first-out buffer
+	/// of a fixed (but resizable) capacity.
+	///
+	/// Data is appended at the end of the buffer with write(),
+	/// or directly via next() and advance(), and consumed from
+	/// the beginning with read(), or directly via begin() and drain().
+	///
+	/// In contrast to a ring buffer, the used part of a BasicFIFOBuffer
+	/// is always contiguous, so it can be passed directly to system calls
+	/// like send() and recv(). Before data is appended, any remaining
+	/// content is moved to the beginning of the buffer, so that all
+	/// available space is contiguous as well. If the buffer is used to
+	/// process complete messages, the content to be moved is usually
+	/// small or empty.
+{
+public:
+	BasicFIFOBuffer(std::size_t size):
+		_buffer(size),
+		_begin(0),
+		_used(0)
+		/// Creates the BasicFIFOBuffer with the given capacity.
+	{
+	}
+
+	~BasicFIFOBuffer()
+		/// Destroys the BasicFIFOBuffer.
+	{
+	}
+
+	std::size_t size() const
+		/// Returns the capacity of the buffer.
+	{
+		return _buffer.size();
+	}
+
+	std::size_t used() const
+		/// Returns the number of elements in the buffer.
+	{
+		return _used;
+	}
+
+	std::size_t available() const
+		/// Returns the number of elements that can be
+		/// written to the buffer.
+	{
+		return _buffer.size() - _used;
+	}
+
+	bool isEmpty() const
+		/// Returns true iff the buffer is empty.
+	{
+		return _used == 0;
+	}
+
+	bool isFull() const
+		/// Returns true iff the buffer is full.
+	{
+		return _used == _buffer.size();
+	}
+
+	std::size_t peek(T* buffer, std::size_t length) const
+		/// Copies up to length elements from the beginning of the
+		/// buffer into the given buffer, without removing them.
+		///
+		/// Returns the number of elements copied.
+	{
+		if (length > _used) length = _used;
+		std::memcpy(buffer, _buffer.begin() + _begin, length*sizeof(T));
+		return length;
+	}
+
+	std::size_t read(T* buffer, std::size_t length)
+		/// Copies up to length elements from the beginning of the
+		/// buffer into the given buffer, and removes them
+		/// from the buffer.
+		///
+		/// Returns the number of elements copied.
+	{
+		length = peek(buffer, length);
+		drain(length);
+		return length;
+	}
+
+	std::size_t write(const T* buffer, std::size_t length)
+		/// Appends up to length elements from the given buffer.
+		///
+		/// Returns the number of elements appended, which is
+		/// less than length if the buffer becomes full.
+	{
+		if (length > available()) length = available();
+		std::memcpy(next(), buffer, length*sizeof(T));
+		advance(length);
+		return length;
+	}
+
+	T* begin()
+		/// Returns a pointer to the first element in the buffer.
+		/// The used() elements starting there are contiguous.
+	{
+		return _buffer.begin() + _begin;
+	}
+
+	const T* begin() const
+		/// Returns a pointer to the first element in the buffer.
+		/// The used() elements starting there are contiguous.
+	{
+		return _buffer.begin() + _begin;
+	}
+
+	T* next()
+		/// Returns a pointer to the space following the last
+		/// element in the buffer, where available() elements
+		/// can be stored. Call advance() after storing them.
+	{
+		if (_begin > 0)
+		{
+			std::memmove(_buffer.begin(), _buffer.begin() + _begin, _used*sizeof(T));
+			_begin = 0;
+		}
+		return _buffer.begin() + _begin + _used;
+	}
+
+	void advance(std::size_t length)
+		/// Adds length elements, which have been stored at
+		/// the address returned by next(), to the buffer.
+	{
+		poco_assert (_begin + _used + length <= _buffer.size());
+
+		_used += length;
+	}
+
+	void drain(std::size_t length)
+		/// Removes length elements from the beginning
+		/// of the buffer.
+	{
+		poco_assert (length <= _used);
+
+		_used -= length;
+		if (_used == 0)
+			_begin = 0;
+		else
+			_begin += length;
+	}
+
+	void clear()
+		/// Removes all elements from the buffer.
+	{
+		_begin = 0;
+		_used  = 0;
+	}
+
+	void resize(std::size_t newSize)
+		/// Changes the capacity of the buffer. The content
+		/// of the buffer is preserved; newSize must not be
+		/// less than used().
+	{
+		poco_assert (newSize >= _used);
+
+		if (_begin > 0)
+		{
+			std::memmove(_buffer.begin(), _buffer.begin() + _begin, _used*sizeof(T));
+			_begin = 0;
+		}
+		_buffer.resize(newSize, true);
+	}
+
+private:
+	BasicFIFOBuffer();
+	BasicFIFOBuffer(const BasicFIFOBuffer&);
+	BasicFIFOBuffer& operator = (const BasicFIFOBuffer&);
+
+	Buffer<T>   _buffer;
+	std::size_t _begin;
+	std::size_t _used;
+};
+
+
+//
+// We provide an instantiation for char
+//
+typedef BasicFIFOBuffer<char> FIFOBuffer;
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FIFOBuffer_INCLUDED
@@ -44,6 +44,10 @@
 #include "Poco/Channel.h"
 #include "Poco/Timestamp.h"
 #include "Poco/Mutex.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include <vector>
 
 
 namespace Poco {
@@ -55,7 +59,7 @@ class ArchiveStrategy;
 class PurgeStrategy;
 
 
-class Foundation_API FileChannel: public Channel
+class Foundation_API FileChannel: public Channel, public Runnable
 	/// A Channel that writes to a file. This class supports
 	/// flexible log file rotation and archiving, as well
 	/// as automatic purging of archived log files.
@@ -166,6 +170,28 @@ class Foundation_API FileChannel: public Channel
 	/// If the number is exceeded, archived log files are 
 	/// deleted, starting with the oldest.
 	///
+	/// By default, every message is written and flushed to the
+	/// file before log() returns. Setting the "flush" property
+	/// to false leaves flushing to the stream buffer, which
+	/// saves a system call per message.
+	///
+	/// Setting the "async" property to true enables batched
+	/// writing. log() then only appends the message text to an
+	/// in-memory queue, and a background thread writes the queued
+	/// messages to the file and flushes it as a batch. A batch is
+	/// written at least every "flushInterval" milliseconds, or
+	/// as soon as "flushSize" bytes are queued. Messages with a
+	/// priority at or above "flushPriority" (error by default)
+	/// are written synchronously, together with all messages
+	/// queued before them, and the file is flushed before log()
+	/// returns. If the writer thread cannot keep up and more than
+	/// "maxQueueSize" bytes are queued, log() writes the queued
+	/// messages and the new one synchronously, so the queue does not
+	/// grow without bounds. Rotation, archiving and purging work the
+	/// same as in synchronous mode. Queued messages can be lost if the
+	/// process terminates abnormally; flush() and close() write
+	/// them out.
+	///
 	/// For a more lightweight file channel class, see SimpleFileChannel.
 {
 public:
@@ -183,6 +209,10 @@ public:
 
 	void log(const Message& msg);
 		/// Logs the given message to the file.
+
+	void flush();
+		/// Writes all queued messages to the file and
+		/// flushes it.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets the property with the given name. 
@@ -204,6 +234,23 @@ public:
 		///   * purgeCount: Maximum number of archived log files before
 		///                 files are purged. See the FileChannel class
 		///                 for details.
+		///   * flush:      Flush the file after every message in
+		///                 synchronous mode ("true", default, or "false").
+		///   * async:      Enable or disable batched writing in a
+		///                 background thread ("true" or "false", default).
+		///   * flushInterval: Maximum time in milliseconds messages are
+		///                 queued in asynchronous mode (default 1000).
+		///                 Must be greater than zero.
+		///   * flushSize:  Number of queued bytes that triggers a write
+		///                 in asynchronous mode (default 65536).
+		///   * flushPriority: Messages with this priority or higher
+		///                 are written synchronously in asynchronous
+		///                 mode. Takes a level name as accepted by
+		///                 Logger::setLevel() (default "error").
+		///   * maxQueueSize: Maximum number of bytes queued in
+		///                 asynchronous mode before log() writes
+		///                 synchronously (default 1048576, 0 for
+		///                 no limit).
 
 	std::string getProperty(const std::string& name) const;
 		/// Returns the value of the property with the given name.
@@ -226,6 +273,12 @@ public:
 	static const std::string PROP_COMPRESS;
 	static const std::string PROP_PURGEAGE;
 	static const std::string PROP_PURGECOUNT;
+	static const std::string PROP_FLUSH;
+	static const std::string PROP_ASYNC;
+	static const std::string PROP_FLUSHINTERVAL;
+	static const std::string PROP_FLUSHSIZE;
+	static const std::string PROP_FLUSHPRIORITY;
+	static const std::string PROP_MAXQUEUESIZE;
 
 protected:
 	~FileChannel();
@@ -234,9 +287,25 @@ protected:
 	void setCompress(const std::string& compress);
 	void setPurgeAge(const std::string& age);
 	void setPurgeCount(const std::string& count);
+	void setAsync(const std::string& async);
+	void setFlushInterval(const std::string& interval);
+	void setFlushPriority(const std::string& priority);
 	void purge();
+	void run();
 
 private:
+	void write(const std::string& text, bool flush);
+	void writeQueued();
+	bool enqueue(const Message& msg, bool& async);
+		/// Queues the message for the writer thread if asynchronous
+		/// mode is enabled and the message's priority is below
+		/// flushPriority, and the queue has not reached maxQueueSize.
+		/// Returns false if the message must be written synchronously.
+		/// Stores the asynchronous mode setting in async.
+	void stopWriter();
+
+	typedef std::vector<std::string> TextQueue;
+
 	std::string      _path;
 	std::string      _times;
 	std::string      _rotation;
@@ -248,7 +317,23 @@ private:
 	RotateStrategy*  _pRotateStrategy;
 	ArchiveStrategy* _pArchiveStrategy;
 	PurgeStrategy*   _pPurgeStrategy;
+	bool             _flush;
+	bool             _async;         // guarded by _queueMutex
+	long             _flushInterval; // guarded by _queueMutex
+	std::size_t      _flushSize;     // guarded by _queueMutex
+	int              _flushPriority; // guarded by _queueMutex
+	std::size_t      _maxQueueSize;  // guarded by _queueMutex
+	std::string      _flushPriorityName;
 	FastMutex        _mutex;
+
+	TextQueue        _queue;
+	TextQueue        _batch;
+	std::size_t      _queuedBytes;
+	bool             _writerRunning;
+	bool             _stopWriter;
+	Thread           _writer;
+	Event            _wakeUp;
+	mutable FastMutex _queueMutex;
 };
 
 
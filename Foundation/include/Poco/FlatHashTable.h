@@ -0,0 +1,564 @@
+//
+// FlatHashTable.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/FlatHashTable.h#1 $
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashTable
+//
+// Definition of the FlatHashTable class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_FlatHashTable_INCLUDED
+#define Foundation_FlatHashTable_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Hash.h"
+#include "Poco/Exception.h"
+#include <iterator>
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <class Value, class HashFunc = Hash<Value> >
+class FlatHashTable
+	/// This class implements a hash table using open addressing
+	/// with linear probing and Robin Hood replacement.
+	///
+	/// All values are stored in a single array, so, unlike
+	/// with LinearHashTable, inserting a value does not require
+	/// a memory allocation of its own (unless the table has to
+	/// grow) and looking up a value does not have to follow
+	/// pointers. A second array holds one byte per slot, the
+	/// distance of the value in the slot from its home slot
+	/// (or zero, if the slot is empty). Lookups scan this array
+	/// and only compare values at the slots where the distance
+	/// matches. With Robin Hood replacement, a value that is
+	/// closer to its home slot gives way to a value inserted later
+	/// that is farther away, which keeps the probe sequences short
+	/// and lets unsuccessful lookups stop early. Erased values are
+	/// removed by shifting the following values back, so that no
+	/// tombstones are needed.
+	///
+	/// The table grows by doubling whenever it is 7/8 full.
+	/// The bits of the hash values are mixed before they are used
+	/// to address the table, as the hash functions in Poco/Hash.h
+	/// leave the low bits of multiples of powers of two unchanged.
+	/// Still, at most 254 different values may have identical hash
+	/// values; inserting more throws a RangeException, and so may
+	/// inserting a value or reserve() if a poor hash function makes
+	/// the table grow to more than 16 times the number of values.
+	/// The table is left unchanged in this case.
+	///
+	/// Value must be default constructible, swappable and must 
+	/// support comparison for equality. Empty slots hold 
+	/// default constructed values.
+	///
+	/// Inserting a value invalidates all iterators.
+	/// Erasing a value invalidates all iterators, except 
+	/// end().
+	///
+	/// The FlatHashTable is not thread safe.
+{
+public:
+	typedef Value               ValueType;
+	typedef Value&              Reference;
+	typedef const Value&        ConstReference;
+	typedef Value*              Pointer;
+	typedef const Value*        ConstPointer;
+	typedef HashFunc            Hash;
+
+	class ConstIterator: public std::iterator<std::forward_iterator_tag, Value>
+	{
+	public:
+		ConstIterator():
+			_pDist(0),
+			_pValue(0)
+		{
+		}
+		
+		ConstIterator(const UInt8* pDist, const Value* pValue):
+			_pDist(pDist),
+			_pValue(pValue)
+		{
+		}
+
+		bool operator == (const ConstIterator& it) const
+		{
+			return _pDist == it._pDist;
+		}
+
+		bool operator != (const ConstIterator& it) const
+		{
+			return _pDist != it._pDist;
+		}
+		
+		const Value& operator * () const
+		{
+			return *_pValue;
+		}
+
+		const Value* operator -> () const
+		{
+			return _pValue;
+		}
+		
+		ConstIterator& operator ++ () // prefix
+		{
+			// the distance array ends with a non-zero sentinel
+			do
+			{
+				++_pDist;
+				++_pValue;
+			}
+			while (*_pDist == 0);
+			return *this;
+		}
+		
+		ConstIterator operator ++ (int) // postfix
+		{
+			ConstIterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+		
+	protected:
+		const UInt8* _pDist;
+		const Value* _pValue;
+		
+		friend class FlatHashTable;
+	};
+	
+	class Iterator: public ConstIterator
+	{
+	public:
+		Iterator()
+		{
+		}
+		
+		Iterator(const UInt8* pDist, const Value* pValue):
+			ConstIterator(pDist, pValue)
+		{
+		}
+
+		Value& operator * () const
+		{
+			return const_cast<Value&>(*this->_pValue);
+		}
+
+		Value* operator -> () const
+		{
+			return const_cast<Value*>(this->_pValue);
+		}
+		
+		Iterator& operator ++ () // prefix
+		{
+			ConstIterator::operator ++ ();
+			return *this;
+		}
+		
+		Iterator operator ++ (int) // postfix
+		{
+			Iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		friend class FlatHashTable;
+	};
+	
+	FlatHashTable(std::size_t initialReserve = 64):
+		_mask(0),
+		_size(0)
+		/// Creates the FlatHashTable, with room for
+		/// initialReserve values before it has to grow.
+	{
+		allocate(calcCapacity(initialReserve));
+	}
+	
+	FlatHashTable(const FlatHashTable& table):
+		_dist(table._dist),
+		_values(table._values),
+		_mask(table._mask),
+		_size(table._size)
+		/// Creates the FlatHashTable by copying another one.
+	{
+	}
+	
+	~FlatHashTable()
+		/// Destroys the FlatHashTable.
+	{
+	}
+	
+	FlatHashTable& operator = (const FlatHashTable& table)
+		/// Assigns another FlatHashTable.
+	{
+		FlatHashTable tmp(table);
+		swap(tmp);
+		return *this;
+	}
+	
+	void swap(FlatHashTable& table)
+		/// Swaps the FlatHashTable with another one.
+	{
+		using std::swap;
+		swap(_dist, table._dist);
+		swap(_values, table._values);
+		swap(_mask, table._mask);
+		swap(_size, table._size);
+	}
+	
+	ConstIterator begin() const
+		/// Returns an iterator pointing to the first entry, if one exists.
+	{
+		return iteratorAt(first());
+	}
+	
+	ConstIterator end() const
+		/// Returns an iterator pointing to the end of the table.
+	{
+		return iteratorAt(_mask + 1);
+	}
+	
+	Iterator begin()
+		/// Returns an iterator pointing to the first entry, if one exists.
+	{
+		return iteratorAt(first());
+	}
+	
+	Iterator end()
+		/// Returns an iterator pointing to the end of the table.
+	{
+		return iteratorAt(_mask + 1);
+	}
+		
+	ConstIterator find(const Value& value) const
+		/// Finds an entry in the table.
+	{
+		return iteratorAt(lookup(value, home(value)));
+	}
+
+	Iterator find(const Value& value)
+		/// Finds an entry in the table.
+	{
+		return iteratorAt(lookup(value, home(value)));
+	}
+	
+	std::size_t count(const Value& value) const
+		/// Returns the number of elements with the given
+		/// value, with is either 1 or 0.
+	{
+		return lookup(value, home(value)) <= _mask ? 1 : 0;
+	}
+	
+	std::pair<Iterator, bool> insert(const Value& value)
+		/// Inserts an element into the table.
+		///
+		/// If the element already exists in the table,
+		/// a pair(iterator, false) with iterator pointing to the 
+		/// existing element is returned.
+		/// Otherwise, the element is inserted an a 
+		/// pair(iterator, true) with iterator
+		/// pointing to the new element is returned.
+		///
+		/// Throws a RangeException if there are too many values
+		/// with identical hash values (see the class description).
+	{
+		std::size_t hash = mix(_hash(value));
+		std::size_t index = lookup(value, hash & _mask);
+		if (index <= _mask)
+			return std::make_pair(iteratorAt(index), false);
+
+		while ((_size + 1)*8 > capacity()*7 || !fits(hash & _mask))
+		{
+			if ((_size + 1)*8 <= capacity()*7 && _size*16 < capacity())
+				throw RangeException("Too many values with identical hash values in FlatHashTable");
+			rehash(2*capacity());
+		}
+		Value tmp(value);
+		index = place(tmp, hash & _mask);
+		++_size;
+		return std::make_pair(iteratorAt(index), true);
+	}
+	
+	void erase(Iterator it)
+		/// Erases the element pointed to by it.
+	{
+		if (it != end())
+		{
+			using std::swap;
+			std::size_t index = it._pDist - &_dist[0];
+			for (;;)
+			{
+				std::size_t next = (index + 1) & _mask;
+				if (_dist[next] <= 1) break;
+				swap(_values[index], _values[next]);
+				_dist[index] = _dist[next] - 1;
+				index = next;
+			}
+			_dist[index] = 0;
+			_values[index] = Value();
+			--_size;
+		}
+	}
+	
+	void erase(const Value& value)
+		/// Erases the element with the given value, if it exists.
+	{
+		Iterator it = find(value);
+		erase(it);
+	}
+	
+	void clear()
+		/// Erases all elements.
+	{
+		FlatHashTable empty;
+		swap(empty);
+	}
+
+	void reserve(std::size_t size)
+		/// Makes room for the given number of elements,
+		/// so that the table does not have to grow
+		/// until it holds more elements.
+		///
+		/// Throws a RangeException if there are too many values
+		/// with identical hash values (see the class description).
+	{
+		std::size_t newCapacity = calcCapacity(size);
+		if (newCapacity > capacity()) rehash(newCapacity);
+	}
+	
+	std::size_t size() const
+		/// Returns the number of elements in the table.
+	{
+		return _size;
+	}
+	
+	bool empty() const
+		/// Returns true iff the table is empty.
+	{
+		return _size == 0;
+	}
+	
+	std::size_t capacity() const
+		/// Returns the number of slots in the table.
+	{
+		return _mask + 1;
+	}
+
+protected:
+	enum
+	{
+		MIN_CAPACITY = 16,
+		MAX_DISTANCE = 255
+	};
+
+	static std::size_t mix(std::size_t h)
+	{
+#if defined(POCO_PTR_IS_64_BIT)
+		h ^= h >> 32;
+#endif
+		h ^= h >> 15;
+		h *= 0x2C1B3C6DU;
+		h ^= h >> 12;
+		return h;
+	}
+
+	static std::size_t calcCapacity(std::size_t size)
+	{
+		std::size_t capacity = MIN_CAPACITY;
+		while (capacity/8*7 < size) capacity *= 2;
+		return capacity;
+	}
+
+	std::size_t home(const Value& value) const
+	{
+		return mix(_hash(value)) & _mask;
+	}
+
+	std::size_t lookup(const Value& value, std::size_t index) const
+		/// Returns the index of the value, or a value
+		/// greater than _mask if it is not in the table.
+	{
+		UInt8 dist = 1;
+		for (;;)
+		{
+			UInt8 d = _dist[index];
+			if (d < dist) return _mask + 1;
+			if (d == dist && _values[index] == value) return index;
+			index = (index + 1) & _mask;
+			++dist;
+		}
+	}
+
+	bool fits(std::size_t index) const
+		/// Returns true if a value can be inserted at the given
+		/// home slot without any distance exceeding MAX_DISTANCE.
+	{
+		// Values up to the next empty slot are shifted by at
+		// most one slot. The table is never full.
+		std::size_t n = 0;
+		UInt8 maxDist = 0;
+		while (_dist[index])
+		{
+			if (_dist[index] > maxDist) maxDist = _dist[index];
+			index = (index + 1) & _mask;
+			if (++n >= MAX_DISTANCE - 1) return false;
+		}
+		return maxDist < MAX_DISTANCE - 1;
+	}
+
+	std::size_t place(Value& value, std::size_t index)
+		/// Moves value into the table, starting at the given home
+		/// slot, and returns the index of the slot it ends up in.
+	{
+		using std::swap;
+		std::size_t result = _mask + 1;
+		UInt8 dist = 1;
+		for (;;)
+		{
+			UInt8& d = _dist[index];
+			if (d == 0)
+			{
+				swap(_values[index], value);
+				d = dist;
+				return result <= _mask ? result : index;
+			}
+			if (d < dist)
+			{
+				swap(_values[index], value);
+				swap(d, dist);
+				if (result > _mask) result = index;
+			}
+			index = (index + 1) & _mask;
+			++dist;
+		}
+	}
+
+	static bool fits(const std::vector<std::size_t>& hashes, std::size_t capacity)
+		/// Returns true if values with the given (mixed) hash
+		/// values can be placed, in this order, into a table with
+		/// the given capacity without any distance exceeding
+		/// MAX_DISTANCE - 1. As with place(), only the distances
+		/// determine where the values end up.
+	{
+		using std::swap;
+		std::vector<UInt8> dist(capacity, 0);
+		std::size_t mask = capacity - 1;
+		for (std::vector<std::size_t>::const_iterator it = hashes.begin(); it != hashes.end(); ++it)
+		{
+			std::size_t index = *it & mask;
+			UInt8 d = 1;
+			while (dist[index])
+			{
+				if (dist[index] < d) swap(dist[index], d);
+				index = (index + 1) & mask;
+				if (++d >= MAX_DISTANCE) return false;
+			}
+			dist[index] = d;
+		}
+		return true;
+	}
+
+	void rehash(std::size_t newCapacity)
+		/// Moves all values into a table with at least the given
+		/// capacity. The capacity is doubled until all values fit.
+		/// Throws a RangeException, leaving the table unchanged, if
+		/// the table would become more than 16 times larger than
+		/// the number of values.
+	{
+		std::vector<std::size_t> hashes;
+		hashes.reserve(_size);
+		for (std::size_t i = 0; i <= _mask; ++i)
+		{
+			if (_dist[i]) hashes.push_back(mix(_hash(_values[i])));
+		}
+		while (!fits(hashes, newCapacity))
+		{
+			if (_size*16 < newCapacity)
+				throw RangeException("Too many values with identical hash values in FlatHashTable");
+			newCapacity *= 2;
+		}
+
+		std::vector<UInt8> dist;
+		std::vector<Value> values;
+		_dist.swap(dist);
+		_values.swap(values);
+		allocate(newCapacity);
+		std::vector<std::size_t>::const_iterator itHash = hashes.begin();
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			if (dist[i])
+			{
+				place(values[i], *itHash++ & _mask);
+			}
+		}
+	}
+
+	void allocate(std::size_t capacity)
+	{
+		_dist.assign(capacity + 1, 0);
+		_dist[capacity] = 1; // sentinel for iterators
+		_values.assign(capacity, Value());
+		_mask = capacity - 1;
+	}
+
+	std::size_t first() const
+	{
+		std::size_t index = 0;
+		while (_dist[index] == 0) ++index;
+		return index;
+	}
+
+	Iterator iteratorAt(std::size_t index) const
+	{
+		if (index > _mask) index = _mask + 1;
+		return Iterator(&_dist[0] + index, &_values[0] + index);
+	}
+
+private:
+	std::vector<UInt8> _dist;
+	std::vector<Value> _values;
+	std::size_t        _mask;
+	std::size_t        _size;
+	Hash               _hash;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashTable_INCLUDED
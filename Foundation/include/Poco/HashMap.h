@@ -41,7 +41,7 @@
 
 
 #include "Poco/Foundation.h"
-#include "Poco/LinearHashTable.h"
+#include "Poco/FlatHashTable.h"
 #include "Poco/Exception.h"
 #include <utility>
 
@@ -102,9 +102,17 @@ private:
 
 template <class Key, class Mapped, class HashFunc = Hash<Key> >
 class HashMap
-	/// This class implements a map using a LinearHashTable.
+	/// This class implements a map using a FlatHashTable.
 	///
-	/// A HashMap can be used just like a std::map.
+	/// A HashMap can be used just like a std::map, except
+	/// that inserting or erasing an entry invalidates all
+	/// iterators.
+	///
+	/// Inserting an entry (with insert() or operator []) throws
+	/// a RangeException if there are too many keys with identical
+	/// hash values (more than 254, or a hash function so poor that
+	/// the table would have to grow excessively). See FlatHashTable
+	/// for details.
 {
 public:
 	typedef Key                 KeyType;
@@ -118,7 +126,7 @@ public:
 	typedef std::pair<KeyType, MappedType> PairType;
 	
 	typedef HashMapEntryHash<ValueType, HashFunc> HashType;
-	typedef LinearHashTable<ValueType, HashType>  HashTable;
+	typedef FlatHashTable<ValueType, HashType>    HashTable;
 	
 	typedef typename HashTable::Iterator      Iterator;
 	typedef typename HashTable::ConstIterator ConstIterator;
@@ -41,7 +41,7 @@
 
 
 #include "Poco/Foundation.h"
-#include "Poco/LinearHashTable.h"
+#include "Poco/FlatHashTable.h"
 
 
 namespace Poco {
@@ -49,9 +49,16 @@ namespace Poco {
 
 template <class Value, class HashFunc = Hash<Value> >
 class HashSet
-	/// This class implements a set using a LinearHashTable.
+	/// This class implements a set using a FlatHashTable.
 	///
-	/// A HashSet can be used just like a std::set.
+	/// A HashSet can be used just like a std::set, except
+	/// that inserting or erasing an element invalidates all
+	/// iterators.
+	///
+	/// Inserting an element throws a RangeException if there
+	/// are too many elements with identical hash values (more
+	/// than 254, or a hash function so poor that the table would
+	/// have to grow excessively). See FlatHashTable for details.
 {
 public:
 	typedef Value        ValueType;
@@ -61,7 +68,7 @@ public:
 	typedef const Value* ConstPointer;
 	typedef HashFunc     Hash;
 	
-	typedef LinearHashTable<ValueType, Hash> HashTable;
+	typedef FlatHashTable<ValueType, Hash> HashTable;
 	
 	typedef typename HashTable::Iterator      Iterator;
 	typedef typename HashTable::ConstIterator ConstIterator;
@@ -154,6 +161,9 @@ public:
 		/// Otherwise, the element is inserted an a 
 		/// pair(iterator, true) with iterator
 		/// pointing to the new element is returned.
+		///
+		/// Throws a RangeException if there are too many
+		/// elements with identical hash values.
 	{
 		return _table.insert(value);
 	}
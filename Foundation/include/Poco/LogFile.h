@@ -68,8 +68,14 @@ public:
 	~LogFile();
 		/// Destroys the LogFile.
 
-	void write(const std::string& text);
+	void write(const std::string& text, bool flush = true);
 		/// Writes the given text to the log file.
+		///
+		/// If flush is false, the text may be buffered
+		/// until the next call to flush().
+
+	void flush();
+		/// Flushes buffered text to the log file.
 	
 	UInt64 size() const;
 		/// Returns the current size in bytes of the log file.
@@ -85,9 +91,15 @@ public:
 //
 // inlines
 //
-inline void LogFile::write(const std::string& text)
+inline void LogFile::write(const std::string& text, bool flush)
+{
+	writeImpl(text, flush);
+}
+
+
+inline void LogFile::flush()
 {
-	writeImpl(text);
+	flushImpl();
 }
 
 
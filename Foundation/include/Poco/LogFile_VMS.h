@@ -57,7 +57,8 @@ class Foundation_API LogFileImpl
 public:
 	LogFileImpl(const std::string& path);
 	~LogFileImpl();
-	void writeImpl(const std::string& text);
+	void writeImpl(const std::string& text, bool flush);
+	void flushImpl();
 	UInt64 sizeImpl() const;
 	Timestamp creationDateImpl() const;
 	const std::string& pathImpl() const;
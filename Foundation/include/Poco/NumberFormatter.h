@@ -56,8 +56,9 @@ class Foundation_API NumberFormatter
 	///    * append* functions append the formatted value to
 	///      an existing string.
 	///
-	/// Internally, std::sprintf() is used to do the actual
-	/// formatting.
+	/// Integer values are formatted directly, two digits
+	/// at a time, using a lookup table. Floating-point values
+	/// are formatted with std::sprintf().
 {
 public:
 	static std::string format(int value);
@@ -211,6 +212,13 @@ public:
 		/// right justified in a field of the specified width,
 		/// with the number of fractional digits given in precision.
 
+	static std::string formatShortest(double value);
+		/// Formats a double value in decimal floating-point notation,
+		/// using the smallest number of significant digits (at most 17)
+		/// that NumberParser::parseFloat() will convert back to exactly
+		/// the same value. The decimal point is always '.', regardless
+		/// of the current C locale.
+
 	static std::string format(const void* ptr);
 		/// Formats a pointer in an eight (32-bit architectures) or
 		/// sixteen (64-bit architectures) characters wide
@@ -367,6 +375,13 @@ public:
 		/// right justified in a field of the specified width,
 		/// with the number of fractional digits given in precision.
 
+	static void appendShortest(std::string& str, double value);
+		/// Formats a double value in decimal floating-point notation,
+		/// using the smallest number of significant digits (at most 17)
+		/// that NumberParser::parseFloat() will convert back to exactly
+		/// the same value. The decimal point is always '.', regardless
+		/// of the current C locale.
+
 	static void append(std::string& str, const void* ptr);
 		/// Formats a pointer in an eight (32-bit architectures) or
 		/// sixteen (64-bit architectures) characters wide
@@ -655,6 +670,14 @@ inline std::string NumberFormatter::format(double value, int width, int precisio
 }
 
 
+inline std::string NumberFormatter::formatShortest(double value)
+{
+	std::string result;
+	appendShortest(result, value);
+	return result;
+}
+
+
 inline std::string NumberFormatter::format(const void* ptr)
 {
 	std::string result;
@@ -49,6 +49,15 @@ namespace Poco {
 class Foundation_API NumberParser
 	/// The NumberParser class provides static methods
 	/// for parsing numbers out of strings.
+	///
+	/// Leading whitespace is skipped, but the rest of the
+	/// string must consist of the number only. Values that
+	/// do not fit into the result type are rejected. Hexadecimal
+	/// numbers may have a 0x or 0X prefix.
+	///
+	/// The tryParse* functions are also available for character
+	/// ranges, so that numbers can be parsed out of a larger
+	/// buffer without creating a temporary std::string.
 {
 public:
 	static int parse(const std::string& s);
@@ -58,6 +67,10 @@ public:
 	static bool tryParse(const std::string& s, int& value);
 		/// Parses an integer value in decimal notation from the given string.
 		/// Returns true if a valid integer has been found, false otherwise. 
+
+	static bool tryParse(const char* begin, const char* end, int& value);
+		/// Parses the characters in the range [begin, end),
+		/// otherwise the same as tryParse(const std::string&, int&).
 	
 	static unsigned parseUnsigned(const std::string& s);
 		/// Parses an unsigned integer value in decimal notation from the given string.
@@ -67,6 +80,10 @@ public:
 		/// Parses an unsigned integer value in decimal notation from the given string.
 		/// Returns true if a valid integer has been found, false otherwise. 
 
+	static bool tryParseUnsigned(const char* begin, const char* end, unsigned& value);
+		/// Parses the characters in the range [begin, end),
+		/// otherwise the same as tryParseUnsigned(const std::string&, unsigned&).
+
 	static unsigned parseHex(const std::string& s);
 		/// Parses an integer value in hexadecimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in
@@ -76,6 +93,10 @@ public:
 		/// Parses an unsigned integer value in hexadecimal notation from the given string.
 		/// Returns true if a valid integer has been found, false otherwise. 
 
+	static bool tryParseHex(const char* begin, const char* end, unsigned& value);
+		/// Parses the characters in the range [begin, end),
+		/// otherwise the same as tryParseHex(const std::string&, unsigned&).
+
 #if defined(POCO_HAVE_INT64)
 
 	static Int64 parse64(const std::string& s);
@@ -86,6 +107,10 @@ public:
 		/// Parses a 64-bit integer value in decimal notation from the given string.
 		/// Returns true if a valid integer has been found, false otherwise. 
 
+	static bool tryParse64(const char* begin, const char* end, Int64& value);
+		/// Parses the characters in the range [begin, end),
+		/// otherwise the same as tryParse64(const std::string&, Int64&).
+
 	static UInt64 parseUnsigned64(const std::string& s);
 		/// Parses an unsigned 64-bit integer value in decimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in decimal notation.
@@ -94,6 +119,10 @@ public:
 		/// Parses an unsigned 64-bit integer value in decimal notation from the given string.
 		/// Returns true if a valid integer has been found, false otherwise. 
 
+	static bool tryParseUnsigned64(const char* begin, const char* end, UInt64& value);
+		/// Parses the characters in the range [begin, end),
+		/// otherwise the same as tryParseUnsigned64(const std::string&, UInt64&).
+
 	static UInt64 parseHex64(const std::string& s);
 		/// Parses a 64 bit-integer value in hexadecimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in hexadecimal notation.
@@ -102,6 +131,10 @@ public:
 		/// Parses an unsigned 64-bit integer value in hexadecimal notation from the given string.
 		/// Returns true if a valid integer has been found, false otherwise. 
 
+	static bool tryParseHex64(const char* begin, const char* end, UInt64& value);
+		/// Parses the characters in the range [begin, end),
+		/// otherwise the same as tryParseHex64(const std::string&, UInt64&).
+
 #endif // defined(POCO_HAVE_INT64)
 
 	static double parseFloat(const std::string& s);
@@ -115,6 +148,10 @@ public:
 		/// from the given string. 
 		/// Returns true if a valid floating point number has been found, 
 		/// false otherwise. 
+
+	static bool tryParseFloat(const char* begin, const char* end, double& value);
+		/// Parses the characters in the range [begin, end),
+		/// otherwise the same as tryParseFloat(const std::string&, double&).
 };
 
 
@@ -43,6 +43,10 @@
 #include "Poco/Foundation.h"
 #include "Poco/Formatter.h"
 #include "Poco/Message.h"
+#include "Poco/Mutex.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+#include <ctime>
 
 
 namespace Poco {
@@ -93,6 +97,13 @@ class Foundation_API PatternFormatter: public Formatter
 	///   * %E - epoch time (UTC, seconds since midnight, January 1, 1970)
 	///   * %[name] - the value of the message parameter with the given name
 	///   * %% - percent sign
+	///
+	/// The pattern is compiled into a list of actions when it is set,
+	/// so format() does not have to parse it for every message.
+	/// The date/time fields are computed once per second and shared
+	/// by all messages within that second. If times are local, the
+	/// time zone differential is determined at most once every
+	/// TZ_REFRESH_INTERVAL seconds.
 
 {
 public:
@@ -133,13 +144,66 @@ public:
 	static const std::string PROP_PATTERN;
 	static const std::string PROP_TIMES;
 
+	enum
+	{
+		TZ_REFRESH_INTERVAL = 60
+			/// Seconds after which the cached time zone differential
+			/// is determined again.
+	};
+
 protected:
 	static const std::string& getPriorityName(int);
 		/// Returns a string for the given priority value.
 	
+	void parsePattern();
+		/// Compiles the format pattern into a list of actions.
+
 private:
-	bool        _localTime;
-	std::string _pattern;
+	struct PatternAction
+	{
+		PatternAction(): key(0)
+		{
+		}
+
+		char        key;      // the pattern character after '%', or 0 if only text is prepended
+		std::string prepend;  // literal text preceding the replacement
+		std::string property; // parameter name for %[name], node name for %N
+	};
+
+	struct CachedTime
+		/// The broken-down date/time of a single second.
+	{
+		std::time_t second;   // UTC epoch time the fields were computed for
+		int year;
+		int month;
+		int day;
+		int dayOfWeek;
+		int hour;
+		int minute;
+		int sec;
+		int tzd;
+		std::time_t tzdUpdated;
+		bool valid;
+	};
+
+	void cachedTime(const Timestamp& timestamp, CachedTime& time);
+		/// Returns the broken-down date/time for the given timestamp,
+		/// updating the cache if the second has changed.
+
+	bool readCachedTime(std::time_t second, CachedTime& time) const;
+		/// Copies the cached date/time without taking the mutex.
+		/// Returns false if the cache does not hold the given second,
+		/// or is being updated.
+
+	typedef std::vector<PatternAction> PatternActions;
+
+	bool           _localTime;
+	std::string    _pattern;
+	PatternActions _patternActions;
+	bool           _needsTime;
+	CachedTime     _cachedTime;
+	volatile unsigned _sequence; // odd while _cachedTime is being updated
+	FastMutex      _mutex;
 };
 
 
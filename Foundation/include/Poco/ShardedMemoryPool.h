@@ -0,0 +1,183 @@
+//
+// ShardedMemoryPool.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/ShardedMemoryPool.h#1 $
+//
+// Library: Foundation
+// Package: Core
+// Module:  ShardedMemoryPool
+//
+// Definition of the ShardedMemoryPool class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_ShardedMemoryPool_INCLUDED
+#define Foundation_ShardedMemoryPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Mutex.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API ShardedMemoryPool
+	/// A pool for fixed-size memory blocks that scales
+	/// with the number of threads using it.
+	///
+	/// ShardedMemoryPool has the same interface as MemoryPool,
+	/// but instead of a single block list protected by a single
+	/// mutex, it has a number of shards, each with its own small
+	/// cache of blocks (a "magazine") and its own mutex.
+	/// Every Poco::Thread always uses the same shard, which is
+	/// selected by its thread ID, so that with enough shards,
+	/// threads hardly ever compete for a mutex. Threads not created
+	/// by Poco::Thread (e.g., the main thread) share the first shard.
+	///
+	/// Shards exchange blocks with a global depot in batches
+	/// of BATCH_SIZE blocks, so the depot's mutex is only taken
+	/// once for every BATCH_SIZE calls to get() or release(),
+	/// and never while a new block is allocated. (A lock-free
+	/// depot would have to be a stack of batches that is safe
+	/// against the ABA problem, which needs a double-width
+	/// compare-and-swap or tagged pointers that are not
+	/// portably available.)
+	///
+	/// A limit on the number of blocks can be specified.
+	/// Blocks can be preallocated; preallocated blocks
+	/// are kept in the depot.
+{
+public:
+	enum
+	{
+		BATCH_SIZE = 16
+			/// Number of blocks moved between a shard and
+			/// the depot at once. A shard caches at most
+			/// 2*BATCH_SIZE blocks.
+	};
+
+	ShardedMemoryPool(std::size_t blockSize, int preAlloc = 0, int maxAlloc = 0, int shards = 0);
+		/// Creates a ShardedMemoryPool for blocks with the given blockSize.
+		/// The number of blocks given in preAlloc are preallocated.
+		///
+		/// If shards is 0, twice the number of processors
+		/// (see Environment::processorCount()) are used.
+
+	~ShardedMemoryPool();
+		/// Destroys the ShardedMemoryPool and frees all blocks
+		/// in the pool.
+
+	void* get();
+		/// Returns a memory block. If there are no more blocks
+		/// in the pool, a new block will be allocated.
+		///
+		/// If maxAlloc blocks are already allocated, blocks cached
+		/// by other shards are used. If there are none either, an
+		/// OutOfMemoryException is thrown.
+
+	void release(void* ptr);
+		/// Releases a memory block and returns it to the pool.
+
+	std::size_t blockSize() const;
+		/// Returns the block size.
+
+	int allocated() const;
+		/// Returns the number of allocated blocks.
+
+	int available() const;
+		/// Returns the number of available blocks in the pool,
+		/// including the blocks cached by all shards.
+
+	int shards() const;
+		/// Returns the number of shards.
+
+private:
+	ShardedMemoryPool();
+	ShardedMemoryPool(const ShardedMemoryPool&);
+	ShardedMemoryPool& operator = (const ShardedMemoryPool&);
+
+	typedef std::vector<char*> BlockVec;
+
+	struct Shard
+	{
+		enum
+		{
+			CACHE_LINE_SIZE = 64
+		};
+
+		FastMutex mutex;
+		BlockVec  blocks;
+		char      padding[CACHE_LINE_SIZE];
+			/// keeps the mutexes of adjacent shards
+			/// out of the same cache line
+	};
+
+	Shard& shard();
+	char* refill(Shard& shard);
+	void drain(Shard& shard);
+	char* steal(const Shard& except);
+
+	std::size_t _blockSize;
+	int         _maxAlloc;
+	AtomicCounter _allocated;
+	int         _nShards;
+	Shard*      _shards;
+	BlockVec    _depot;
+	mutable FastMutex _depotMutex;
+};
+
+
+//
+// inlines
+//
+inline std::size_t ShardedMemoryPool::blockSize() const
+{
+	return _blockSize;
+}
+
+
+inline int ShardedMemoryPool::allocated() const
+{
+	return _allocated.value();
+}
+
+
+inline int ShardedMemoryPool::shards() const
+{
+	return _nShards;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ShardedMemoryPool_INCLUDED
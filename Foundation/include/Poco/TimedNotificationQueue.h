@@ -45,7 +45,9 @@
 #include "Poco/Mutex.h"
 #include "Poco/Event.h"
 #include "Poco/Timestamp.h"
+#include "Poco/TimingWheel.h"
 #include <map>
+#include <deque>
 
 
 namespace Poco {
@@ -71,11 +73,25 @@ class Foundation_API TimedNotificationQueue
 	///
 	/// If two threads try to dequeue a notification simultaneously, the results
 	/// are undefined.
+	///
+	/// By default, the notifications are kept in a std::multimap,
+	/// so that enqueueing and dequeueing a notification takes
+	/// O(log n) time. Alternatively, a TimingWheel with a given
+	/// resolution can be used, which makes both operations O(1).
+	/// Timestamps are then rounded up to the resolution of the
+	/// wheel, and notifications with timestamps rounded to the
+	/// same value are dequeued in no particular order. Notifications
+	/// with a zero timestamp are still dequeued before all others,
+	/// in the order they were enqueued.
 {
 public:
 	TimedNotificationQueue();
 		/// Creates the TimedNotificationQueue.
 
+	explicit TimedNotificationQueue(Timestamp::TimeDiff resolution);
+		/// Creates the TimedNotificationQueue, keeping the notifications
+		/// in a TimingWheel with the given resolution in microseconds.
+
 	~TimedNotificationQueue();
 		/// Destroys the TimedNotificationQueue.
 
@@ -141,8 +157,25 @@ protected:
 	bool wait(Timestamp::TimeDiff interval);
 	
 private:
-	NfQueue _nfQueue;
-	Event   _nfAvailable;
+	struct WheelEntry: public TimingWheel::Entry
+	{
+		Notification::Ptr pNf;
+	};
+	typedef std::deque<Notification::Ptr> ReadyQueue;
+
+	Notification::Ptr dequeueDue(Timestamp::TimeDiff& sleep);
+		/// Dequeues the next due notification from the TimingWheel.
+		/// If there is none, returns null and stores the time until the
+		/// next notification may become due in sleep, or -1 if the
+		/// queue is empty.
+
+	void clearWheel();
+
+	NfQueue      _nfQueue;
+	TimingWheel* _pWheel;
+	ReadyQueue   _ready;
+	std::size_t  _urgent; // number of zero timestamp notifications at the front of _ready
+	Event        _nfAvailable;
 	mutable FastMutex _mutex;
 };
 
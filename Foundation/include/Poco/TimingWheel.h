@@ -0,0 +1,237 @@
+//
+// TimingWheel.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/TimingWheel.h#1 $
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  TimingWheel
+//
+// Definition of the TimingWheel class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_TimingWheel_INCLUDED
+#define Foundation_TimingWheel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Timestamp.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API TimingWheel
+	/// A TimingWheel keeps track of a large number of timeouts,
+	/// for example, one per network connection.
+	///
+	/// Time is divided into ticks of a fixed length (the resolution
+	/// of the wheel, by default one millisecond). Timeouts are kept
+	/// in a hierarchy of five wheels of slots, with each slot holding
+	/// a list of timeouts. The first wheel has one slot per tick for
+	/// the next 256 ticks; each of the following four wheels has 64
+	/// slots, each covering 64 times as many ticks as a slot in the
+	/// wheel before. As time advances, the timeouts in the slots of
+	/// the outer wheels are distributed to the inner wheels
+	/// ("cascading"), until they finally expire.
+	///
+	/// Scheduling and cancelling a timeout takes constant time,
+	/// independently of the number of timeouts. No memory is
+	/// allocated, as the timeouts (instances of subclasses of
+	/// TimingWheel::Entry) are linked into the slots directly.
+	///
+	/// A timeout never expires before its scheduled time, but
+	/// up to one tick later. Timeouts expiring in the same tick
+	/// are returned in no particular order.
+	///
+	/// TimingWheel is not thread-safe.
+{
+public:
+	class Foundation_API Entry
+		/// A timeout managed by a TimingWheel.
+		///
+		/// Subclass this to attach data to a timeout.
+		/// An Entry must not be scheduled with more than
+		/// one TimingWheel at a time.
+	{
+	public:
+		Entry();
+			/// Creates the Entry.
+
+		virtual ~Entry();
+			/// Destroys the Entry, cancelling it if it is scheduled.
+
+		bool isScheduled() const;
+			/// Returns true iff the Entry is scheduled with a TimingWheel.
+
+		const Timestamp& time() const;
+			/// Returns the time the Entry has last been scheduled for.
+
+	private:
+		Entry(const Entry&);
+		Entry& operator = (const Entry&);
+
+		TimingWheel* _pWheel;
+		Entry*       _pPrev;
+		Entry*       _pNext;
+		Entry**      _pSlot;
+		Int64        _tick;
+		Timestamp    _time;
+
+		friend class TimingWheel;
+	};
+
+	typedef std::vector<Entry*> EntryVec;
+
+	enum
+	{
+		DEFAULT_RESOLUTION = 1000 /// one millisecond
+	};
+
+	explicit TimingWheel(Timestamp::TimeDiff resolution = DEFAULT_RESOLUTION);
+		/// Creates the TimingWheel, using the given resolution
+		/// (length of a tick) in microseconds.
+		
+	~TimingWheel();
+		/// Destroys the TimingWheel. All scheduled
+		/// entries are cancelled.
+
+	void schedule(Entry& entry, const Timestamp& time);
+		/// Schedules the entry to expire at the given time.
+		///
+		/// If the entry is already scheduled, it is rescheduled.
+		/// If the time lies in the past, the entry expires with
+		/// the next tick.
+
+	void cancel(Entry& entry);
+		/// Cancels the entry. Does nothing if the entry
+		/// is not scheduled.
+
+	std::size_t advance(const Timestamp& now, EntryVec& expired);
+		/// Advances the wheel to the given time and appends all entries
+		/// that have expired up to then to expired. Expired entries are
+		/// no longer scheduled and may be rescheduled.
+		///
+		/// Returns the number of expired entries.
+
+	bool nextExpiration(Timestamp& time) const;
+		/// Stores the time up to which advance() will not
+		/// return any entries in time, and returns true. 
+		/// Returns false if no entries are scheduled.
+		///
+		/// The time returned may be earlier than the time the
+		/// first entry actually expires, if the entry still has
+		/// to be cascaded to an inner wheel.
+
+	void clear();
+		/// Cancels all entries.
+
+	void clear(EntryVec& cancelled);
+		/// Cancels all entries and appends them to cancelled,
+		/// e.g., for deleting them.
+
+	std::size_t size() const;
+		/// Returns the number of scheduled entries.
+
+	bool empty() const;
+		/// Returns true iff no entries are scheduled.
+
+	Timestamp::TimeDiff resolution() const;
+		/// Returns the resolution of the wheel in microseconds.
+
+private:
+	TimingWheel(const TimingWheel&);
+	TimingWheel& operator = (const TimingWheel&);
+
+	enum
+	{
+		ROOT_BITS  = 8,
+		ROOT_SIZE  = 1 << ROOT_BITS,
+		ROOT_MASK  = ROOT_SIZE - 1,
+		LEVEL_BITS = 6,
+		LEVEL_SIZE = 1 << LEVEL_BITS,
+		LEVEL_MASK = LEVEL_SIZE - 1,
+		LEVELS     = 4,
+		SLOTS      = ROOT_SIZE + LEVELS*LEVEL_SIZE
+	};
+
+	Int64 nextTick() const;
+	Int64 tickOf(const Timestamp& time) const;
+	Timestamp timeOf(Int64 tick) const;
+	void insert(Entry& entry);
+	void unlink(Entry& entry);
+	void cascade(Int64 tick);
+
+	Timestamp           _start;
+	Timestamp::TimeDiff _resolution;
+	Int64               _current;
+	std::size_t         _size;
+	Entry*              _slots[SLOTS];
+};
+
+
+//
+// inlines
+//
+inline bool TimingWheel::Entry::isScheduled() const
+{
+	return _pWheel != 0;
+}
+
+
+inline const Timestamp& TimingWheel::Entry::time() const
+{
+	return _time;
+}
+
+
+inline std::size_t TimingWheel::size() const
+{
+	return _size;
+}
+
+
+inline bool TimingWheel::empty() const
+{
+	return _size == 0;
+}
+
+
+inline Timestamp::TimeDiff TimingWheel::resolution() const
+{
+	return _resolution;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_TimingWheel_INCLUDED
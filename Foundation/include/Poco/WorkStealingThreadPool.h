@@ -0,0 +1,220 @@
+//
+// WorkStealingThreadPool.h
+//
+// $Id: //poco/1.4/Foundation/include/Poco/WorkStealingThreadPool.h#1 $
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingThreadPool
+//
+// Definition of the WorkStealingThreadPool class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Foundation_WorkStealingThreadPool_INCLUDED
+#define Foundation_WorkStealingThreadPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/RWLock.h"
+#include "Poco/Event.h"
+#include "Poco/Semaphore.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+#include <deque>
+
+
+namespace Poco {
+
+
+class Runnable;
+class WorkStealingWorker;
+
+
+class Foundation_API WorkStealingThreadPool
+	/// A WorkStealingThreadPool runs Runnable objects on a fixed
+	/// number of worker threads.
+	///
+	/// In contrast to ThreadPool, start() never has to wait for,
+	/// or fail because of, a busy pool. Runnables are queued, and
+	/// run as soon as a worker thread becomes available.
+	/// This makes the class well-suited for large numbers of
+	/// short tasks.
+	///
+	/// Every worker thread has its own task deque. A Runnable
+	/// started from within a worker thread is pushed to that
+	/// worker's deque, which the worker processes in LIFO order.
+	/// Runnables started from other threads are added to a
+	/// shared submission queue. A worker that has run out of work
+	/// takes a Runnable from the submission queue or, if that is
+	/// empty, steals the oldest Runnable from another worker's deque.
+	/// Idle workers are parked, and only woken up if
+	/// there is new work for them.
+	///
+	/// Runnables should not block for a long time, since the
+	/// number of worker threads is fixed. For long-running
+	/// activities, ThreadPool should be used instead.
+{
+public:
+	WorkStealingThreadPool(int threads = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a WorkStealingThreadPool with the given
+		/// number of worker threads.
+		///
+		/// If threads is 0, one worker thread per processor
+		/// (see Environment::processorCount()) is created.
+
+	WorkStealingThreadPool(const std::string& name, int threads = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a WorkStealingThreadPool with the given name
+		/// and number of worker threads.
+		///
+		/// The name is used to name the worker threads.
+
+	~WorkStealingThreadPool();
+		/// Stops the worker threads (see stopAll())
+		/// and destroys the WorkStealingThreadPool.
+
+	void start(Runnable& target);
+		/// Queues the given Runnable for execution by
+		/// one of the worker threads.
+		///
+		/// The Runnable object must remain valid until
+		/// its run() member function has returned.
+		///
+		/// Throws an IllegalStateException if the pool
+		/// has been stopped.
+
+	void joinAll();
+		/// Waits until all Runnables started so far
+		/// (and the ones they have started) have completed.
+
+	void stopAll();
+		/// Waits until all queued Runnables have completed,
+		/// then stops and joins all worker threads.
+		///
+		/// The pool cannot be used anymore afterwards.
+
+	int threads() const;
+		/// Returns the number of worker threads.
+
+	int pending() const;
+		/// Returns the number of Runnables that have been
+		/// queued, but not yet started.
+
+	const std::string& name() const;
+		/// Returns the name of the pool.
+
+	static WorkStealingThreadPool& defaultPool();
+		/// Returns a reference to the default
+		/// WorkStealingThreadPool.
+
+protected:
+	void work(int index);
+		/// Runs the main loop of the worker thread
+		/// with the given index.
+
+	Runnable* steal(int index);
+		/// Tries to steal a Runnable from a worker other
+		/// than the one with the given index.
+
+	Runnable* dequeue();
+		/// Takes the first Runnable from the submission queue.
+
+	bool park();
+		/// Parks the calling worker thread until new work
+		/// is available. Returns false if the pool has been
+		/// stopped and the worker should exit.
+
+	void wakeUpOne();
+		/// Wakes up one parked worker thread, if there is one.
+
+	void runTarget(Runnable* pTarget);
+		/// Runs the given Runnable and does the bookkeeping
+		/// for joinAll().
+
+	WorkStealingWorker* currentWorker() const;
+		/// Returns the worker running in the calling
+		/// thread, or null if the calling thread is not
+		/// a worker thread of this pool.
+
+private:
+	WorkStealingThreadPool(const WorkStealingThreadPool&);
+	WorkStealingThreadPool& operator = (const WorkStealingThreadPool&);
+
+	void init(int threads, int stackSize);
+
+	typedef std::vector<WorkStealingWorker*> WorkerVec;
+	typedef std::deque<Runnable*> TaskQueue;
+
+	std::string   _name;
+	WorkerVec     _workers;
+	WorkerVec     _workersById;
+	int           _firstThreadId;
+	TaskQueue     _queue;
+	FastMutex     _queueMutex;
+	AtomicCounter _pending;
+	AtomicCounter _outstanding;
+	AtomicCounter _idle;
+	FastMutex     _idleMutex;
+	Semaphore     _workAvailable;
+	Event         _allDone;
+	FastMutex     _doneMutex;
+	volatile bool _stopped;
+	RWLock        _stateLock;
+	FastMutex     _stopMutex;
+
+	friend class WorkStealingWorker;
+};
+
+
+//
+// inlines
+//
+inline int WorkStealingThreadPool::threads() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+
+inline int WorkStealingThreadPool::pending() const
+{
+	return _pending.value();
+}
+
+
+inline const std::string& WorkStealingThreadPool::name() const
+{
+	return _name;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_WorkStealingThreadPool_INCLUDED
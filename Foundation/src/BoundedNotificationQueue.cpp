@@ -0,0 +1,636 @@
+//
+// BoundedNotificationQueue.cpp
+//
+// $Id: //poco/1.4/Foundation/src/BoundedNotificationQueue.cpp#1 $
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/NotificationCenter.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Thread.h"
+#include <limits>
+
+
+namespace Poco {
+
+
+void BoundedNotificationQueue::enqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+	enqueue(pNotification.duplicate(), false);
+}
+
+
+void BoundedNotificationQueue::enqueueUrgentNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+	enqueue(pNotification.duplicate(), true);
+}
+
+
+void BoundedNotificationQueue::dispatch(NotificationCenter& notificationCenter)
+{
+	Notification::Ptr pNf = dequeueNotification();
+	while (pNf)
+	{
+		notificationCenter.postNotification(pNf);
+		pNf = dequeueNotification();
+	}
+}
+
+
+#if defined(POCO_HAVE_GCC_ATOMICS)
+
+
+//
+// The ring buffer is a bounded MPMC queue after Dmitry Vyukov. Every
+// cell has a sequence number. The cell for position pos can be written
+// if its sequence number equals pos, and read if it equals pos + 1.
+// Producers and consumers claim positions by advancing _enqueuePos or
+// _dequeuePos with compare-and-swap. After reading a cell, its sequence
+// number is advanced by the ring size, so the cell becomes available
+// to the producer of the next round.
+//
+// Before writing to the ring (or to the list of urgent notifications),
+// a producer reserves room by incrementing _count, which never exceeds
+// _capacity. The ring is at least as large as the capacity, so a producer
+// that has reserved room only finds its cell still in use if the
+// consumer of the previous round has claimed, but not yet released it.
+//
+// Waiting follows the same protocol as the mutex-based implementation
+// below. A thread registers itself in _waitingConsumers or
+// _waitingProducers and checks again. A thread that makes progress
+// possible claims one registered waiter and signals the semaphore once.
+// A registered thread that does not wait after all, or times out, must
+// either unregister itself or, if it has been claimed, consume the signal.
+// The upper bits of _waitingConsumers hold the wake-up generation, so that
+// registering and reading the generation is a single atomic operation.
+//
+
+
+namespace
+{
+	const unsigned WAITING_MASK     = 0xFFFF;
+	const unsigned GENERATION_SHIFT = 16;
+}
+
+
+BoundedNotificationQueue::BoundedNotificationQueue(int capacity):
+	_pCells(0),
+	_mask(0),
+	_capacity(capacity),
+	_enqueuePos(0),
+	_dequeuePos(0),
+	_count(0),
+	_urgentCount(0),
+	_waitingConsumers(0),
+	_waitingProducers(0),
+	_nfAvailable(0, std::numeric_limits<int>::max()),
+	_spaceAvailable(0, std::numeric_limits<int>::max())
+{
+	poco_assert (capacity > 0);
+
+	std::size_t size = 1;
+	while (size < static_cast<std::size_t>(capacity)) size <<= 1;
+	_pCells = new Cell[size];
+	_mask = size - 1;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		_pCells[i].sequence = i;
+		_pCells[i].pNotification = 0;
+	}
+	_urgent.reserve(capacity);
+}
+
+
+BoundedNotificationQueue::~BoundedNotificationQueue()
+{
+	clear();
+	delete [] _pCells;
+}
+
+
+Notification* BoundedNotificationQueue::dequeueNotification()
+{
+	return dequeueOne();
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification()
+{
+	for (;;)
+	{
+		Notification* pNf = dequeueOne();
+		if (pNf) return pNf;
+		unsigned generation = __sync_add_and_fetch(&_waitingConsumers, 1) >> GENERATION_SHIFT;
+		pNf = dequeueOne();
+		if (pNf)
+		{
+			unregisterWaiter(_waitingConsumers, _nfAvailable);
+			return pNf;
+		}
+		_nfAvailable.wait();
+		if (generation != (_waitingConsumers >> GENERATION_SHIFT)) return 0;
+	}
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification(long milliseconds)
+{
+	Timestamp start;
+	for (;;)
+	{
+		Notification* pNf = dequeueOne();
+		if (pNf) return pNf;
+		long remaining = milliseconds - static_cast<long>(start.elapsed()/1000);
+		if (remaining <= 0) return 0;
+		unsigned generation = __sync_add_and_fetch(&_waitingConsumers, 1) >> GENERATION_SHIFT;
+		pNf = dequeueOne();
+		if (pNf)
+		{
+			unregisterWaiter(_waitingConsumers, _nfAvailable);
+			return pNf;
+		}
+		if (_nfAvailable.tryWait(remaining))
+		{
+			if (generation != (_waitingConsumers >> GENERATION_SHIFT)) return 0;
+		}
+		else unregisterWaiter(_waitingConsumers, _nfAvailable);
+	}
+}
+
+
+void BoundedNotificationQueue::wakeUpAll()
+{
+	unsigned state;
+	do
+	{
+		state = _waitingConsumers;
+	}
+	while (!__sync_bool_compare_and_swap(&_waitingConsumers, state, (state & ~WAITING_MASK) + (1 << GENERATION_SHIFT)));
+
+	for (unsigned i = 0; i < (state & WAITING_MASK); ++i)
+	{
+		_nfAvailable.set();
+	}
+}
+
+
+bool BoundedNotificationQueue::empty() const
+{
+	return _count == 0;
+}
+
+
+int BoundedNotificationQueue::size() const
+{
+	return _count;
+}
+
+
+void BoundedNotificationQueue::clear()
+{
+	Notification* pNf = dequeueOne();
+	while (pNf)
+	{
+		pNf->release();
+		pNf = dequeueOne();
+	}
+}
+
+
+bool BoundedNotificationQueue::hasIdleThreads() const
+{
+	return (_waitingConsumers & WAITING_MASK) > 0;
+}
+
+
+void BoundedNotificationQueue::enqueue(Notification* pNotification, bool urgent)
+{
+	for (;;)
+	{
+		int count = _count;
+		if (count < _capacity)
+		{
+			if (__sync_bool_compare_and_swap(&_count, count, count + 1)) break;
+		}
+		else
+		{
+			__sync_add_and_fetch(&_waitingProducers, 1);
+			if (_count < _capacity)
+				unregisterWaiter(_waitingProducers, _spaceAvailable);
+			else
+				_spaceAvailable.wait();
+		}
+	}
+	if (urgent)
+	{
+		FastMutex::ScopedLock lock(_urgentMutex);
+		_urgent.push_back(pNotification);
+		__sync_add_and_fetch(&_urgentCount, 1);
+	}
+	else push(pNotification);
+
+	// make the notification visible before looking for a waiting consumer
+	__sync_synchronize();
+	if (claimWaiter(_waitingConsumers)) _nfAvailable.set();
+}
+
+
+void BoundedNotificationQueue::push(Notification* pNotification)
+{
+	std::size_t pos = _enqueuePos;
+	for (;;)
+	{
+		Cell& cell = _pCells[pos & _mask];
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(cell.sequence - pos);
+		if (diff == 0)
+		{
+			// order the sequence load before the accesses to the cell
+			__sync_synchronize();
+			if (__sync_bool_compare_and_swap(&_enqueuePos, pos, pos + 1))
+			{
+				cell.pNotification = pNotification;
+				// publish the notification before the sequence number
+				__sync_synchronize();
+				cell.sequence = pos + 1;
+				return;
+			}
+		}
+		else if (diff < 0)
+		{
+			// The consumer of the previous round has not released the cell yet.
+			Thread::yield();
+		}
+		pos = _enqueuePos;
+	}
+}
+
+
+Notification* BoundedNotificationQueue::pop()
+{
+	std::size_t pos = _dequeuePos;
+	for (;;)
+	{
+		Cell& cell = _pCells[pos & _mask];
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(cell.sequence - (pos + 1));
+		if (diff == 0)
+		{
+			// order the sequence load before the accesses to the cell
+			__sync_synchronize();
+			if (__sync_bool_compare_and_swap(&_dequeuePos, pos, pos + 1))
+			{
+				Notification* pNf = cell.pNotification;
+				cell.pNotification = 0;
+				// release the cell only after it has been read
+				__sync_synchronize();
+				cell.sequence = pos + _mask + 1;
+				return pNf;
+			}
+		}
+		else if (diff < 0)
+		{
+			// The ring is empty, or the producer has not finished writing
+			// the cell yet. In the latter case, the producer will wake us
+			// up if necessary.
+			return 0;
+		}
+		pos = _dequeuePos;
+	}
+}
+
+
+Notification* BoundedNotificationQueue::dequeueOne()
+{
+	Notification* pNf = 0;
+	if (_urgentCount > 0)
+	{
+		FastMutex::ScopedLock lock(_urgentMutex);
+		if (!_urgent.empty())
+		{
+			pNf = _urgent.back();
+			_urgent.pop_back();
+			__sync_sub_and_fetch(&_urgentCount, 1);
+		}
+	}
+	if (!pNf) pNf = pop();
+	if (pNf)
+	{
+		__sync_sub_and_fetch(&_count, 1);
+		if (claimWaiter(_waitingProducers)) _spaceAvailable.set();
+	}
+	return pNf;
+}
+
+
+bool BoundedNotificationQueue::claimWaiter(volatile unsigned& waiting)
+{
+	unsigned state = waiting;
+	while ((state & WAITING_MASK) > 0)
+	{
+		if (__sync_bool_compare_and_swap(&waiting, state, state - 1)) return true;
+		state = waiting;
+	}
+	return false;
+}
+
+
+void BoundedNotificationQueue::unregisterWaiter(volatile unsigned& waiting, Semaphore& sem)
+{
+	unsigned state = waiting;
+	for (;;)
+	{
+		if ((state & WAITING_MASK) == 0)
+		{
+			// We have been claimed by another thread, which is
+			// about to signal the semaphore (or has already done so).
+			sem.wait();
+			return;
+		}
+		if (__sync_bool_compare_and_swap(&waiting, state, state - 1)) return;
+		state = waiting;
+	}
+}
+
+
+#else
+
+
+//
+// Every thread that has to wait (on _nfAvailable or _spaceAvailable)
+// registers itself in _waitingConsumers or _waitingProducers before
+// releasing the mutex. A thread that makes progress possible for a
+// waiting thread unregisters one waiting thread and signals the
+// semaphore once, after releasing the mutex. Therefore the semaphore's
+// count never exceeds the number of threads that are about to wake up,
+// and a thread that times out while waiting must either unregister
+// itself or, if it has already been unregistered, consume its signal.
+//
+
+
+BoundedNotificationQueue::BoundedNotificationQueue(int capacity):
+	_ring(capacity),
+	_capacity(capacity),
+	_head(0),
+	_count(0),
+	_waitingConsumers(0),
+	_waitingProducers(0),
+	_generation(0),
+	_nfAvailable(0, std::numeric_limits<int>::max()),
+	_spaceAvailable(0, std::numeric_limits<int>::max())
+{
+	poco_assert (capacity > 0);
+}
+
+
+BoundedNotificationQueue::~BoundedNotificationQueue()
+{
+	clear();
+}
+
+
+Notification* BoundedNotificationQueue::dequeueNotification()
+{
+	bool wakeProducer = false;
+	Notification* pNf;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		pNf = dequeueOne(wakeProducer);
+	}
+	if (wakeProducer) _spaceAvailable.set();
+	return pNf;
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification()
+{
+	bool waited = false;
+	int generation = 0;
+	for (;;)
+	{
+		bool wakeProducer = false;
+		Notification* pNf;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (waited && generation != _generation) return 0;
+			pNf = dequeueOne(wakeProducer);
+			if (!pNf)
+			{
+				++_waitingConsumers;
+				generation = _generation;
+			}
+		}
+		if (pNf)
+		{
+			if (wakeProducer) _spaceAvailable.set();
+			return pNf;
+		}
+		_nfAvailable.wait();
+		waited = true;
+	}
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification(long milliseconds)
+{
+	Timestamp start;
+	bool waited = false;
+	int generation = 0;
+	for (;;)
+	{
+		bool wakeProducer = false;
+		Notification* pNf;
+		long remaining = milliseconds - static_cast<long>(start.elapsed()/1000);
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (waited && generation != _generation) return 0;
+			pNf = dequeueOne(wakeProducer);
+			if (!pNf)
+			{
+				if (remaining <= 0) return 0;
+				++_waitingConsumers;
+				generation = _generation;
+			}
+		}
+		if (pNf)
+		{
+			if (wakeProducer) _spaceAvailable.set();
+			return pNf;
+		}
+		if (!_nfAvailable.tryWait(remaining))
+		{
+			bool signalled = false;
+			{
+				FastMutex::ScopedLock lock(_mutex);
+				if (_waitingConsumers > 0)
+					--_waitingConsumers;
+				else
+					signalled = true;
+			}
+			// We have been unregistered by another thread, which is
+			// about to signal the semaphore (or has already done so).
+			if (signalled) _nfAvailable.wait();
+		}
+		waited = true;
+	}
+}
+
+
+void BoundedNotificationQueue::wakeUpAll()
+{
+	int n;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		++_generation;
+		n = _waitingConsumers;
+		_waitingConsumers = 0;
+	}
+	for (int i = 0; i < n; ++i)
+	{
+		_nfAvailable.set();
+	}
+}
+
+
+bool BoundedNotificationQueue::empty() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _count == 0;
+}
+
+
+int BoundedNotificationQueue::size() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _count;
+}
+
+
+void BoundedNotificationQueue::clear()
+{
+	Ring notifications;
+	int n;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		notifications.reserve(_count);
+		while (_count > 0)
+		{
+			notifications.push_back(_ring[_head]);
+			_ring[_head] = 0;
+			_head = (_head + 1) % _capacity;
+			--_count;
+		}
+		n = _waitingProducers;
+		_waitingProducers = 0;
+	}
+	for (int i = 0; i < n; ++i)
+	{
+		_spaceAvailable.set();
+	}
+	for (Ring::iterator it = notifications.begin(); it != notifications.end(); ++it)
+	{
+		(*it)->release();
+	}
+}
+
+
+bool BoundedNotificationQueue::hasIdleThreads() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _waitingConsumers > 0;
+}
+
+
+void BoundedNotificationQueue::enqueue(Notification* pNotification, bool urgent)
+{
+	for (;;)
+	{
+		bool wakeConsumer = false;
+		bool full = false;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (_count < _capacity)
+			{
+				if (urgent)
+				{
+					_head = (_head + _capacity - 1) % _capacity;
+					_ring[_head] = pNotification;
+				}
+				else
+				{
+					_ring[(_head + _count) % _capacity] = pNotification;
+				}
+				++_count;
+				if (_waitingConsumers > 0)
+				{
+					--_waitingConsumers;
+					wakeConsumer = true;
+				}
+			}
+			else
+			{
+				++_waitingProducers;
+				full = true;
+			}
+		}
+		if (!full)
+		{
+			if (wakeConsumer) _nfAvailable.set();
+			return;
+		}
+		_spaceAvailable.wait();
+	}
+}
+
+
+Notification* BoundedNotificationQueue::dequeueOne(bool& wakeProducer)
+{
+	if (_count == 0) return 0;
+
+	Notification* pNf = _ring[_head];
+	_ring[_head] = 0;
+	_head = (_head + 1) % _capacity;
+	--_count;
+	if (_waitingProducers > 0)
+	{
+		--_waitingProducers;
+		wakeProducer = true;
+	}
+	return pNf;
+}
+
+
+#endif // POCO_HAVE_GCC_ATOMICS
+
+
+} // namespace Poco
@@ -40,6 +40,7 @@
 #include "Poco/PurgeStrategy.h"
 #include "Poco/Message.h"
 #include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTime.h"
 #include "Poco/LocalDateTime.h"
@@ -47,6 +48,7 @@
 #include "Poco/Timespan.h"
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
+#include "Poco/ErrorHandler.h"
 
 
 namespace Poco {
@@ -59,6 +61,12 @@ const std::string FileChannel::PROP_TIMES      = "times";
 const std::string FileChannel::PROP_COMPRESS   = "compress";
 const std::string FileChannel::PROP_PURGEAGE   = "purgeAge";
 const std::string FileChannel::PROP_PURGECOUNT = "purgeCount";
+const std::string FileChannel::PROP_FLUSH      = "flush";
+const std::string FileChannel::PROP_ASYNC      = "async";
+const std::string FileChannel::PROP_FLUSHINTERVAL = "flushInterval";
+const std::string FileChannel::PROP_FLUSHSIZE     = "flushSize";
+const std::string FileChannel::PROP_FLUSHPRIORITY = "flushPriority";
+const std::string FileChannel::PROP_MAXQUEUESIZE  = "maxQueueSize";
 
 
 FileChannel::FileChannel(): 
@@ -67,7 +75,17 @@ FileChannel::FileChannel():
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
-	_pPurgeStrategy(0)
+	_pPurgeStrategy(0),
+	_flush(true),
+	_async(false),
+	_flushInterval(1000),
+	_flushSize(65536),
+	_flushPriority(Message::PRIO_ERROR),
+	_maxQueueSize(1048576),
+	_flushPriorityName("error"),
+	_queuedBytes(0),
+	_writerRunning(false),
+	_stopWriter(false)
 {
 }
 
@@ -79,7 +97,17 @@ FileChannel::FileChannel(const std::string& path):
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
-	_pPurgeStrategy(0)
+	_pPurgeStrategy(0),
+	_flush(true),
+	_async(false),
+	_flushInterval(1000),
+	_flushSize(65536),
+	_flushPriority(Message::PRIO_ERROR),
+	_maxQueueSize(1048576),
+	_flushPriorityName("error"),
+	_queuedBytes(0),
+	_writerRunning(false),
+	_stopWriter(false)
 {
 }
 
@@ -106,8 +134,11 @@ void FileChannel::open()
 
 void FileChannel::close()
 {
+	stopWriter();
+
 	FastMutex::ScopedLock lock(_mutex);
 
+	writeQueued();
 	delete _pFile;
 	_pFile = 0;
 }
@@ -115,10 +146,68 @@ void FileChannel::close()
 
 void FileChannel::log(const Message& msg)
 {
-	open();
+	bool async;
+	if (!enqueue(msg, async))
+	{
+		FastMutex::ScopedLock lock(_mutex);
 
+		if (async) writeQueued();
+		write(msg.getText(), _flush || async);
+	}
+}
+
+
+void FileChannel::flush()
+{
 	FastMutex::ScopedLock lock(_mutex);
 
+	writeQueued();
+	if (_pFile) _pFile->flush();
+}
+
+
+void FileChannel::run()
+{
+	bool stop = false;
+	long interval;
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		interval = _flushInterval;
+	}
+	while (!stop)
+	{
+		_wakeUp.tryWait(interval);
+		{
+			FastMutex::ScopedLock lock(_queueMutex);
+			stop = _stopWriter;
+			interval = _flushInterval;
+		}
+		try
+		{
+			flush();
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+}
+
+
+void FileChannel::write(const std::string& text, bool flush)
+{
+	if (!_pFile)
+	{
+		_pFile = new LogFile(_path);
+	}
 	if (_pRotateStrategy && _pArchiveStrategy && _pRotateStrategy->mustRotate(_pFile))
 	{
 		try
@@ -135,12 +224,88 @@ void FileChannel::log(const Message& msg)
 		// to the new file.
 		_pRotateStrategy->mustRotate(_pFile);
 	}
-	_pFile->write(msg.getText());
+	_pFile->write(text, flush);
+}
+
+
+void FileChannel::writeQueued()
+{
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+
+		if (_queue.empty()) return;
+		_queue.swap(_batch);
+		_queuedBytes = 0;
+	}
+	try
+	{
+		for (TextQueue::const_iterator it = _batch.begin(); it != _batch.end(); ++it)
+		{
+			write(*it, false);
+		}
+	}
+	catch (...)
+	{
+		_batch.clear();
+		throw;
+	}
+	_batch.clear();
+}
+
+
+bool FileChannel::enqueue(const Message& msg, bool& async)
+{
+	bool wakeUp;
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+
+		async = _async;
+		if (!async || msg.getPriority() <= _flushPriority) return false;
+		// the writer thread does not keep up
+		if (_maxQueueSize > 0 && _queuedBytes >= _maxQueueSize) return false;
+		if (!_writerRunning)
+		{
+			_writer.start(*this);
+			_writerRunning = true;
+		}
+		_queue.push_back(msg.getText());
+		_queuedBytes += msg.getText().size() + 1;
+		wakeUp = _queuedBytes >= _flushSize;
+	}
+	if (wakeUp) _wakeUp.set();
+	return true;
+}
+
+
+void FileChannel::stopWriter()
+{
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+
+		// _writerRunning stays set until the thread has been
+		// joined, so that enqueue() cannot start it again while
+		// it is still running, and only one caller joins it.
+		if (!_writerRunning || _stopWriter) return;
+		_stopWriter = true;
+	}
+	_wakeUp.set();
+	_writer.join();
+
+	FastMutex::ScopedLock lock(_queueMutex);
+	_writerRunning = false;
+	_stopWriter = false;
 }
 
 	
 void FileChannel::setProperty(const std::string& name, const std::string& value)
 {
+	if (name == PROP_ASYNC)
+	{
+		// must not hold the mutex while the writer thread is stopped
+		setAsync(value);
+		return;
+	}
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	if (name == PROP_TIMES)
@@ -165,6 +330,24 @@ void FileChannel::setProperty(const std::string& name, const std::string& value)
 		setPurgeAge(value);
 	else if (name == PROP_PURGECOUNT)
 		setPurgeCount(value);
+	else if (name == PROP_FLUSH)
+		_flush = icompare(value, "true") == 0;
+	else if (name == PROP_FLUSHINTERVAL)
+		setFlushInterval(value);
+	else if (name == PROP_FLUSHSIZE)
+	{
+		std::size_t size = NumberParser::parseUnsigned(value);
+		FastMutex::ScopedLock queueLock(_queueMutex);
+		_flushSize = size;
+	}
+	else if (name == PROP_FLUSHPRIORITY)
+		setFlushPriority(value);
+	else if (name == PROP_MAXQUEUESIZE)
+	{
+		std::size_t size = NumberParser::parseUnsigned(value);
+		FastMutex::ScopedLock queueLock(_queueMutex);
+		_maxQueueSize = size;
+	}
 	else
 		Channel::setProperty(name, value);
 }
@@ -186,6 +369,30 @@ std::string FileChannel::getProperty(const std::string& name) const
 		return _purgeAge;
 	else if (name == PROP_PURGECOUNT)
 		return _purgeCount;
+	else if (name == PROP_FLUSH)
+		return std::string(_flush ? "true" : "false");
+	else if (name == PROP_ASYNC)
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		return std::string(_async ? "true" : "false");
+	}
+	else if (name == PROP_FLUSHINTERVAL)
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		return NumberFormatter::format(_flushInterval);
+	}
+	else if (name == PROP_FLUSHSIZE)
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		return NumberFormatter::format(_flushSize);
+	}
+	else if (name == PROP_FLUSHPRIORITY)
+		return _flushPriorityName;
+	else if (name == PROP_MAXQUEUESIZE)
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		return NumberFormatter::format(_maxQueueSize);
+	}
 	else
 		return Channel::getProperty(name);
 }
@@ -346,6 +553,62 @@ void FileChannel::setPurgeCount(const std::string& count)
 }
 
 
+void FileChannel::setAsync(const std::string& async)
+{
+	bool enable = icompare(async, "true") == 0;
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		_async = enable;
+	}
+	if (!enable)
+	{
+		stopWriter();
+		flush();
+	}
+}
+
+
+void FileChannel::setFlushInterval(const std::string& interval)
+{
+	long n = NumberParser::parse(interval);
+	if (n <= 0) throw InvalidArgumentException("flushInterval", interval);
+
+	FastMutex::ScopedLock lock(_queueMutex);
+	_flushInterval = n;
+}
+
+
+void FileChannel::setFlushPriority(const std::string& priority)
+{
+	int prio;
+	if (priority == "none")
+		prio = 0;
+	else if (priority == "fatal")
+		prio = Message::PRIO_FATAL;
+	else if (priority == "critical")
+		prio = Message::PRIO_CRITICAL;
+	else if (priority == "error")
+		prio = Message::PRIO_ERROR;
+	else if (priority == "warning")
+		prio = Message::PRIO_WARNING;
+	else if (priority == "notice")
+		prio = Message::PRIO_NOTICE;
+	else if (priority == "information")
+		prio = Message::PRIO_INFORMATION;
+	else if (priority == "debug")
+		prio = Message::PRIO_DEBUG;
+	else if (priority == "trace")
+		prio = Message::PRIO_TRACE;
+	else
+		throw InvalidArgumentException("flushPriority", priority);
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		_flushPriority = prio;
+	}
+	_flushPriorityName = priority;
+}
+
+
 void FileChannel::purge()
 {
 	if (_pPurgeStrategy)
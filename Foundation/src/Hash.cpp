@@ -35,22 +35,101 @@
 
 
 #include "Poco/Hash.h"
+#include <cstring>
 
 
 namespace Poco {
 
 
+//
+// The string hash function is MurmurHash2 by Austin Appleby
+// (public domain), in its 64-bit variant (MurmurHash64A) if
+// std::size_t has 64 bits. The input is processed one word
+// at a time, rather than one character at a time.
+//
+
+
+#if defined(POCO_PTR_IS_64_BIT)
+
+
 std::size_t hash(const std::string& str)
 {
-	std::size_t h = 0;
-	std::string::const_iterator it  = str.begin();
-	std::string::const_iterator end = str.end();
-	while (it != end)
+	static const UInt64 M = (UInt64(0xC6A4A793U) << 32) | 0x5BD1E995U;
+	static const int    R = 47;
+
+	const char* data = str.data();
+	std::size_t len  = str.size();
+	UInt64 h = M ^ (len*M);
+	while (len >= 8)
+	{
+		UInt64 k;
+		std::memcpy(&k, data, 8);
+		k *= M;
+		k ^= k >> R;
+		k *= M;
+		h ^= k;
+		h *= M;
+		data += 8;
+		len  -= 8;
+	}
+	const unsigned char* tail = reinterpret_cast<const unsigned char*>(data);
+	switch (len)
 	{
-		h = h * 0xf4243 ^ *it++;
+	case 7: h ^= UInt64(tail[6]) << 48;
+	case 6: h ^= UInt64(tail[5]) << 40;
+	case 5: h ^= UInt64(tail[4]) << 32;
+	case 4: h ^= UInt64(tail[3]) << 24;
+	case 3: h ^= UInt64(tail[2]) << 16;
+	case 2: h ^= UInt64(tail[1]) << 8;
+	case 1: h ^= UInt64(tail[0]);
+		h *= M;
 	}
+	h ^= h >> R;
+	h *= M;
+	h ^= h >> R;
+	return static_cast<std::size_t>(h);
+}
+
+
+#else
+
+
+std::size_t hash(const std::string& str)
+{
+	static const UInt32 M = 0x5BD1E995U;
+	static const int    R = 24;
+
+	const char* data = str.data();
+	std::size_t len  = str.size();
+	UInt32 h = M ^ static_cast<UInt32>(len);
+	while (len >= 4)
+	{
+		UInt32 k;
+		std::memcpy(&k, data, 4);
+		k *= M;
+		k ^= k >> R;
+		k *= M;
+		h *= M;
+		h ^= k;
+		data += 4;
+		len  -= 4;
+	}
+	const unsigned char* tail = reinterpret_cast<const unsigned char*>(data);
+	switch (len)
+	{
+	case 3: h ^= UInt32(tail[2]) << 16;
+	case 2: h ^= UInt32(tail[1]) << 8;
+	case 1: h ^= UInt32(tail[0]);
+		h *= M;
+	}
+	h ^= h >> 13;
+	h *= M;
+	h ^= h >> 15;
 	return h;
 }
 
 
+#endif // POCO_PTR_IS_64_BIT
+
+
 } // namespace Poco
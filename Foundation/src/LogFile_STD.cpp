@@ -58,9 +58,17 @@ LogFileImpl::~LogFileImpl()
 }
 
 
-void LogFileImpl::writeImpl(const std::string& text)
+void LogFileImpl::writeImpl(const std::string& text, bool flush)
 {
-	_str << text << std::endl;
+	_str << text << '\n';
+	if (flush) _str.flush();
+	if (!_str.good()) throw WriteFileException(_path);
+}
+
+
+void LogFileImpl::flushImpl()
+{
+	_str.flush();
 	if (!_str.good()) throw WriteFileException(_path);
 }
 
@@ -59,13 +59,19 @@ LogFileImpl::~LogFileImpl()
 }
 
 
-void LogFileImpl::writeImpl(const std::string& text)
+void LogFileImpl::writeImpl(const std::string& text, bool flush)
 {
 	int rc = fputs(text.c_str(), _file);
 	if (rc == EOF) throw WriteFileException(_path);
 	rc = fputc('\n', _file);
 	if (rc == EOF) throw WriteFileException(_path);
-	rc = fflush(_file);
+	if (flush) flushImpl();
+}
+
+
+void LogFileImpl::flushImpl()
+{
+	int rc = fflush(_file);
 	if (rc == EOF) throw WriteFileException(_path);
 }
 
@@ -36,25 +36,115 @@
 
 #include "Poco/NumberFormatter.h"
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cfloat>
+#include <clocale>
 
 
-#if defined(_MSC_VER)
-	#define I64_FMT "I64"
-#elif defined(__APPLE__) 
-	#define I64_FMT "q"
-#else
-	#define I64_FMT "ll"
-#endif
+namespace Poco {
 
 
-namespace Poco {
+namespace
+{
+	const char DIGIT_PAIRS[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+	enum
+	{
+		BUFFER_SIZE = 32 // large enough for a 64-bit value in any supported base
+	};
+
+	template <typename U>
+	char* formatDec(U value, char* end)
+		/// Writes the decimal digits of value backwards, two at a
+		/// time, ending at end. Returns a pointer to the first digit.
+	{
+		char* p = end;
+		while (value >= 100)
+		{
+			unsigned i = unsigned(value % 100)*2;
+			value /= 100;
+			*--p = DIGIT_PAIRS[i + 1];
+			*--p = DIGIT_PAIRS[i];
+		}
+		if (value >= 10)
+		{
+			unsigned i = unsigned(value)*2;
+			*--p = DIGIT_PAIRS[i + 1];
+			*--p = DIGIT_PAIRS[i];
+		}
+		else *--p = char('0' + value);
+		return p;
+	}
+
+	template <typename U>
+	void appendDec(std::string& str, U value, int width, char fill)
+	{
+		char buffer[BUFFER_SIZE];
+		char* end = buffer + BUFFER_SIZE;
+		char* p = formatDec(value, end);
+		int len = int(end - p);
+		if (width > len) str.append(width - len, fill);
+		str.append(p, len);
+	}
+
+	template <typename S, typename U>
+	void appendSignedDec(std::string& str, S value, int width, char fill)
+		/// Like printf, the fill characters go before the sign if
+		/// padding with spaces, and after the sign if padding with zeros.
+	{
+		char buffer[BUFFER_SIZE];
+		char* end = buffer + BUFFER_SIZE;
+		bool negative = value < 0;
+		char* p = formatDec(negative ? U(0) - U(value) : U(value), end);
+		int len = int(end - p) + (negative ? 1 : 0);
+		if (fill == '0')
+		{
+			if (negative) str += '-';
+			if (width > len) str.append(width - len, '0');
+		}
+		else
+		{
+			if (width > len) str.append(width - len, ' ');
+			if (negative) str += '-';
+		}
+		str.append(p, end - p);
+	}
+
+	template <typename U>
+	void appendHexDigits(std::string& str, U value, int width)
+	{
+		char buffer[BUFFER_SIZE];
+		char* end = buffer + BUFFER_SIZE;
+		char* p = end;
+		do
+		{
+			*--p = HEX_DIGITS[value & 0xF];
+			value >>= 4;
+		}
+		while (value);
+		int len = int(end - p);
+		if (width > len) str.append(width - len, '0');
+		str.append(p, len);
+	}
+}
 
 
 void NumberFormatter::append(std::string& str, int value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%d", value);
-	str.append(buffer);
+	appendSignedDec<int, unsigned>(str, value, 0, ' ');
 }
 
 
@@ -62,9 +152,7 @@ void NumberFormatter::append(std::string& str, int value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%*d", width, value);
-	str.append(buffer);
+	appendSignedDec<int, unsigned>(str, value, width, ' ');
 }
 
 
@@ -72,17 +160,13 @@ void NumberFormatter::append0(std::string& str, int value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*d", width, value);
-	str.append(buffer);
+	appendSignedDec<int, unsigned>(str, value, width, '0');
 }
 
 
 void NumberFormatter::appendHex(std::string& str, int value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%X", value);
-	str.append(buffer);
+	appendHexDigits(str, static_cast<unsigned>(value), 0);
 }
 
 
@@ -90,17 +174,13 @@ void NumberFormatter::appendHex(std::string& str, int value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*X", width, value);
-	str.append(buffer);
+	appendHexDigits(str, static_cast<unsigned>(value), width);
 }
 
 
 void NumberFormatter::append(std::string& str, unsigned value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%u", value);
-	str.append(buffer);
+	appendDec(str, value, 0, ' ');
 }
 
 
@@ -108,27 +188,21 @@ void NumberFormatter::append(std::string& str, unsigned value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%*u", width, value);
-	str.append(buffer);
+	appendDec(str, value, width, ' ');
 }
 
 
-void NumberFormatter::append0(std::string& str, unsigned int value, int width)
+void NumberFormatter::append0(std::string& str, unsigned value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*u", width, value);
-	str.append(buffer);
+	appendDec(str, value, width, '0');
 }
 
 
 void NumberFormatter::appendHex(std::string& str, unsigned value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%X", value);
-	str.append(buffer);
+	appendHexDigits(str, value, 0);
 }
 
 
@@ -136,17 +210,13 @@ void NumberFormatter::appendHex(std::string& str, unsigned value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*X", width, value);
-	str.append(buffer);
+	appendHexDigits(str, value, width);
 }
 
 
 void NumberFormatter::append(std::string& str, long value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%ld", value);
-	str.append(buffer);
+	appendSignedDec<long, unsigned long>(str, value, 0, ' ');
 }
 
 
@@ -154,9 +224,7 @@ void NumberFormatter::append(std::string& str, long value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%*ld", width, value);
-	str.append(buffer);
+	appendSignedDec<long, unsigned long>(str, value, width, ' ');
 }
 
 
@@ -164,17 +232,13 @@ void NumberFormatter::append0(std::string& str, long value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*ld", width, value);
-	str.append(buffer);
+	appendSignedDec<long, unsigned long>(str, value, width, '0');
 }
 
 
 void NumberFormatter::appendHex(std::string& str, long value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%lX", value);
-	str.append(buffer);
+	appendHexDigits(str, static_cast<unsigned long>(value), 0);
 }
 
 
@@ -182,17 +246,13 @@ void NumberFormatter::appendHex(std::string& str, long value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*lX", width, value);
-	str.append(buffer);
+	appendHexDigits(str, static_cast<unsigned long>(value), width);
 }
 
 
 void NumberFormatter::append(std::string& str, unsigned long value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%lu", value);
-	str.append(buffer);
+	appendDec(str, value, 0, ' ');
 }
 
 
@@ -200,9 +260,7 @@ void NumberFormatter::append(std::string& str, unsigned long value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%*lu", width, value);
-	str.append(buffer);
+	appendDec(str, value, width, ' ');
 }
 
 
@@ -210,17 +268,13 @@ void NumberFormatter::append0(std::string& str, unsigned long value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*lu", width, value);
-	str.append(buffer);
+	appendDec(str, value, width, '0');
 }
 
 
 void NumberFormatter::appendHex(std::string& str, unsigned long value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%lX", value);
-	str.append(buffer);
+	appendHexDigits(str, value, 0);
 }
 
 
@@ -228,9 +282,7 @@ void NumberFormatter::appendHex(std::string& str, unsigned long value, int width
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*lX", width, value);
-	str.append(buffer);
+	appendHexDigits(str, value, width);
 }
 
 
@@ -239,9 +291,7 @@ void NumberFormatter::appendHex(std::string& str, unsigned long value, int width
 
 void NumberFormatter::append(std::string& str, Int64 value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%"I64_FMT"d", value);
-	str.append(buffer);
+	appendSignedDec<Int64, UInt64>(str, value, 0, ' ');
 }
 
 
@@ -249,9 +299,7 @@ void NumberFormatter::append(std::string& str, Int64 value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%*"I64_FMT"d", width, value);
-	str.append(buffer);
+	appendSignedDec<Int64, UInt64>(str, value, width, ' ');
 }
 
 
@@ -259,17 +307,13 @@ void NumberFormatter::append0(std::string& str, Int64 value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*"I64_FMT"d", width, value);
-	str.append(buffer);
+	appendSignedDec<Int64, UInt64>(str, value, width, '0');
 }
 
 
 void NumberFormatter::appendHex(std::string& str, Int64 value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%"I64_FMT"X", value);
-	str.append(buffer);
+	appendHexDigits(str, static_cast<UInt64>(value), 0);
 }
 
 
@@ -277,17 +321,13 @@ void NumberFormatter::appendHex(std::string& str, Int64 value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*"I64_FMT"X", width, value);
-	str.append(buffer);
+	appendHexDigits(str, static_cast<UInt64>(value), width);
 }
 
 
 void NumberFormatter::append(std::string& str, UInt64 value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%"I64_FMT"u", value);
-	str.append(buffer);
+	appendDec(str, value, 0, ' ');
 }
 
 
@@ -295,9 +335,7 @@ void NumberFormatter::append(std::string& str, UInt64 value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%*"I64_FMT"u", width, value);
-	str.append(buffer);
+	appendDec(str, value, width, ' ');
 }
 
 
@@ -305,17 +343,13 @@ void NumberFormatter::append0(std::string& str, UInt64 value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*"I64_FMT"u", width, value);
-	str.append(buffer);
+	appendDec(str, value, width, '0');
 }
 
 
 void NumberFormatter::appendHex(std::string& str, UInt64 value)
 {
-	char buffer[64];
-	std::sprintf(buffer, "%"I64_FMT"X", value);
-	str.append(buffer);
+	appendHexDigits(str, value, 0);
 }
 
 
@@ -323,9 +357,7 @@ void NumberFormatter::appendHex(std::string& str, UInt64 value, int width)
 {
 	poco_assert (width > 0 && width < 64);
 
-	char buffer[64];
-	std::sprintf(buffer, "%0*"I64_FMT"X", width, value);
-	str.append(buffer);
+	appendHexDigits(str, value, width);
 }
 
 
@@ -368,19 +400,44 @@ void NumberFormatter::append(std::string& str, double value, int width, int prec
 }
 
 
+void NumberFormatter::appendShortest(std::string& str, double value)
+{
+	// Any decimal with at most 15 significant digits survives the round
+	// trip through a normalized double, so %.15g (which drops trailing
+	// zeros) is exact whenever a representation that short exists.
+	// Otherwise 16, and at last 17 digits are needed, the latter being
+	// sufficient for every finite double. Subnormal numbers have less
+	// precision, so for them the search starts at a single digit.
+	//
+	// sprintf() and strtod() use the decimal point of the current C
+	// locale. They agree with each other in the round trip, and the
+	// result is converted to use '.', as expected by NumberParser.
+	int precision = (value != 0 && value > -DBL_MIN && value < DBL_MIN) ? 1 : 15;
+	char buffer[64];
+	for (; precision < 17; ++precision)
+	{
+		std::sprintf(buffer, "%.*g", precision, value);
+		if (std::strtod(buffer, 0) == value) break;
+	}
+	if (precision == 17) std::sprintf(buffer, "%.*g", 17, value);
+
+	char decimalPoint = *std::localeconv()->decimal_point;
+	if (decimalPoint != '.')
+	{
+		char* pPoint = std::strchr(buffer, decimalPoint);
+		if (pPoint) *pPoint = '.';
+	}
+	str.append(buffer);
+}
+
+
 void NumberFormatter::append(std::string& str, const void* ptr)
 {
-	char buffer[24];
 #if defined(POCO_PTR_IS_64_BIT)
-	#if defined(POCO_LONG_IS_64_BIT)
-		std::sprintf(buffer, "%016lX", (UIntPtr) ptr);
-	#else
-		std::sprintf(buffer, "%016"I64_FMT"X", (UIntPtr) ptr);
-	#endif
+	appendHexDigits(str, (UIntPtr) ptr, 16);
 #else
-	std::sprintf(buffer, "%08lX", (UIntPtr) ptr);
+	appendHexDigits(str, (UIntPtr) ptr, 8);
 #endif
-	str.append(buffer);
 }
 
 
@@ -36,19 +36,251 @@
 
 #include "Poco/NumberParser.h"
 #include "Poco/Exception.h"
-#include <cstdio>
+#include <limits>
+#include <cstdlib>
+#include <clocale>
 
 
-#if defined(_MSC_VER)
-	#define I64_FMT "I64"
-#elif defined(__APPLE__) 
-	#define I64_FMT "q"
-#else
-	#define I64_FMT "ll"
-#endif
+namespace Poco {
 
 
-namespace Poco {
+namespace
+{
+	inline bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	inline unsigned digitValue(char c)
+		/// Returns the value of a decimal digit, or a value
+		/// greater than 9 if c is not a decimal digit.
+	{
+		return unsigned(static_cast<unsigned char>(c)) - unsigned('0');
+	}
+
+	inline unsigned hexDigitValue(char c)
+		/// Returns the value of a hexadecimal digit, or a value
+		/// greater than 15 if c is not a hexadecimal digit.
+	{
+		unsigned d = digitValue(c);
+		if (d <= 9) return d;
+		d = unsigned(static_cast<unsigned char>(c) | 0x20) - unsigned('a');
+		return d < 6 ? d + 10 : 16;
+	}
+
+	const char* skipSpace(const char* it, const char* end)
+	{
+		while (it != end && isSpace(*it)) ++it;
+		return it;
+	}
+
+	template <typename U>
+	bool parseDigits(const char* it, const char* end, U limit, U& value)
+		/// Parses the decimal digits in [it, end), which must not be
+		/// empty. Fails if a non-digit is found or the value exceeds limit.
+	{
+		if (it == end) return false;
+		U result = 0;
+		for (; it != end; ++it)
+		{
+			unsigned d = digitValue(*it);
+			if (d > 9 || result > (limit - d)/10) return false;
+			result = result*10 + d;
+		}
+		value = result;
+		return true;
+	}
+
+	template <typename S, typename U>
+	bool parseSignedInt(const char* begin, const char* end, S& value)
+	{
+		const char* it = skipSpace(begin, end);
+		bool negative = false;
+		if (it != end && (*it == '-' || *it == '+'))
+		{
+			negative = *it == '-';
+			++it;
+		}
+		U limit = U(std::numeric_limits<S>::max());
+		if (negative) ++limit;
+		U result;
+		if (!parseDigits(it, end, limit, result)) return false;
+		if (negative)
+			value = result == 0 ? S(0) : S(-S(result - 1) - 1);
+		else
+			value = S(result);
+		return true;
+	}
+
+	template <typename U>
+	bool parseUnsignedInt(const char* begin, const char* end, U& value)
+		/// Like std::strtoul(), a negative value is negated in the
+		/// unsigned result type.
+	{
+		const char* it = skipSpace(begin, end);
+		bool negative = false;
+		if (it != end && (*it == '-' || *it == '+'))
+		{
+			negative = *it == '-';
+			++it;
+		}
+		U result;
+		if (!parseDigits(it, end, std::numeric_limits<U>::max(), result)) return false;
+		value = negative ? U(0) - result : result;
+		return true;
+	}
+
+	template <typename U>
+	bool parseHexInt(const char* begin, const char* end, U& value)
+		/// Like std::sscanf()'s %x, an optional sign may precede the
+		/// optional 0x prefix, and a negative value is negated in the
+		/// unsigned result type.
+	{
+		const char* it = skipSpace(begin, end);
+		bool negative = false;
+		if (it != end && (*it == '-' || *it == '+'))
+		{
+			negative = *it == '-';
+			++it;
+		}
+		if (end - it > 2 && it[0] == '0' && (it[1] == 'x' || it[1] == 'X')) it += 2;
+		if (it == end) return false;
+		const U limit = std::numeric_limits<U>::max() >> 4;
+		U result = 0;
+		for (; it != end; ++it)
+		{
+			unsigned d = hexDigitValue(*it);
+			if (d > 15 || result > limit) return false;
+			result = (result << 4) | d;
+		}
+		value = negative ? U(0) - result : result;
+		return true;
+	}
+
+	// all powers of ten that can be represented exactly as a double
+	const double EXACT_POWERS_OF_TEN[] =
+	{
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+		1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+		1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	const int MAX_EXACT_EXPONENT = 22;
+	const int MAX_SIGNIFICANT_DIGITS = 19; // fit into a UInt64
+	const UInt64 MAX_EXACT_SIGNIFICAND = UInt64(1) << 53;
+
+	bool parseDoubleSlow(const char* begin, const char* end, double& value)
+		/// Hands the number over to std::strtod(), which needs a
+		/// zero-terminated string using the decimal point of the
+		/// current C locale.
+	{
+		std::string s(begin, end);
+		char decimalPoint = *std::localeconv()->decimal_point;
+		if (decimalPoint != '.')
+		{
+			std::string::size_type pos = s.find('.');
+			if (pos != std::string::npos) s[pos] = decimalPoint;
+		}
+		const char* str = s.c_str();
+		char* strEnd = 0;
+		double result = std::strtod(str, &strEnd);
+		if (strEnd == str || strEnd != str + s.size()) return false;
+		value = result;
+		return true;
+	}
+
+	bool parseDouble(const char* begin, const char* end, double& value)
+		/// Parses plain decimal numbers whose significand and decimal
+		/// exponent are small enough for a single, correctly rounded
+		/// multiplication or division by an exact power of ten to
+		/// yield the correctly rounded result (Clinger's fast path).
+		/// Everything else, including numbers that are not valid, is
+		/// left to parseDoubleSlow().
+	{
+		const char* it = skipSpace(begin, end);
+		bool negative = false;
+		if (it != end && (*it == '-' || *it == '+'))
+		{
+			negative = *it == '-';
+			++it;
+		}
+		UInt64 significand = 0;
+		int digits = 0;
+		int exponent = 0;
+		bool haveDigits = false;
+		bool exact = true;
+		for (; it != end && digitValue(*it) <= 9; ++it)
+		{
+			haveDigits = true;
+			if (digits < MAX_SIGNIFICANT_DIGITS)
+			{
+				significand = significand*10 + digitValue(*it);
+				if (significand) ++digits;
+			}
+			else
+			{
+				++exponent;
+				if (*it != '0') exact = false;
+			}
+		}
+		if (it != end && *it == '.')
+		{
+			for (++it; it != end && digitValue(*it) <= 9; ++it)
+			{
+				haveDigits = true;
+				if (digits < MAX_SIGNIFICANT_DIGITS)
+				{
+					significand = significand*10 + digitValue(*it);
+					if (significand) ++digits;
+					--exponent;
+				}
+				else if (*it != '0') exact = false;
+			}
+		}
+		if (haveDigits && it != end && (*it == 'e' || *it == 'E'))
+		{
+			const char* expIt = it + 1;
+			bool negativeExp = false;
+			if (expIt != end && (*expIt == '-' || *expIt == '+'))
+			{
+				negativeExp = *expIt == '-';
+				++expIt;
+			}
+			if (expIt != end && digitValue(*expIt) <= 9)
+			{
+				int exp = 0;
+				for (; expIt != end && digitValue(*expIt) <= 9; ++expIt)
+				{
+					if (exp < 10000) exp = exp*10 + int(digitValue(*expIt));
+				}
+				exponent += negativeExp ? -exp : exp;
+				it = expIt;
+			}
+		}
+		if (it == end && haveDigits && exact && significand <= MAX_EXACT_SIGNIFICAND)
+		{
+			double result = double(significand);
+			if (significand == 0)
+			{
+				value = negative ? -0.0 : 0.0;
+				return true;
+			}
+			else if (exponent >= 0 && exponent <= MAX_EXACT_EXPONENT)
+			{
+				result *= EXACT_POWERS_OF_TEN[exponent];
+				value = negative ? -result : result;
+				return true;
+			}
+			else if (exponent < 0 && exponent >= -MAX_EXACT_EXPONENT)
+			{
+				result /= EXACT_POWERS_OF_TEN[-exponent];
+				value = negative ? -result : result;
+				return true;
+			}
+		}
+		return parseDoubleSlow(begin, end, value);
+	}
+}
 
 
 int NumberParser::parse(const std::string& s)
@@ -63,8 +295,13 @@ int NumberParser::parse(const std::string& s)
 
 bool NumberParser::tryParse(const std::string& s, int& value)
 {
-	char temp;
-	return std::sscanf(s.c_str(), "%d%c", &value, &temp) == 1;
+	return tryParse(s.data(), s.data() + s.size(), value);
+}
+
+
+bool NumberParser::tryParse(const char* begin, const char* end, int& value)
+{
+	return parseSignedInt<int, unsigned>(begin, end, value);
 }
 
 
@@ -80,8 +317,13 @@ unsigned NumberParser::parseUnsigned(const std::string& s)
 
 bool NumberParser::tryParseUnsigned(const std::string& s, unsigned& value)
 {
-	char temp;
-	return std::sscanf(s.c_str(), "%u%c", &value, &temp) == 1;
+	return tryParseUnsigned(s.data(), s.data() + s.size(), value);
+}
+
+
+bool NumberParser::tryParseUnsigned(const char* begin, const char* end, unsigned& value)
+{
+	return parseUnsignedInt(begin, end, value);
 }
 
 
@@ -97,8 +339,13 @@ unsigned NumberParser::parseHex(const std::string& s)
 
 bool NumberParser::tryParseHex(const std::string& s, unsigned& value)
 {
-	char temp;
-	return std::sscanf(s.c_str(), "%x%c", &value, &temp) == 1;
+	return tryParseHex(s.data(), s.data() + s.size(), value);
+}
+
+
+bool NumberParser::tryParseHex(const char* begin, const char* end, unsigned& value)
+{
+	return parseHexInt(begin, end, value);
 }
 
 
@@ -117,8 +364,13 @@ Int64 NumberParser::parse64(const std::string& s)
 
 bool NumberParser::tryParse64(const std::string& s, Int64& value)
 {
-	char temp;
-	return std::sscanf(s.c_str(), "%"I64_FMT"d%c", &value, &temp) == 1;
+	return tryParse64(s.data(), s.data() + s.size(), value);
+}
+
+
+bool NumberParser::tryParse64(const char* begin, const char* end, Int64& value)
+{
+	return parseSignedInt<Int64, UInt64>(begin, end, value);
 }
 
 
@@ -134,8 +386,13 @@ UInt64 NumberParser::parseUnsigned64(const std::string& s)
 
 bool NumberParser::tryParseUnsigned64(const std::string& s, UInt64& value)
 {
-	char temp;
-	return std::sscanf(s.c_str(), "%"I64_FMT"u%c", &value, &temp) == 1;
+	return tryParseUnsigned64(s.data(), s.data() + s.size(), value);
+}
+
+
+bool NumberParser::tryParseUnsigned64(const char* begin, const char* end, UInt64& value)
+{
+	return parseUnsignedInt(begin, end, value);
 }
 
 
@@ -151,8 +408,13 @@ UInt64 NumberParser::parseHex64(const std::string& s)
 
 bool NumberParser::tryParseHex64(const std::string& s, UInt64& value)
 {
-	char temp;
-	return std::sscanf(s.c_str(), "%"I64_FMT"x%c", &value, &temp) == 1;
+	return tryParseHex64(s.data(), s.data() + s.size(), value);
+}
+
+
+bool NumberParser::tryParseHex64(const char* begin, const char* end, UInt64& value)
+{
+	return parseHexInt(begin, end, value);
 }
 
 
@@ -168,11 +430,16 @@ double NumberParser::parseFloat(const std::string& s)
 		throw SyntaxException("Not a valid floating-point number", s);
 }
 
-	
+
 bool NumberParser::tryParseFloat(const std::string& s, double& value)
 {
-	char temp;
-	return std::sscanf(s.c_str(), "%lf%c", &value, &temp) == 1;
+	return tryParseFloat(s.data(), s.data() + s.size(), value);
+}
+
+
+bool NumberParser::tryParseFloat(const char* begin, const char* end, double& value)
+{
+	return parseDouble(begin, end, value);
 }
 
 
@@ -43,6 +43,7 @@
 #include "Poco/Timestamp.h"
 #include "Poco/Timezone.h"
 #include "Poco/Environment.h"
+#include <cstring>
 
 
 namespace Poco {
@@ -53,15 +54,22 @@ const std::string PatternFormatter::PROP_TIMES   = "times";
 
 
 PatternFormatter::PatternFormatter():
-	_localTime(false)
+	_localTime(false),
+	_needsTime(false),
+	_sequence(0)
 {
+	_cachedTime.valid = false;
 }
 
 
 PatternFormatter::PatternFormatter(const std::string& format):
 	_localTime(false),
-	_pattern(format)
+	_pattern(format),
+	_needsTime(false),
+	_sequence(0)
 {
+	_cachedTime.valid = false;
+	parsePattern();
 }
 
 
@@ -72,79 +80,167 @@ PatternFormatter::~PatternFormatter()
 
 void PatternFormatter::format(const Message& msg, std::string& text)
 {
-	Timestamp timestamp = msg.getTime();
-	if (_localTime)
+	CachedTime time;
+	if (_needsTime) cachedTime(msg.getTime(), time);
+	int fraction = static_cast<int>(msg.getTime().epochMicroseconds() % Timestamp::resolution());
+	for (PatternActions::const_iterator it = _patternActions.begin(); it != _patternActions.end(); ++it)
+	{
+		text.append(it->prepend);
+		switch (it->key)
+		{
+		case 0: break;
+		case 's': text.append(msg.getSource()); break;
+		case 't': text.append(msg.getText()); break;
+		case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
+		case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
+		case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
+		case 'P': NumberFormatter::append(text, msg.getPid()); break;
+		case 'T': text.append(msg.getThread()); break;
+		case 'I': NumberFormatter::append(text, msg.getTid()); break;
+		case 'N': text.append(it->property); break;
+		case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
+		case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
+		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[time.dayOfWeek], 0, 3); break;
+		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[time.dayOfWeek]); break;
+		case 'b': text.append(DateTimeFormat::MONTH_NAMES[time.month - 1], 0, 3); break;
+		case 'B': text.append(DateTimeFormat::MONTH_NAMES[time.month - 1]); break;
+		case 'd': NumberFormatter::append0(text, time.day, 2); break;
+		case 'e': NumberFormatter::append(text, time.day); break;
+		case 'f': NumberFormatter::append(text, time.day, 2); break;
+		case 'm': NumberFormatter::append0(text, time.month, 2); break;
+		case 'n': NumberFormatter::append(text, time.month); break;
+		case 'o': NumberFormatter::append(text, time.month, 2); break;
+		case 'y': NumberFormatter::append0(text, time.year % 100, 2); break;
+		case 'Y': NumberFormatter::append0(text, time.year, 4); break;
+		case 'H': NumberFormatter::append0(text, time.hour, 2); break;
+		case 'h': NumberFormatter::append0(text, time.hour < 1 ? 12 : (time.hour > 12 ? time.hour - 12 : time.hour), 2); break;
+		case 'a': text.append(time.hour < 12 ? "am" : "pm"); break;
+		case 'A': text.append(time.hour < 12 ? "AM" : "PM"); break;
+		case 'M': NumberFormatter::append0(text, time.minute, 2); break;
+		case 'S': NumberFormatter::append0(text, time.sec, 2); break;
+		case 'i': NumberFormatter::append0(text, fraction/1000, 3); break;
+		case 'c': NumberFormatter::append(text, fraction/100000); break;
+		case 'F': NumberFormatter::append0(text, fraction, 6); break;
+		case 'z': text.append(DateTimeFormatter::tzdISO(time.tzd)); break;
+		case 'Z': text.append(DateTimeFormatter::tzdRFC(time.tzd)); break;
+		case 'E': NumberFormatter::append(text, msg.getTime().epochTime()); break;
+		case '[':
+			try
+			{
+				text.append(msg[it->property]);
+			}
+			catch (...)
+			{
+			}
+			break;
+		default: text += it->key;
+		}
+	}
+}
+
+
+void PatternFormatter::cachedTime(const Timestamp& timestamp, CachedTime& time)
+{
+	std::time_t second = timestamp.epochTime();
+
+	if (readCachedTime(second, time)) return;
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (!_cachedTime.valid || _cachedTime.second != second)
 	{
-		timestamp += Timezone::utcOffset()*Timestamp::resolution();
-		timestamp += Timezone::dst()*Timestamp::resolution();
+#if defined(POCO_HAVE_GCC_ATOMICS)
+		++_sequence;
+		__sync_synchronize();
+#endif
+		if (!_localTime)
+		{
+			_cachedTime.tzd = DateTimeFormatter::UTC;
+		}
+		else if (!_cachedTime.valid || second - _cachedTime.tzdUpdated >= TZ_REFRESH_INTERVAL || second < _cachedTime.tzdUpdated)
+		{
+			_cachedTime.tzd = Timezone::tzd();
+			_cachedTime.tzdUpdated = second;
+		}
+		Timestamp local(Timestamp::fromEpochTime(second));
+		if (_localTime) local += _cachedTime.tzd*Timestamp::resolution();
+		DateTime dateTime(local);
+		_cachedTime.second    = second;
+		_cachedTime.year      = dateTime.year();
+		_cachedTime.month     = dateTime.month();
+		_cachedTime.day       = dateTime.day();
+		_cachedTime.dayOfWeek = dateTime.dayOfWeek();
+		_cachedTime.hour      = dateTime.hour();
+		_cachedTime.minute    = dateTime.minute();
+		_cachedTime.sec       = dateTime.second();
+		_cachedTime.valid     = true;
+#if defined(POCO_HAVE_GCC_ATOMICS)
+		__sync_synchronize();
+		++_sequence;
+#endif
 	}
-	DateTime dateTime = timestamp;
+	time = _cachedTime;
+}
+
+
+bool PatternFormatter::readCachedTime(std::time_t second, CachedTime& time) const
+{
+#if defined(POCO_HAVE_GCC_ATOMICS)
+	// A seqlock: the copy is only used if the sequence number
+	// was even (no update in progress) and did not change
+	// while the fields were being copied.
+	unsigned sequence = _sequence;
+	if (sequence & 1) return false;
+	__sync_synchronize();
+	time = _cachedTime;
+	__sync_synchronize();
+	return _sequence == sequence && time.valid && time.second == second;
+#else
+	return false;
+#endif
+}
+
+
+void PatternFormatter::parsePattern()
+{
+	_patternActions.clear();
+	_needsTime = false;
+
 	std::string::const_iterator it  = _pattern.begin();
 	std::string::const_iterator end = _pattern.end();
+	PatternAction endAct;
 	while (it != end)
 	{
 		if (*it == '%')
 		{
 			if (++it != end)
 			{
-				switch (*it)
-				{
-				case 's': text.append(msg.getSource()); break;
-				case 't': text.append(msg.getText()); break;
-				case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
-				case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
-				case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
-				case 'P': NumberFormatter::append(text, msg.getPid()); break;
-				case 'T': text.append(msg.getThread()); break;
-				case 'I': NumberFormatter::append(text, msg.getTid()); break;
-				case 'N': text.append(Environment::nodeName()); break;
-				case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
-				case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
-				case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
-				case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
-				case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
-				case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
-				case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
-				case 'e': NumberFormatter::append(text, dateTime.day()); break;
-				case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
-				case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
-				case 'n': NumberFormatter::append(text, dateTime.month()); break;
-				case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
-				case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
-				case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
-				case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
-				case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
-				case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
-				case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
-				case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
-				case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
-				case 'i': NumberFormatter::append0(text, dateTime.millisecond(), 3); break;
-				case 'c': NumberFormatter::append(text, dateTime.millisecond()/100); break;
-				case 'F': NumberFormatter::append0(text, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
-				case 'z': text.append(DateTimeFormatter::tzdISO(_localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
-				case 'Z': text.append(DateTimeFormatter::tzdRFC(_localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
-				case 'E': NumberFormatter::append(text, msg.getTime().epochTime()); break;
-				case '[':
+				PatternAction act;
+				act.prepend.swap(endAct.prepend);
+				act.key = *it;
+				if (*it == '[')
 				{
 					++it;
-					std::string prop;
-					while (it != end && *it != ']') prop += *it++;
+					while (it != end && *it != ']') act.property += *it++;
 					if (it == end) --it;
-					try
-					{
-						text.append(msg[prop]);
-					}
-					catch (...)
-					{
-					}
-					break;
 				}
-				default: text += *it;
+				else if (*it == 'N')
+				{
+					act.property = Environment::nodeName();
+				}
+				else if (std::strchr("wWbBdefmnoyYHhaAMSzZ", *it))
+				{
+					_needsTime = true;
 				}
+				_patternActions.push_back(act);
 				++it;
 			}
 		}
-		else text += *it++;
+		else endAct.prepend += *it++;
+	}
+	if (!endAct.prepend.empty())
+	{
+		_patternActions.push_back(endAct);
 	}
 }
 
@@ -152,9 +248,25 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 void PatternFormatter::setProperty(const std::string& name, const std::string& value)
 {
 	if (name == PROP_PATTERN)
+	{
 		_pattern = value;
+		parsePattern();
+	}
 	else if (name == PROP_TIMES)
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
 		_localTime = (value == "local");
+#if defined(POCO_HAVE_GCC_ATOMICS)
+		++_sequence;
+		__sync_synchronize();
+#endif
+		_cachedTime.valid = false;
+#if defined(POCO_HAVE_GCC_ATOMICS)
+		__sync_synchronize();
+		++_sequence;
+#endif
+	}
 	else 
 		Formatter::setProperty(name, value);
 }
@@ -0,0 +1,215 @@
+//
+// ShardedMemoryPool.cpp
+//
+// $Id: //poco/1.4/Foundation/src/ShardedMemoryPool.cpp#1 $
+//
+// Library: Foundation
+// Package: Core
+// Module:  ShardedMemoryPool
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/ShardedMemoryPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Environment.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+ShardedMemoryPool::ShardedMemoryPool(std::size_t blockSize, int preAlloc, int maxAlloc, int shards):
+	_blockSize(blockSize),
+	_maxAlloc(maxAlloc),
+	_allocated(preAlloc),
+	_nShards(shards),
+	_shards(0)
+{
+	poco_assert (maxAlloc == 0 || maxAlloc >= preAlloc);
+	poco_assert (preAlloc >= 0 && maxAlloc >= 0 && shards >= 0);
+
+	if (_nShards == 0)
+		_nShards = 2*static_cast<int>(Environment::processorCount());
+	if (_nShards < 1)
+		_nShards = 1;
+
+	_shards = new Shard[_nShards];
+	for (int i = 0; i < _nShards; ++i)
+	{
+		_shards[i].blocks.reserve(2*BATCH_SIZE);
+	}
+	_depot.reserve(preAlloc > BATCH_SIZE ? preAlloc : BATCH_SIZE);
+	for (int i = 0; i < preAlloc; ++i)
+	{
+		_depot.push_back(new char[_blockSize]);
+	}
+}
+
+
+ShardedMemoryPool::~ShardedMemoryPool()
+{
+	for (int i = 0; i < _nShards; ++i)
+	{
+		for (BlockVec::iterator it = _shards[i].blocks.begin(); it != _shards[i].blocks.end(); ++it)
+		{
+			delete [] *it;
+		}
+	}
+	delete [] _shards;
+	for (BlockVec::iterator it = _depot.begin(); it != _depot.end(); ++it)
+	{
+		delete [] *it;
+	}
+}
+
+
+void* ShardedMemoryPool::get()
+{
+	Shard& s = shard();
+	FastMutex::ScopedLock lock(s.mutex);
+
+	if (s.blocks.empty())
+	{
+		char* ptr = refill(s);
+		if (ptr) return ptr;
+		ptr = steal(s);
+		if (ptr) return ptr;
+		throw OutOfMemoryException("ShardedMemoryPool exhausted");
+	}
+	else
+	{
+		char* ptr = s.blocks.back();
+		s.blocks.pop_back();
+		return ptr;
+	}
+}
+
+
+void ShardedMemoryPool::release(void* ptr)
+{
+	Shard& s = shard();
+	FastMutex::ScopedLock lock(s.mutex);
+
+	s.blocks.push_back(reinterpret_cast<char*>(ptr));
+	if (s.blocks.size() > 2*BATCH_SIZE)
+	{
+		drain(s);
+	}
+}
+
+
+int ShardedMemoryPool::available() const
+{
+	int n = 0;
+	for (int i = 0; i < _nShards; ++i)
+	{
+		FastMutex::ScopedLock lock(_shards[i].mutex);
+		n += static_cast<int>(_shards[i].blocks.size());
+	}
+	FastMutex::ScopedLock lock(_depotMutex);
+	return n + static_cast<int>(_depot.size());
+}
+
+
+ShardedMemoryPool::Shard& ShardedMemoryPool::shard()
+{
+	Thread* pThread = Thread::current();
+	if (pThread)
+		return _shards[pThread->id() % _nShards];
+	else
+		return _shards[0];
+}
+
+
+char* ShardedMemoryPool::refill(Shard& s)
+{
+	// The shard's mutex is held by the caller.
+	{
+		FastMutex::ScopedLock lock(_depotMutex);
+
+		if (!_depot.empty())
+		{
+			std::size_t n = _depot.size() > BATCH_SIZE ? BATCH_SIZE : _depot.size();
+			s.blocks.insert(s.blocks.end(), _depot.end() - n, _depot.end());
+			_depot.resize(_depot.size() - n);
+			char* ptr = s.blocks.back();
+			s.blocks.pop_back();
+			return ptr;
+		}
+		if (_maxAlloc != 0 && _allocated.value() >= _maxAlloc) return 0;
+		++_allocated;
+	}
+	// The block is allocated without holding the depot's
+	// mutex, so that other shards can use the depot meanwhile.
+	try
+	{
+		return new char[_blockSize];
+	}
+	catch (...)
+	{
+		--_allocated;
+		throw;
+	}
+}
+
+
+void ShardedMemoryPool::drain(Shard& s)
+{
+	// The shard's mutex is held by the caller.
+	FastMutex::ScopedLock lock(_depotMutex);
+
+	_depot.insert(_depot.end(), s.blocks.end() - BATCH_SIZE, s.blocks.end());
+	s.blocks.resize(s.blocks.size() - BATCH_SIZE);
+}
+
+
+char* ShardedMemoryPool::steal(const Shard& except)
+{
+	// The mutex of the shard given in except is held by the caller.
+	// To avoid a deadlock with another thread stealing from that
+	// shard at the same time, other shards' mutexes are only tried.
+	for (int i = 0; i < _nShards; ++i)
+	{
+		Shard& s = _shards[i];
+		if (&s != &except && s.mutex.tryLock())
+		{
+			char* ptr = 0;
+			if (!s.blocks.empty())
+			{
+				ptr = s.blocks.back();
+				s.blocks.pop_back();
+			}
+			s.mutex.unlock();
+			if (ptr) return ptr;
+		}
+	}
+	return 0;
+}
+
+
+} // namespace Poco
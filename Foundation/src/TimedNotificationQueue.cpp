@@ -42,7 +42,16 @@
 namespace Poco {
 
 
-TimedNotificationQueue::TimedNotificationQueue()
+TimedNotificationQueue::TimedNotificationQueue():
+	_pWheel(0),
+	_urgent(0)
+{
+}
+
+
+TimedNotificationQueue::TimedNotificationQueue(Timestamp::TimeDiff resolution):
+	_pWheel(new TimingWheel(resolution)),
+	_urgent(0)
 {
 }
 
@@ -50,6 +59,7 @@ TimedNotificationQueue::TimedNotificationQueue()
 TimedNotificationQueue::~TimedNotificationQueue()
 {
 	clear();
+	delete _pWheel;
 }
 
 
@@ -58,13 +68,31 @@ void TimedNotificationQueue::enqueueNotification(Notification::Ptr pNotification
 	poco_check_ptr (pNotification);
 
 	FastMutex::ScopedLock lock(_mutex);
-	_nfQueue.insert(NfQueue::value_type(timestamp, pNotification));
+	if (_pWheel && timestamp.epochMicroseconds() <= 0)
+	{
+		// dequeued before everything else, like in the multimap
+		_ready.insert(_ready.begin() + _urgent, pNotification);
+		++_urgent;
+	}
+	else if (_pWheel)
+	{
+		WheelEntry* pEntry = new WheelEntry;
+		pEntry->pNf = pNotification;
+		_pWheel->schedule(*pEntry, timestamp);
+	}
+	else _nfQueue.insert(NfQueue::value_type(timestamp, pNotification));
 	_nfAvailable.set();
 }
 
 
 Notification* TimedNotificationQueue::dequeueNotification()
 {
+	if (_pWheel)
+	{
+		Timestamp::TimeDiff sleep;
+		return dequeueDue(sleep).duplicate();
+	}
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	NfQueue::iterator it = _nfQueue.begin();
@@ -84,6 +112,20 @@ Notification* TimedNotificationQueue::dequeueNotification()
 
 Notification* TimedNotificationQueue::waitDequeueNotification()
 {
+	if (_pWheel)
+	{
+		for (;;)
+		{
+			Timestamp::TimeDiff sleep;
+			Notification::Ptr pNf = dequeueDue(sleep);
+			if (pNf) return pNf.duplicate();
+			if (sleep < 0)
+				_nfAvailable.wait();
+			else
+				wait(sleep);
+		}
+	}
+
 	for (;;)
 	{
 		_mutex.lock();
@@ -113,6 +155,22 @@ Notification* TimedNotificationQueue::waitDequeueNotification()
 
 Notification* TimedNotificationQueue::waitDequeueNotification(long milliseconds)
 {
+	if (_pWheel)
+	{
+		Timestamp start;
+		Timestamp::TimeDiff remaining = 1000*Timestamp::TimeDiff(milliseconds);
+		for (;;)
+		{
+			Timestamp::TimeDiff sleep;
+			Notification::Ptr pNf = dequeueDue(sleep);
+			if (pNf) return pNf.duplicate();
+			if (remaining <= 0) return 0;
+			if (sleep < 0 || sleep > remaining) sleep = remaining;
+			wait(sleep);
+			remaining = 1000*Timestamp::TimeDiff(milliseconds) - start.elapsed();
+		}
+	}
+
 	while (milliseconds >= 0)
 	{
 		_mutex.lock();
@@ -173,20 +231,27 @@ bool TimedNotificationQueue::wait(Timestamp::TimeDiff interval)
 bool TimedNotificationQueue::empty() const
 {
 	FastMutex::ScopedLock lock(_mutex);
-	return _nfQueue.empty();
+	if (_pWheel)
+		return _ready.empty() && _pWheel->empty();
+	else
+		return _nfQueue.empty();
 }
 
 	
 int TimedNotificationQueue::size() const
 {
 	FastMutex::ScopedLock lock(_mutex);
-	return static_cast<int>(_nfQueue.size());
+	if (_pWheel)
+		return static_cast<int>(_ready.size() + _pWheel->size());
+	else
+		return static_cast<int>(_nfQueue.size());
 }
 
 
 void TimedNotificationQueue::clear()
 {
 	FastMutex::ScopedLock lock(_mutex);
+	if (_pWheel) clearWheel();
 	_nfQueue.clear();	
 }
 
@@ -200,4 +265,52 @@ Notification::Ptr TimedNotificationQueue::dequeueOne(NfQueue::iterator& it)
 }
 
 
+Notification::Ptr TimedNotificationQueue::dequeueDue(Timestamp::TimeDiff& sleep)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	Notification::Ptr pNf;
+	if (_ready.empty() && !_pWheel->empty())
+	{
+		// move all notifications that became due in one batch
+		TimingWheel::EntryVec expired;
+		Timestamp now;
+		_pWheel->advance(now, expired);
+		for (TimingWheel::EntryVec::iterator it = expired.begin(); it != expired.end(); ++it)
+		{
+			WheelEntry* pEntry = static_cast<WheelEntry*>(*it);
+			_ready.push_back(pEntry->pNf);
+			delete pEntry;
+		}
+		Timestamp next;
+		if (_ready.empty() && _pWheel->nextExpiration(next))
+			sleep = next > now ? next - now : 0;
+		else
+			sleep = 0;
+	}
+	else sleep = -1;
+
+	if (!_ready.empty())
+	{
+		pNf = _ready.front();
+		_ready.pop_front();
+		if (_urgent > 0) --_urgent;
+	}
+	return pNf;
+}
+
+
+void TimedNotificationQueue::clearWheel()
+{
+	TimingWheel::EntryVec entries;
+	_pWheel->clear(entries);
+	for (TimingWheel::EntryVec::iterator it = entries.begin(); it != entries.end(); ++it)
+	{
+		delete static_cast<WheelEntry*>(*it);
+	}
+	_ready.clear();
+	_urgent = 0;
+}
+
+
 } // namespace Poco
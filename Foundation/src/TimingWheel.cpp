@@ -0,0 +1,313 @@
+//
+// TimingWheel.cpp
+//
+// $Id: //poco/1.4/Foundation/src/TimingWheel.cpp#1 $
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  TimingWheel
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/TimingWheel.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+TimingWheel::Entry::Entry():
+	_pWheel(0),
+	_pPrev(0),
+	_pNext(0),
+	_pSlot(0),
+	_tick(0),
+	_time(0)
+{
+}
+
+
+TimingWheel::Entry::~Entry()
+{
+	if (_pWheel) _pWheel->cancel(*this);
+}
+
+
+TimingWheel::TimingWheel(Timestamp::TimeDiff resolution):
+	_resolution(resolution),
+	_current(0),
+	_size(0)
+{
+	if (resolution <= 0) throw InvalidArgumentException("TimingWheel resolution must be > 0");
+
+	for (int i = 0; i < SLOTS; ++i) _slots[i] = 0;
+}
+
+
+TimingWheel::~TimingWheel()
+{
+	clear();
+}
+
+
+void TimingWheel::schedule(Entry& entry, const Timestamp& time)
+{
+	if (entry._pWheel == this)
+	{
+		unlink(entry);
+		--_size;
+	}
+	else if (entry._pWheel)
+	{
+		entry._pWheel->cancel(entry);
+	}
+	entry._time = time;
+	entry._tick = tickOf(time);
+	insert(entry);
+	entry._pWheel = this;
+	++_size;
+}
+
+
+void TimingWheel::cancel(Entry& entry)
+{
+	if (entry._pWheel == this)
+	{
+		unlink(entry);
+		entry._pWheel = 0;
+		--_size;
+	}
+}
+
+
+std::size_t TimingWheel::advance(const Timestamp& now, EntryVec& expired)
+{
+	Int64 target = (now - _start)/_resolution;
+	std::size_t n = 0;
+	while (_current < target && _size > 0)
+	{
+		if (!_slots[(_current + 1) & ROOT_MASK])
+		{
+			// skip the ticks in which nothing happens
+			Int64 next = nextTick();
+			if (next > target) break;
+			_current = next - 1;
+		}
+		Int64 tick = _current + 1;
+		if ((tick & ROOT_MASK) == 0) cascade(tick);
+		_current = tick;
+
+		Entry** pSlot = &_slots[tick & ROOT_MASK];
+		while (*pSlot)
+		{
+			Entry* pEntry = *pSlot;
+			unlink(*pEntry);
+			pEntry->_pWheel = 0;
+			--_size;
+			expired.push_back(pEntry);
+			++n;
+		}
+	}
+	if (_current < target) _current = target;
+	return n;
+}
+
+
+bool TimingWheel::nextExpiration(Timestamp& time) const
+{
+	if (_size == 0) return false;
+
+	time = timeOf(nextTick());
+	return true;
+}
+
+
+Int64 TimingWheel::nextTick() const
+{
+	// Every entry in the inner wheel expires exactly at the tick of
+	// its slot, every entry in an outer wheel not before the first
+	// tick covered by its slot. The earliest of these is the answer.
+	Int64 next = 0;
+	bool found = false;
+	for (int i = 0; i < ROOT_SIZE; ++i)
+	{
+		Int64 tick = _current + 1 + i;
+		if (_slots[tick & ROOT_MASK])
+		{
+			next = tick;
+			found = true;
+			break;
+		}
+	}
+	int shift = ROOT_BITS;
+	for (int level = 0; level < LEVELS; ++level, shift += LEVEL_BITS)
+	{
+		Entry* const* slots = _slots + ROOT_SIZE + level*LEVEL_SIZE;
+		Int64 block = _current >> shift;
+		for (int i = 1; i <= LEVEL_SIZE; ++i)
+		{
+			// the slot of the current block holds the
+			// entries of the block one revolution later
+			if (slots[(block + i) & LEVEL_MASK])
+			{
+				Int64 tick = (block + i) << shift;
+				if (!found || tick < next)
+				{
+					next = tick;
+					found = true;
+				}
+				break;
+			}
+		}
+	}
+	poco_assert_dbg (found);
+
+	return next;
+}
+
+
+void TimingWheel::clear()
+{
+	EntryVec cancelled;
+	clear(cancelled);
+}
+
+
+void TimingWheel::clear(EntryVec& cancelled)
+{
+	cancelled.reserve(cancelled.size() + _size);
+	for (int i = 0; i < SLOTS; ++i)
+	{
+		Entry* pEntry = _slots[i];
+		while (pEntry)
+		{
+			Entry* pNext = pEntry->_pNext;
+			pEntry->_pWheel = 0;
+			pEntry->_pPrev  = 0;
+			pEntry->_pNext  = 0;
+			pEntry->_pSlot  = 0;
+			cancelled.push_back(pEntry);
+			pEntry = pNext;
+		}
+		_slots[i] = 0;
+	}
+	_size = 0;
+}
+
+
+Int64 TimingWheel::tickOf(const Timestamp& time) const
+{
+	// round up, so that an entry never expires early
+	Timestamp::TimeDiff diff = time - _start;
+	if (diff <= 0)
+		return 0;
+	else
+		return (diff + _resolution - 1)/_resolution;
+}
+
+
+Timestamp TimingWheel::timeOf(Int64 tick) const
+{
+	return _start + tick*_resolution;
+}
+
+
+void TimingWheel::insert(Entry& entry)
+{
+	// Entries are placed relative to the next tick to be processed.
+	// This is also the tick being cascaded, if called from cascade().
+	Int64 base = _current + 1;
+	if (entry._tick < base) entry._tick = base;
+
+	Int64 tick  = entry._tick;
+	Int64 delta = tick - base;
+	Entry** pSlot;
+	if (delta < ROOT_SIZE)
+	{
+		pSlot = &_slots[tick & ROOT_MASK];
+	}
+	else
+	{
+		int level = 0;
+		int shift = ROOT_BITS;
+		while (level < LEVELS - 1 && delta >= (Int64(1) << (shift + LEVEL_BITS)))
+		{
+			++level;
+			shift += LEVEL_BITS;
+		}
+		// entries beyond the range of the outermost wheel
+		// are kept in its last slot and cascaded again later
+		Int64 range = Int64(1) << (shift + LEVEL_BITS);
+		if (delta >= range) tick = base + range - 1;
+		pSlot = &_slots[ROOT_SIZE + level*LEVEL_SIZE + ((tick >> shift) & LEVEL_MASK)];
+	}
+	entry._pSlot = pSlot;
+	entry._pPrev = 0;
+	entry._pNext = *pSlot;
+	if (*pSlot) (*pSlot)->_pPrev = &entry;
+	*pSlot = &entry;
+}
+
+
+void TimingWheel::unlink(Entry& entry)
+{
+	if (entry._pPrev)
+		entry._pPrev->_pNext = entry._pNext;
+	else
+		*entry._pSlot = entry._pNext;
+	if (entry._pNext)
+		entry._pNext->_pPrev = entry._pPrev;
+	entry._pPrev = 0;
+	entry._pNext = 0;
+	entry._pSlot = 0;
+}
+
+
+void TimingWheel::cascade(Int64 tick)
+{
+	// Called before _current is advanced to tick, so that
+	// the entries are distributed relative to the previous tick.
+	int shift = ROOT_BITS;
+	for (int level = 0; level < LEVELS; ++level, shift += LEVEL_BITS)
+	{
+		int index = static_cast<int>((tick >> shift) & LEVEL_MASK);
+		Entry** pSlot = &_slots[ROOT_SIZE + level*LEVEL_SIZE + index];
+		Entry* pEntry = *pSlot;
+		*pSlot = 0;
+		while (pEntry)
+		{
+			Entry* pNext = pEntry->_pNext;
+			insert(*pEntry);
+			pEntry = pNext;
+		}
+		if (index != 0) break;
+	}
+}
+
+
+} // namespace Poco
@@ -0,0 +1,447 @@
+//
+// WorkStealingThreadPool.cpp
+//
+// $Id: //poco/1.4/Foundation/src/WorkStealingThreadPool.cpp#1 $
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingThreadPool
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/Runnable.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Environment.h"
+#include "Poco/Exception.h"
+#include <sstream>
+#include <limits>
+
+
+namespace Poco {
+
+
+class WorkStealingWorker: public Runnable
+{
+public:
+	WorkStealingWorker(WorkStealingThreadPool& pool, int index, const std::string& name, int stackSize);
+	~WorkStealingWorker();
+
+	void start();
+	void join();
+	void push(Runnable* pTarget);
+	Runnable* pop();
+	Runnable* steal();
+	const Thread& thread() const;
+	void run();
+
+private:
+	typedef std::deque<Runnable*> TaskDeque;
+
+	WorkStealingThreadPool& _pool;
+	int                     _index;
+	Thread                  _thread;
+	TaskDeque               _tasks;
+	FastMutex               _mutex;
+};
+
+
+WorkStealingWorker::WorkStealingWorker(WorkStealingThreadPool& pool, int index, const std::string& name, int stackSize):
+	_pool(pool),
+	_index(index),
+	_thread(name)
+{
+	poco_assert_dbg (stackSize >= 0);
+	_thread.setStackSize(stackSize);
+}
+
+
+WorkStealingWorker::~WorkStealingWorker()
+{
+}
+
+
+void WorkStealingWorker::start()
+{
+	_thread.start(*this);
+}
+
+
+void WorkStealingWorker::join()
+{
+	_thread.join();
+}
+
+
+void WorkStealingWorker::push(Runnable* pTarget)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_tasks.push_back(pTarget);
+}
+
+
+Runnable* WorkStealingWorker::pop()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_tasks.empty()) return 0;
+	Runnable* pTarget = _tasks.back();
+	_tasks.pop_back();
+	return pTarget;
+}
+
+
+Runnable* WorkStealingWorker::steal()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_tasks.empty()) return 0;
+	Runnable* pTarget = _tasks.front();
+	_tasks.pop_front();
+	return pTarget;
+}
+
+
+inline const Thread& WorkStealingWorker::thread() const
+{
+	return _thread;
+}
+
+
+void WorkStealingWorker::run()
+{
+	_pool.work(_index);
+}
+
+
+WorkStealingThreadPool::WorkStealingThreadPool(int threads, int stackSize):
+	_firstThreadId(0),
+	_workAvailable(0, std::numeric_limits<int>::max()),
+	_allDone(false),
+	_stopped(false)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingThreadPool::WorkStealingThreadPool(const std::string& name, int threads, int stackSize):
+	_name(name),
+	_firstThreadId(0),
+	_workAvailable(0, std::numeric_limits<int>::max()),
+	_allDone(false),
+	_stopped(false)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+	try
+	{
+		stopAll();
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+}
+
+
+void WorkStealingThreadPool::init(int threads, int stackSize)
+{
+	poco_assert (threads >= 0);
+
+	if (threads == 0)
+		threads = static_cast<int>(Environment::processorCount());
+	if (threads < 1)
+		threads = 1;
+
+	_allDone.set();
+	_workers.reserve(threads);
+	for (int i = 0; i < threads; ++i)
+	{
+		std::ostringstream name;
+		name << _name << "[#" << i + 1 << "]";
+		_workers.push_back(new WorkStealingWorker(*this, i, name.str(), stackSize));
+	}
+	// Thread IDs are handed out in ascending order, so the workers'
+	// IDs form a narrow range (with gaps only for threads created
+	// concurrently by others) that currentWorker() can index directly.
+	_firstThreadId = _workers.front()->thread().id();
+	int lastThreadId = _workers.back()->thread().id();
+	_workersById.resize(lastThreadId - _firstThreadId + 1, 0);
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		_workersById[(*it)->thread().id() - _firstThreadId] = *it;
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->start();
+	}
+}
+
+
+void WorkStealingThreadPool::start(Runnable& target)
+{
+	// The read lock keeps stopAll() from setting _stopped (and
+	// from tearing down _workers) until the task has been queued
+	// and counted in _pending, so a worker never parks for good
+	// while work it should run is still queued.
+	ScopedReadRWLock stateLock(_stateLock);
+
+	if (_stopped) throw IllegalStateException("WorkStealingThreadPool has been stopped");
+
+	if (++_outstanding == 1)
+	{
+		FastMutex::ScopedLock lock(_doneMutex);
+		if (_outstanding.value() > 0) _allDone.reset();
+	}
+
+	WorkStealingWorker* pWorker = currentWorker();
+	if (pWorker)
+	{
+		pWorker->push(&target);
+	}
+	else
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		_queue.push_back(&target);
+	}
+	++_pending;
+	wakeUpOne();
+}
+
+
+void WorkStealingThreadPool::joinAll()
+{
+	while (_outstanding.value() > 0)
+	{
+		_allDone.wait();
+	}
+}
+
+
+void WorkStealingThreadPool::stopAll()
+{
+	FastMutex::ScopedLock stopLock(_stopMutex);
+
+	if (_workers.empty()) return;
+
+	int n;
+	{
+		ScopedWriteRWLock stateLock(_stateLock);
+		FastMutex::ScopedLock lock(_idleMutex);
+		_stopped = true;
+		n = _idle.value();
+		_idle = 0;
+	}
+	for (int i = 0; i < n; ++i)
+	{
+		_workAvailable.set();
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->join();
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		delete *it;
+	}
+	_workers.clear();
+	_workersById.clear();
+}
+
+
+void WorkStealingThreadPool::work(int index)
+{
+	WorkStealingWorker* pWorker = _workers[index];
+	for (;;)
+	{
+		Runnable* pTarget = pWorker->pop();
+		if (!pTarget) pTarget = dequeue();
+		if (!pTarget) pTarget = steal(index);
+		if (pTarget)
+		{
+			--_pending;
+			runTarget(pTarget);
+		}
+		else if (!park()) break;
+	}
+}
+
+
+Runnable* WorkStealingThreadPool::steal(int index)
+{
+	int n = static_cast<int>(_workers.size());
+	for (int i = 1; i < n; ++i)
+	{
+		Runnable* pTarget = _workers[(index + i) % n]->steal();
+		if (pTarget) return pTarget;
+	}
+	return 0;
+}
+
+
+Runnable* WorkStealingThreadPool::dequeue()
+{
+	FastMutex::ScopedLock lock(_queueMutex);
+
+	if (_queue.empty()) return 0;
+	Runnable* pTarget = _queue.front();
+	_queue.pop_front();
+	return pTarget;
+}
+
+
+bool WorkStealingThreadPool::park()
+{
+	// start() increments _pending before it looks at _idle, and
+	// a worker increments _idle before it looks at _pending, so
+	// either the worker sees the new work, or start() sees
+	// the worker and wakes it up.
+	{
+		FastMutex::ScopedLock lock(_idleMutex);
+		++_idle;
+		if (_pending.value() > 0)
+		{
+			--_idle;
+			return true;
+		}
+		if (_stopped)
+		{
+			--_idle;
+			return false;
+		}
+	}
+	_workAvailable.wait();
+	return true;
+}
+
+
+void WorkStealingThreadPool::wakeUpOne()
+{
+	if (_idle.value() > 0)
+	{
+		FastMutex::ScopedLock lock(_idleMutex);
+		if (_idle.value() > 0)
+		{
+			--_idle;
+			_workAvailable.set();
+		}
+	}
+}
+
+
+void WorkStealingThreadPool::runTarget(Runnable* pTarget)
+{
+	try
+	{
+		pTarget->run();
+	}
+	catch (Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+	ThreadLocalStorage::clear();
+
+	if (--_outstanding == 0)
+	{
+		FastMutex::ScopedLock lock(_doneMutex);
+		if (_outstanding.value() == 0) _allDone.set();
+	}
+}
+
+
+WorkStealingWorker* WorkStealingThreadPool::currentWorker() const
+{
+	Thread* pThread = Thread::current();
+	if (pThread)
+	{
+		std::size_t i = static_cast<std::size_t>(pThread->id() - _firstThreadId);
+		if (i < _workersById.size())
+		{
+			WorkStealingWorker* pWorker = _workersById[i];
+			if (pWorker && &pWorker->thread() == pThread) return pWorker;
+		}
+	}
+	return 0;
+}
+
+
+class WorkStealingThreadPoolSingletonHolder
+{
+public:
+	WorkStealingThreadPoolSingletonHolder()
+	{
+		_pPool = 0;
+	}
+	~WorkStealingThreadPoolSingletonHolder()
+	{
+		delete _pPool;
+	}
+	WorkStealingThreadPool* pool()
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (!_pPool)
+		{
+			_pPool = new WorkStealingThreadPool("default");
+		}
+		return _pPool;
+	}
+
+private:
+	WorkStealingThreadPool* _pPool;
+	FastMutex               _mutex;
+};
+
+
+namespace
+{
+	static WorkStealingThreadPoolSingletonHolder sh;
+}
+
+
+WorkStealingThreadPool& WorkStealingThreadPool::defaultPool()
+{
+	return *sh.pool();
+}
+
+
+} // namespace Poco
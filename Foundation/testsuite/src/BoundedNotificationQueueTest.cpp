@@ -0,0 +1,488 @@
+//
+// BoundedNotificationQueueTest.cpp
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/BoundedNotificationQueueTest.cpp#1 $
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "BoundedNotificationQueueTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/NotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+#include <vector>
+#include <iostream>
+
+
+using Poco::BoundedNotificationQueue;
+using Poco::NotificationQueue;
+using Poco::Notification;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::RunnableAdapter;
+using Poco::AtomicCounter;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class QTestNotification: public Notification
+	{
+	public:
+		QTestNotification(const std::string& data): _data(data)
+		{
+		}
+		~QTestNotification()
+		{
+		}
+		const std::string& data() const
+		{
+			return _data;
+		}
+
+	private:
+		std::string _data;
+	};
+
+	class Enqueuer: public Runnable
+	{
+	public:
+		Enqueuer(BoundedNotificationQueue& queue, const std::string& data):
+			_queue(queue),
+			_data(data),
+			_done(false)
+		{
+		}
+
+		void run()
+		{
+			_queue.enqueueNotification(new QTestNotification(_data));
+			_done = true;
+		}
+
+		bool done() const
+		{
+			return _done;
+		}
+
+	private:
+		BoundedNotificationQueue& _queue;
+		std::string _data;
+		volatile bool _done;
+	};
+
+	template <class Q>
+	class Producer: public Runnable
+	{
+	public:
+		Producer(Q& queue, int count):
+			_queue(queue),
+			_count(count)
+		{
+		}
+
+		void run()
+		{
+			Notification::Ptr pNf = new Notification;
+			for (int i = 0; i < _count; ++i)
+			{
+				_queue.enqueueNotification(pNf);
+			}
+		}
+
+	private:
+		Q& _queue;
+		int _count;
+	};
+
+	template <class Q>
+	class Consumer: public Runnable
+	{
+	public:
+		Consumer(Q& queue, AtomicCounter& counter):
+			_queue(queue),
+			_counter(counter)
+		{
+		}
+
+		void run()
+		{
+			Notification* pNf = _queue.waitDequeueNotification();
+			while (pNf)
+			{
+				pNf->release();
+				++_counter;
+				pNf = _queue.waitDequeueNotification();
+			}
+		}
+
+	private:
+		Q& _queue;
+		AtomicCounter& _counter;
+	};
+
+	template <class Q>
+	Poco::Timestamp::TimeDiff runProducersConsumers(Q& queue, int nProducers, int nConsumers, int count)
+	{
+		AtomicCounter counter;
+		std::vector<Thread*> threads;
+		std::vector<Runnable*> runnables;
+		for (int i = 0; i < nConsumers; ++i)
+		{
+			threads.push_back(new Thread);
+			runnables.push_back(new Consumer<Q>(queue, counter));
+		}
+		for (int i = 0; i < nProducers; ++i)
+		{
+			threads.push_back(new Thread);
+			runnables.push_back(new Producer<Q>(queue, count/nProducers));
+		}
+		Stopwatch sw;
+		sw.start();
+		for (std::size_t i = 0; i < threads.size(); ++i)
+		{
+			threads[i]->start(*runnables[i]);
+		}
+		for (std::size_t i = nConsumers; i < threads.size(); ++i)
+		{
+			threads[i]->join();
+		}
+		while (counter.value() < (count/nProducers)*nProducers) Thread::yield();
+		sw.stop();
+		for (int i = 0; i < nConsumers; ++i)
+		{
+			while (!threads[i]->tryJoin(10)) queue.wakeUpAll();
+		}
+		for (std::size_t i = 0; i < threads.size(); ++i)
+		{
+			delete threads[i];
+			delete runnables[i];
+		}
+		return sw.elapsed();
+	}
+}
+
+
+BoundedNotificationQueueTest::BoundedNotificationQueueTest(const std::string& name):
+	CppUnit::TestCase(name),
+	_queue(64)
+{
+}
+
+
+BoundedNotificationQueueTest::~BoundedNotificationQueueTest()
+{
+}
+
+
+void BoundedNotificationQueueTest::testQueueDequeue()
+{
+	BoundedNotificationQueue queue(4);
+	assert (queue.empty());
+	assert (queue.size() == 0);
+	assert (queue.capacity() == 4);
+	Notification* pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+	queue.enqueueNotification(new Notification);
+	assert (!queue.empty());
+	assert (queue.size() == 1);
+	pNf = queue.dequeueNotification();
+	assertNotNullPtr(pNf);
+	assert (queue.empty());
+	assert (queue.size() == 0);
+	pNf->release();
+
+	// wrap around the end of the ring buffer
+	for (int i = 0; i < 10; ++i)
+	{
+		queue.enqueueNotification(new QTestNotification("first"));
+		queue.enqueueNotification(new QTestNotification("second"));
+		assert (!queue.empty());
+		assert (queue.size() == 2);
+		QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+		assertNotNullPtr(pTNf);
+		assert (pTNf->data() == "first");
+		pTNf->release();
+		assert (!queue.empty());
+		assert (queue.size() == 1);
+		pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+		assertNotNullPtr(pTNf);
+		assert (pTNf->data() == "second");
+		pTNf->release();
+		assert (queue.empty());
+		assert (queue.size() == 0);
+	}
+
+	pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+}
+
+
+void BoundedNotificationQueueTest::testQueueDequeueUrgent()
+{
+	BoundedNotificationQueue queue(3);
+	queue.enqueueNotification(new QTestNotification("first"));
+	queue.enqueueNotification(new QTestNotification("second"));
+	queue.enqueueUrgentNotification(new QTestNotification("third"));
+	assert (!queue.empty());
+	assert (queue.size() == 3);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "third");
+	pTNf->release();
+	assert (!queue.empty());
+	assert (queue.size() == 2);
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assert (pTNf->data() == "first");
+	pTNf->release();
+	assert (!queue.empty());
+	assert (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "second");
+	pTNf->release();
+	assert (queue.empty());
+	assert (queue.size() == 0);
+
+	Notification* pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+}
+
+
+void BoundedNotificationQueueTest::testWaitDequeue()
+{
+	BoundedNotificationQueue queue;
+	queue.enqueueNotification(new QTestNotification("third"));
+	queue.enqueueNotification(new QTestNotification("fourth"));
+	assert (!queue.empty());
+	assert (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "third");
+	pTNf->release();
+	assert (!queue.empty());
+	assert (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "fourth");
+	pTNf->release();
+	assert (queue.empty());
+	assert (queue.size() == 0);
+
+	Notification* pNf = queue.waitDequeueNotification(10);
+	assertNullPtr(pNf);
+	assert (!queue.hasIdleThreads());
+}
+
+
+void BoundedNotificationQueueTest::testFull()
+{
+	BoundedNotificationQueue queue(2);
+	queue.enqueueNotification(new QTestNotification("first"));
+	queue.enqueueNotification(new QTestNotification("second"));
+	assert (queue.size() == 2);
+
+	Enqueuer enqueuer(queue, "third");
+	Thread thread;
+	thread.start(enqueuer);
+	Thread::sleep(100);
+	assert (!enqueuer.done());
+	assert (queue.size() == 2);
+
+	Notification::Ptr pNf = queue.dequeueNotification();
+	thread.join();
+	assert (enqueuer.done());
+	assert (queue.size() == 2);
+
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assert (pTNf->data() == "second");
+	pTNf->release();
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assert (pTNf->data() == "third");
+	pTNf->release();
+	assert (queue.empty());
+}
+
+
+void BoundedNotificationQueueTest::testThreads()
+{
+	const int NOTIFICATION_COUNT = 5000;
+
+	Thread t1("thread1");
+	Thread t2("thread2");
+	Thread t3("thread3");
+
+	RunnableAdapter<BoundedNotificationQueueTest> ra(*this, &BoundedNotificationQueueTest::work);
+	t1.start(ra);
+	t2.start(ra);
+	t3.start(ra);
+	for (int i = 0; i < NOTIFICATION_COUNT; ++i)
+	{
+		_queue.enqueueNotification(new Notification);
+	}
+	while (!_queue.empty()) Thread::sleep(50);
+	Thread::sleep(20);
+	_queue.wakeUpAll();
+	t1.join();
+	t2.join();
+	t3.join();
+	assert (_handled.size() == NOTIFICATION_COUNT);
+	assert (_handled.count("thread1") > 0);
+	assert (_handled.count("thread2") > 0);
+	assert (_handled.count("thread3") > 0);
+}
+
+
+void BoundedNotificationQueueTest::testWakeUpAll()
+{
+	BoundedNotificationQueue queue;
+	AtomicCounter counter;
+	Consumer<BoundedNotificationQueue> consumer(queue, counter);
+	Thread t1;
+	Thread t2;
+	t1.start(consumer);
+	t2.start(consumer);
+	while (!queue.hasIdleThreads()) Thread::sleep(10);
+	queue.enqueueNotification(new Notification);
+	while (counter.value() < 1) Thread::sleep(10);
+	Thread::sleep(50);
+	queue.wakeUpAll();
+	t1.join();
+	t2.join();
+	assert (counter.value() == 1);
+	assert (queue.empty());
+	assert (!queue.hasIdleThreads());
+}
+
+
+void BoundedNotificationQueueTest::testProducersConsumers()
+{
+	const int COUNT = 20000;
+	const int THREADS = 3;
+
+	// a tiny queue, so that producers and consumers both wait frequently
+	BoundedNotificationQueue queue(3);
+	AtomicCounter counter;
+	std::vector<Thread*> threads;
+	std::vector<Runnable*> runnables;
+	for (int i = 0; i < THREADS; ++i)
+	{
+		runnables.push_back(new Consumer<BoundedNotificationQueue>(queue, counter));
+		runnables.push_back(new Producer<BoundedNotificationQueue>(queue, COUNT));
+	}
+	for (std::size_t i = 0; i < runnables.size(); ++i)
+	{
+		threads.push_back(new Thread);
+		threads[i]->start(*runnables[i]);
+	}
+	Stopwatch sw;
+	sw.start();
+	while (counter.value() < THREADS*COUNT && sw.elapsedSeconds() < 60) Thread::sleep(10);
+	assert (counter.value() == THREADS*COUNT);
+	assert (queue.empty());
+	for (std::size_t i = 0; i < threads.size(); ++i)
+	{
+		while (!threads[i]->tryJoin(10)) queue.wakeUpAll();
+		delete threads[i];
+		delete runnables[i];
+	}
+	assert (counter.value() == THREADS*COUNT);
+	assert (!queue.hasIdleThreads());
+}
+
+
+void BoundedNotificationQueueTest::testPerformance()
+{
+	const int COUNT = 200000;
+	const int threads[] = {1, 2, 4, 8};
+
+	for (int i = 0; i < sizeof(threads)/sizeof(threads[0]); ++i)
+	{
+		int n = threads[i];
+		NotificationQueue queue;
+		BoundedNotificationQueue boundedQueue(COUNT);
+		Poco::Timestamp::TimeDiff t1 = runProducersConsumers(queue, n, 1, COUNT);
+		Poco::Timestamp::TimeDiff t2 = runProducersConsumers(boundedQueue, n, 1, COUNT);
+		std::cout << "fan-in " << n << ":1: NotificationQueue " << t1/1000 << " ms, BoundedNotificationQueue " << t2/1000 << " ms" << std::endl;
+		t1 = runProducersConsumers(queue, 1, n, COUNT);
+		t2 = runProducersConsumers(boundedQueue, 1, n, COUNT);
+		std::cout << "fan-out 1:" << n << ": NotificationQueue " << t1/1000 << " ms, BoundedNotificationQueue " << t2/1000 << " ms" << std::endl;
+	}
+}
+
+
+void BoundedNotificationQueueTest::setUp()
+{
+	_handled.clear();
+}
+
+
+void BoundedNotificationQueueTest::tearDown()
+{
+}
+
+
+void BoundedNotificationQueueTest::work()
+{
+	Poco::Random rnd;
+	Thread::sleep(50);
+	Notification* pNf = _queue.waitDequeueNotification();
+	while (pNf)
+	{
+		pNf->release();
+		_mutex.lock();
+		_handled.insert(Thread::current()->name());
+		_mutex.unlock();
+		Thread::sleep(rnd.next(5));
+		pNf = _queue.waitDequeueNotification();
+	}
+}
+
+
+CppUnit::Test* BoundedNotificationQueueTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BoundedNotificationQueueTest");
+
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testQueueDequeue);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testQueueDequeueUrgent);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testWaitDequeue);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testFull);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testThreads);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testWakeUpAll);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testProducersConsumers);
+	//CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testPerformance);
+
+	return pSuite;
+}
@@ -0,0 +1,385 @@
+//
+// ConcurrentCacheTest.cpp
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/ConcurrentCacheTest.cpp#1 $
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "ConcurrentCacheTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/ConcurrentLRUCache.h"
+#include "Poco/ConcurrentExpireLRUCache.h"
+#include "Poco/LRUCache.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include <vector>
+#include <iostream>
+
+
+using Poco::ConcurrentLRUCache;
+using Poco::ConcurrentExpireLRUCache;
+using Poco::LRUCache;
+using Poco::SharedPtr;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::Stopwatch;
+
+
+#define DURSLEEP 250
+#define DURWAIT  300
+
+
+namespace
+{
+	template <class Cache>
+	class CacheUser: public Runnable
+	{
+	public:
+		CacheUser(Cache& cache, int keys, int iterations, int seed):
+			_cache(cache),
+			_keys(keys),
+			_iterations(iterations),
+			_seed(seed),
+			_ok(true)
+		{
+		}
+
+		void run()
+		{
+			unsigned r = _seed;
+			for (int i = 0; i < _iterations; ++i)
+			{
+				r = r*1103515245 + 12345;
+				int key = (r >> 8) % _keys;
+				if (i % 4 == 0)
+				{
+					_cache.add(key, key*2);
+				}
+				else
+				{
+					SharedPtr<int> pValue = _cache.get(key);
+					if (pValue && *pValue != key*2) _ok = false;
+				}
+			}
+		}
+
+		bool ok() const
+		{
+			return _ok;
+		}
+
+	private:
+		Cache& _cache;
+		int _keys;
+		int _iterations;
+		int _seed;
+		bool _ok;
+	};
+
+	template <class Cache>
+	Poco::Timestamp::TimeDiff runThreads(Cache& cache, int nThreads, int keys, int iterations)
+	{
+		std::vector<Thread*> threads;
+		std::vector<CacheUser<Cache>*> users;
+		for (int i = 0; i < nThreads; ++i)
+		{
+			threads.push_back(new Thread);
+			users.push_back(new CacheUser<Cache>(cache, keys, iterations, i));
+		}
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < nThreads; ++i)
+		{
+			threads[i]->start(*users[i]);
+		}
+		for (int i = 0; i < nThreads; ++i)
+		{
+			threads[i]->join();
+		}
+		sw.stop();
+		bool ok = true;
+		for (int i = 0; i < nThreads; ++i)
+		{
+			ok = ok && users[i]->ok();
+			delete threads[i];
+			delete users[i];
+		}
+		return ok ? sw.elapsed() : -1;
+	}
+}
+
+
+ConcurrentCacheTest::ConcurrentCacheTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ConcurrentCacheTest::~ConcurrentCacheTest()
+{
+}
+
+
+void ConcurrentCacheTest::testClear()
+{
+	ConcurrentLRUCache<int, int> aCache(3);
+	assert (aCache.size() == 0);
+	assert (aCache.getAllKeys().size() == 0);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	aCache.add(5, 6);
+	assert (aCache.getAllKeys().size() == aCache.size());
+	assert (aCache.has(1) || aCache.has(3) || aCache.has(5));
+	aCache.clear();
+	assert (aCache.size() == 0);
+	assert (!aCache.has(1));
+	assert (!aCache.has(3));
+	assert (!aCache.has(5));
+
+	ConcurrentLRUCache<int, int> singleShard(3, 1);
+	assert (singleShard.shards() == 1);
+	singleShard.add(1, 2);
+	singleShard.add(3, 4);
+	singleShard.add(5, 6);
+	assert (singleShard.size() == 3);
+	assert (*singleShard.get(1) == 2);
+	assert (*singleShard.get(3) == 4);
+	assert (*singleShard.get(5) == 6);
+	singleShard.clear();
+	assert (singleShard.size() == 0);
+	assert (!singleShard.get(1));
+}
+
+
+void ConcurrentCacheTest::testCacheSize0()
+{
+	try
+	{
+		ConcurrentLRUCache<int, int> aCache(0);
+		failmsg ("cache size of 0 is illegal, test should fail");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	
+	try
+	{
+		ConcurrentExpireLRUCache<int, int> aCache(10, 10);
+		failmsg ("expire time below 25 ms is illegal, test should fail");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void ConcurrentCacheTest::testCacheSize2()
+{
+	// same as LRUCacheTest::testCacheSize2(), a single shard
+	// must replace exactly like an LRUCache
+	ConcurrentLRUCache<int, int> aCache(2, 1);
+	aCache.add(1, 2); // 1
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+
+	aCache.add(3, 4); // 3-1
+	assert (aCache.has(1));
+	assert (aCache.has(3));
+	assert (*aCache.get(1) == 2); // 1-3
+	assert (*aCache.get(3) == 4); // 3-1
+
+	aCache.add(5, 6); // 5-3|1
+	assert (!aCache.has(1));
+	assert (aCache.has(3));
+	assert (aCache.has(5));
+	assert (*aCache.get(5) == 6);  // 5-3
+	assert (*aCache.get(3) == 4);  // 3-5
+
+	aCache.remove(5); // 3
+	assert (!aCache.has(5));
+	assert (*aCache.get(3) == 4);  // 3
+
+	aCache.add(5, 6); // 5-3
+	assert (*aCache.get(3) == 4);  // 3-5
+	aCache.remove(3); // 5
+	assert (!aCache.has(3));
+	assert (*aCache.get(5) == 6);  // 5
+
+	// removing illegal entries should work too
+	aCache.remove(666);
+
+	aCache.clear();
+	assert (!aCache.has(5));
+}
+
+
+void ConcurrentCacheTest::testDuplicateAdd()
+{
+	ConcurrentLRUCache<int, int> aCache(3, 1);
+	aCache.add(1, 2); // 1
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+	aCache.add(1, 3);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 3);
+	aCache.update(1, 4);
+	assert (*aCache.get(1) == 4);
+	assert (aCache.size() == 1);
+
+	SharedPtr<int> pValue(new int(5));
+	aCache.update(2, pValue);
+	assert (aCache.get(2) == pValue);
+	assert (aCache.size() == 2);
+}
+
+
+void ConcurrentCacheTest::testShards()
+{
+	ConcurrentLRUCache<int, int> aCache(100, 8);
+	assert (aCache.shards() == 8);
+	for (int i = 0; i < 1000; ++i)
+	{
+		aCache.add(i, i);
+		assert (aCache.size() <= 100);
+	}
+	// with 1000 keys, every shard must have been filled up
+	assert (aCache.size() == 100);
+	std::set<int> keys = aCache.getAllKeys();
+	assert (keys.size() == 100);
+	for (std::set<int>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		assert (*aCache.get(*it) == *it);
+	}
+
+	// no more shards than entries
+	ConcurrentLRUCache<int, int> smallCache(3, 8);
+	assert (smallCache.shards() == 3);
+	
+	ConcurrentLRUCache<std::string, int> stringCache(100);
+	stringCache.add("foo", 1);
+	stringCache.add("bar", 2);
+	assert (*stringCache.get("foo") == 1);
+	assert (*stringCache.get("bar") == 2);
+	assert (!stringCache.has("baz"));
+}
+
+
+void ConcurrentCacheTest::testExpire()
+{
+	ConcurrentExpireLRUCache<int, int> aCache(3, DURSLEEP, 1);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	assert (aCache.has(1));
+	assert (aCache.has(3));
+	Thread::sleep(DURWAIT);
+	assert (!aCache.has(1));
+	assert (!aCache.has(3));
+	assert (!aCache.get(1));
+	assert (aCache.size() == 0);
+
+	// an update restarts the expiration
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	Thread::sleep(DURSLEEP/2);
+	aCache.update(1, 5);
+	Thread::sleep(DURSLEEP/2 + 25);
+	assert (aCache.has(1));
+	assert (!aCache.has(3));
+	assert (*aCache.get(1) == 5);
+	assert (aCache.getAllKeys().size() == 1);
+
+	// expired entries are removed without access
+	Thread::sleep(DURWAIT);
+	aCache.forceReplace();
+	assert (aCache.size() == 0);
+
+	// size limit still applies
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	aCache.add(5, 6);
+	aCache.add(7, 8);
+	assert (aCache.size() == 3);
+	assert (!aCache.has(1));
+}
+
+
+void ConcurrentCacheTest::testConcurrency()
+{
+	ConcurrentLRUCache<int, int> aCache(500, 4);
+	assert (runThreads(aCache, 8, 1000, 20000) >= 0);
+	assert (aCache.size() == 500);
+
+	ConcurrentExpireLRUCache<int, int> expireCache(500, 600000, 4);
+	assert (runThreads(expireCache, 8, 1000, 20000) >= 0);
+	assert (expireCache.size() == 500);
+}
+
+
+void ConcurrentCacheTest::testPerformance()
+{
+	const int ITERATIONS = 1000000;
+	const int KEYS = 100000;
+
+	for (int nThreads = 1; nThreads <= 16; nThreads *= 2)
+	{
+		LRUCache<int, int> cache(KEYS/2);
+		ConcurrentLRUCache<int, int> concurrentCache(KEYS/2);
+		Poco::Timestamp::TimeDiff t1 = runThreads(cache, nThreads, KEYS, ITERATIONS/nThreads);
+		Poco::Timestamp::TimeDiff t2 = runThreads(concurrentCache, nThreads, KEYS, ITERATIONS/nThreads);
+		std::cout << nThreads << " threads: LRUCache " << t1/1000 << " ms, ConcurrentLRUCache " << t2/1000 << " ms" << std::endl;
+	}
+}
+
+
+void ConcurrentCacheTest::setUp()
+{
+}
+
+
+void ConcurrentCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ConcurrentCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ConcurrentCacheTest");
+
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testClear);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testCacheSize0);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testCacheSize2);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testDuplicateAdd);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testShards);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testExpire);
+	CppUnit_addTest(pSuite, ConcurrentCacheTest, testConcurrency);
+	//CppUnit_addTest(pSuite, ConcurrentCacheTest, testPerformance);
+
+	return pSuite;
+}
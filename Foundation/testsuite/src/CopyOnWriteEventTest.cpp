@@ -0,0 +1,459 @@
+//
+// CopyOnWriteEventTest.cpp
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/CopyOnWriteEventTest.cpp#1 $
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "CopyOnWriteEventTest.h"
+#include "DummyDelegate.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Delegate.h"
+#include "Poco/Expire.h"
+#include "Poco/BasicEvent.h"
+#include "Poco/FIFOEvent.h"
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include <iostream>
+
+
+using namespace Poco;
+
+
+#define LARGEINC 100
+
+
+namespace
+{
+	const int NOTIFY_COUNT = 100000;
+
+	class Counter
+	{
+	public:
+		Counter(): n(0)
+		{
+		}
+
+		void onEvent(const void* pSender, int& i)
+		{
+			++n;
+		}
+
+		int n;
+	};
+
+	template <class E>
+	void notifyPerformance(const std::string& name, int delegates)
+	{
+		const int N = 1000000;
+		E event;
+		std::vector<Counter> counters(delegates);
+		for (int i = 0; i < delegates; ++i)
+		{
+			event += delegate(&counters[i], &Counter::onEvent);
+		}
+		int arg = 0;
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < N; ++i)
+		{
+			event.notify(0, arg);
+		}
+		sw.stop();
+		std::cout << name << ", " << delegates << " delegate(s): " << sw.elapsed()/1000 << " ms" << std::endl;
+	}
+}
+
+
+CopyOnWriteEventTest::CopyOnWriteEventTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+CopyOnWriteEventTest::~CopyOnWriteEventTest()
+{
+}
+
+
+void CopyOnWriteEventTest::testNoDelegate()
+{
+	int tmp = 0;
+	EventArgs args;
+
+	assert (_count == 0);
+	assert (Simple.empty());
+	Simple.notify(this, tmp);
+	assert (_count == 0);
+
+	Simple += delegate(this, &CopyOnWriteEventTest::onSimple);
+	assert (!Simple.empty());
+	Simple -= delegate(this, &CopyOnWriteEventTest::onSimple);
+	assert (Simple.empty());
+	Simple.notify(this, tmp);
+	assert (_count == 0);
+	
+	ConstSimple += delegate(this, &CopyOnWriteEventTest::onConstSimple);
+	ConstSimple -= delegate(this, &CopyOnWriteEventTest::onConstSimple);
+	ConstSimple.notify(this, tmp);
+	assert (_count == 0);
+	
+	EventArgs* pArgs = &args;
+	Complex += delegate(this, &CopyOnWriteEventTest::onComplex);
+	Complex -= delegate(this, &CopyOnWriteEventTest::onComplex);
+	Complex.notify(this, pArgs);
+	assert (_count == 0);
+
+	Complex2 += delegate(this, &CopyOnWriteEventTest::onComplex2);
+	Complex2 -= delegate(this, &CopyOnWriteEventTest::onComplex2);
+	Complex2.notify(this, args);
+	assert (_count == 0);
+}
+
+
+void CopyOnWriteEventTest::testSingleDelegate()
+{
+	int tmp = 0;
+	EventArgs args;
+
+	assert (_count == 0);
+
+	Simple += delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+	
+	ConstSimple += delegate(this, &CopyOnWriteEventTest::onConstSimple);
+	ConstSimple.notify(this, tmp);
+	assert (_count == 2);
+	
+	EventArgs* pArgs = &args;
+	Complex += delegate(this, &CopyOnWriteEventTest::onComplex);
+	Complex.notify(this, pArgs);
+	assert (_count == 3);
+
+	Complex2 += delegate(this, &CopyOnWriteEventTest::onComplex2);
+	Complex2.notify(this, args);
+	assert (_count == 4);
+	Complex2(args);
+	assert (_count == 5);
+}
+
+
+void CopyOnWriteEventTest::testDuplicateRegister()
+{
+	int tmp = 0;
+	
+	assert (_count == 0);
+
+	Simple += delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple += delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple.notify(this, tmp);
+	assert (_count == 2);
+	Simple -= delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple.notify(this, tmp);
+	assert (_count == 3);
+}
+
+
+void CopyOnWriteEventTest::testDuplicateUnregister()
+{
+	int tmp = 0;
+	
+	assert (_count == 0);
+
+	Simple -= delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple.notify(this, tmp);
+	assert (_count == 0);
+
+	Simple += delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+
+	Simple -= delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+
+	Simple -= delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+}
+
+
+void CopyOnWriteEventTest::testDisabling()
+{
+	int tmp = 0;
+	
+	assert (_count == 0);
+
+	Simple += delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple.disable();
+	Simple.notify(this, tmp);
+	assert (_count == 0);
+	Simple.enable();
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+
+	Simple.disable();
+	Simple -= delegate(this, &CopyOnWriteEventTest::onSimple);
+	Simple.enable();
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+}
+
+
+void CopyOnWriteEventTest::testFIFOOrder()
+{
+	DummyDelegate o1;
+	DummyDelegate o2;
+
+	Simple += delegate(&o1, &DummyDelegate::onSimple);
+	Simple += delegate(&o2, &DummyDelegate::onSimple2);
+	int tmp = 0;
+	Simple.notify(this, tmp);
+	assert (tmp == 2);
+
+	Simple -= delegate(&o1, &DummyDelegate::onSimple);
+	Simple -= delegate(&o2, &DummyDelegate::onSimple2);
+	
+	// now try with the wrong order
+	Simple += delegate(&o2, &DummyDelegate::onSimple2);
+	Simple += delegate(&o1, &DummyDelegate::onSimple);
+
+	try
+	{
+		tmp = 0;
+		Simple.notify(this, tmp);
+		failmsg ("Notify should not work");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void CopyOnWriteEventTest::testExpire()
+{
+	int tmp = 0;
+	
+	assert (_count == 0);
+
+	Simple += delegate(this, &CopyOnWriteEventTest::onSimple, 500);
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+	Poco::Thread::sleep(700);
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+	Simple -= delegate(this, &CopyOnWriteEventTest::onSimple, 500);
+	assert (Simple.empty());
+}
+
+
+void CopyOnWriteEventTest::testReturnParams()
+{
+	DummyDelegate o1;
+	Simple += delegate(&o1, &DummyDelegate::onSimple);
+
+	int tmp = 0;
+	Simple.notify(this, tmp);
+	assert (tmp == 1);
+}
+
+
+void CopyOnWriteEventTest::testRemoveDuringNotify()
+{
+	int tmp = 0;
+
+	Simple += delegate(this, &CopyOnWriteEventTest::onRemoveOther);
+	Simple += delegate(this, &CopyOnWriteEventTest::onSimpleOther);
+	Simple += delegate(this, &CopyOnWriteEventTest::onSimple);
+
+	// onRemoveOther removes onSimpleOther, which must then no
+	// longer be invoked, even though it is still in the snapshot
+	// being notified.
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+	Simple.notify(this, tmp);
+	assert (_count == 2);
+}
+
+
+void CopyOnWriteEventTest::testConcurrentNotify()
+{
+	Simple += delegate(this, &CopyOnWriteEventTest::onCount);
+
+	RunnableAdapter<CopyOnWriteEventTest> ra(*this, &CopyOnWriteEventTest::fireSimple);
+	Thread t1;
+	Thread t2;
+	Thread t3;
+	t1.start(ra);
+	t2.start(ra);
+	t3.start(ra);
+
+	Counter other;
+	int n = 0;
+	while (t1.isRunning() || t2.isRunning() || t3.isRunning())
+	{
+		Simple += delegate(&other, &Counter::onEvent);
+		Simple -= delegate(&other, &Counter::onEvent);
+		++n;
+	}
+	t1.join();
+	t2.join();
+	t3.join();
+
+	assert (n > 0);
+	assert (_atomicCount == 3*NOTIFY_COUNT);
+	Simple -= delegate(this, &CopyOnWriteEventTest::onCount);
+	assert (Simple.empty());
+}
+
+
+void CopyOnWriteEventTest::testAsyncNotify()
+{
+	Poco::CopyOnWriteEvent<int>* pSimple = new Poco::CopyOnWriteEvent<int>();
+	(*pSimple) += delegate(this, &CopyOnWriteEventTest::onAsync);
+	assert (_count == 0);
+	int tmp = 0;
+	Poco::ActiveResult<int> retArg = pSimple->notifyAsync(this, tmp);
+	delete pSimple; // must work even when the event got deleted!
+	pSimple = NULL;
+	assert (_count == 0);
+	retArg.wait();
+	assert (retArg.data() == tmp);
+	assert (_count == LARGEINC);
+}
+
+
+void CopyOnWriteEventTest::testPerformance()
+{
+	int delegates[] = {1, 4, 16};
+	for (int i = 0; i < 3; ++i)
+	{
+		notifyPerformance<BasicEvent<int> >("BasicEvent", delegates[i]);
+		notifyPerformance<FIFOEvent<int> >("FIFOEvent", delegates[i]);
+		notifyPerformance<CopyOnWriteEvent<int> >("CopyOnWriteEvent", delegates[i]);
+	}
+}
+
+
+void CopyOnWriteEventTest::onSimple(const void* pSender, int& i)
+{
+	_count++;
+}
+
+
+void CopyOnWriteEventTest::onSimpleOther(const void* pSender, int& i)
+{
+	_count += 100;
+}
+
+
+void CopyOnWriteEventTest::onConstSimple(const void* pSender, const int& i)
+{
+	_count++;
+}
+
+
+void CopyOnWriteEventTest::onComplex(const void* pSender, Poco::EventArgs* & i)
+{
+	_count++;
+}
+
+
+void CopyOnWriteEventTest::onComplex2(const void* pSender, Poco::EventArgs & i)
+{
+	_count++;
+}
+
+
+void CopyOnWriteEventTest::onRemoveOther(const void* pSender, int& i)
+{
+	Simple -= delegate(this, &CopyOnWriteEventTest::onSimpleOther);
+}
+
+
+void CopyOnWriteEventTest::onCount(const void* pSender, int& i)
+{
+	++_atomicCount;
+}
+
+
+void CopyOnWriteEventTest::onAsync(const void* pSender, int& i)
+{
+	Poco::Thread::sleep(700);
+	_count += LARGEINC;
+}
+
+
+void CopyOnWriteEventTest::fireSimple()
+{
+	int tmp = 0;
+	for (int i = 0; i < NOTIFY_COUNT; ++i)
+	{
+		Simple.notify(this, tmp);
+	}
+}
+
+
+void CopyOnWriteEventTest::setUp()
+{
+	_count = 0;
+	_atomicCount = 0;
+	Simple.clear();
+	ConstSimple.clear();
+	Complex.clear();
+	Complex2.clear();
+}
+
+
+void CopyOnWriteEventTest::tearDown()
+{
+}
+
+
+CppUnit::Test* CopyOnWriteEventTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("CopyOnWriteEventTest");
+
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testNoDelegate);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testSingleDelegate);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testReturnParams);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testDuplicateRegister);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testDuplicateUnregister);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testDisabling);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testFIFOOrder);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testExpire);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testRemoveDuringNotify);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testConcurrentNotify);
+	CppUnit_addTest(pSuite, CopyOnWriteEventTest, testAsyncNotify);
+	//CppUnit_addTest(pSuite, CopyOnWriteEventTest, testPerformance);
+
+	return pSuite;
+}
@@ -0,0 +1,90 @@
+//
+// CopyOnWriteEventTest.h
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/CopyOnWriteEventTest.h#1 $
+//
+// Definition of the CopyOnWriteEventTest class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef CopyOnWriteEventTest_INCLUDED
+#define CopyOnWriteEventTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+#include "Poco/CopyOnWriteEvent.h"
+#include "Poco/EventArgs.h"
+#include "Poco/AtomicCounter.h"
+
+
+class CopyOnWriteEventTest: public CppUnit::TestCase
+{
+	Poco::CopyOnWriteEvent<int> Simple;
+	Poco::CopyOnWriteEvent<const int> ConstSimple;
+	Poco::CopyOnWriteEvent<Poco::EventArgs*> Complex;
+	Poco::CopyOnWriteEvent<Poco::EventArgs> Complex2;
+public:
+	CopyOnWriteEventTest(const std::string& name);
+	~CopyOnWriteEventTest();
+
+	void testNoDelegate();
+	void testSingleDelegate();
+	void testDuplicateRegister();
+	void testDuplicateUnregister();
+	void testDisabling();
+	void testFIFOOrder();
+	void testExpire();
+	void testReturnParams();
+	void testRemoveDuringNotify();
+	void testConcurrentNotify();
+	void testAsyncNotify();
+	void testPerformance();
+
+	void setUp();
+	void tearDown();
+	static CppUnit::Test* suite();
+
+protected:
+	void onSimple(const void* pSender, int& i);
+	void onSimpleOther(const void* pSender, int& i);
+	void onConstSimple(const void* pSender, const int& i);
+	void onComplex(const void* pSender, Poco::EventArgs* & i);
+	void onComplex2(const void* pSender, Poco::EventArgs & i);
+	void onRemoveOther(const void* pSender, int& i);
+	void onCount(const void* pSender, int& i);
+	void onAsync(const void* pSender, int& i);
+	void fireSimple();
+
+private:
+	int _count;
+	Poco::AtomicCounter _atomicCount;
+};
+
+
+#endif // CopyOnWriteEventTest_INCLUDED
@@ -39,6 +39,7 @@
 #include "Poco/Thread.h"
 #include "Poco/Runnable.h"
 #include "Poco/Buffer.h"
+#include "Poco/FIFOBuffer.h"
 #include "Poco/AtomicCounter.h"
 #include "Poco/Nullable.h"
 #include "Poco/Ascii.h"
@@ -53,6 +54,8 @@ using Poco::Environment;
 using Poco::Thread;
 using Poco::Runnable;
 using Poco::Buffer;
+using Poco::FIFOBuffer;
+using Poco::BasicFIFOBuffer;
 using Poco::AtomicCounter;
 using Poco::Nullable;
 using Poco::Ascii;
@@ -206,6 +209,69 @@ void CoreTest::testBuffer()
 }
 
 
+void CoreTest::testFIFOBuffer()
+{
+	FIFOBuffer f(8);
+	assert (f.size() == 8);
+	assert (f.used() == 0);
+	assert (f.available() == 8);
+	assert (f.isEmpty());
+	assert (!f.isFull());
+
+	assert (f.write("hello", 5) == 5);
+	assert (f.used() == 5);
+	assert (f.available() == 3);
+	assert (f.write("world", 5) == 3);
+	assert (f.isFull());
+	assert (std::string(f.begin(), f.used()) == "hellowor");
+
+	char buffer[8];
+	assert (f.peek(buffer, 2) == 2);
+	assert (std::string(buffer, 2) == "he");
+	assert (f.used() == 8);
+	assert (f.read(buffer, 5) == 5);
+	assert (std::string(buffer, 5) == "hello");
+	assert (f.used() == 3);
+	assert (f.available() == 5);
+
+	// the remaining content is moved to the front
+	char* p = f.next();
+	assert (p == f.begin() + 3);
+	std::memcpy(p, "12345", 5);
+	f.advance(5);
+	assert (f.isFull());
+	assert (std::string(f.begin(), f.used()) == "wor12345");
+
+	f.drain(3);
+	assert (std::string(f.begin(), f.used()) == "12345");
+	f.resize(16);
+	assert (f.size() == 16);
+	assert (f.available() == 11);
+	assert (std::string(f.begin(), f.used()) == "12345");
+
+	assert (f.read(buffer, sizeof(buffer)) == 5);
+	assert (f.isEmpty());
+	assert (f.next() == f.begin());
+
+	f.write("abc", 3);
+	f.clear();
+	assert (f.isEmpty());
+	assert (f.available() == 16);
+
+	BasicFIFOBuffer<int> fi(4);
+	int in[] = {1, 2, 3, 4, 5};
+	assert (fi.write(in, 5) == 4);
+	fi.drain(1);
+	fi.resize(8);
+	assert (fi.used() == 3);
+	assert (fi.begin()[0] == 2 && fi.begin()[2] == 4);
+	assert (fi.write(in + 4, 1) == 1);
+	int out[4];
+	assert (fi.read(out, 4) == 4);
+	assert (out[0] == 2 && out[3] == 5);
+}
+
+
 void CoreTest::testAtomicCounter()
 {
 	AtomicCounter ac;
@@ -376,6 +442,7 @@ CppUnit::Test* CoreTest::suite()
 	CppUnit_addTest(pSuite, CoreTest, testBugcheck);
 	CppUnit_addTest(pSuite, CoreTest, testEnvironment);
 	CppUnit_addTest(pSuite, CoreTest, testBuffer);
+	CppUnit_addTest(pSuite, CoreTest, testFIFOBuffer);
 	CppUnit_addTest(pSuite, CoreTest, testAtomicCounter);
 	CppUnit_addTest(pSuite, CoreTest, testNullable);
 	CppUnit_addTest(pSuite, CoreTest, testAscii);
@@ -52,6 +52,7 @@ public:
 	void testFPE();
 	void testEnvironment();
 	void testBuffer();
+	void testFIFOBuffer();
 	void testAtomicCounter();
 	void testNullable();
 	void testAscii();
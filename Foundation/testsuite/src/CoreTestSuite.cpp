@@ -47,6 +47,7 @@
 #include "NumberParserTest.h"
 #include "DynamicFactoryTest.h"
 #include "MemoryPoolTest.h"
+#include "ShardedMemoryPoolTest.h"
 #include "AnyTest.h"
 #include "DynamicAnyTest.h"
 #include "FormatTest.h"
@@ -77,6 +78,7 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(NumberParserTest::suite());
 	pSuite->addTest(DynamicFactoryTest::suite());
 	pSuite->addTest(MemoryPoolTest::suite());
+	pSuite->addTest(ShardedMemoryPoolTest::suite());
 	pSuite->addTest(AnyTest::suite());
 	pSuite->addTest(DynamicAnyTest::suite());
 	pSuite->addTest(FormatTest::suite());
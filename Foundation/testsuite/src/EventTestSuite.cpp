@@ -34,6 +34,7 @@
 #include "FIFOEventTest.h"
 #include "BasicEventTest.h"
 #include "PriorityEventTest.h"
+#include "CopyOnWriteEventTest.h"
 
 CppUnit::Test* EventTestSuite::suite()
 {
@@ -42,6 +43,7 @@ CppUnit::Test* EventTestSuite::suite()
 	pSuite->addTest(BasicEventTest::suite());
 	pSuite->addTest(PriorityEventTest::suite());
 	pSuite->addTest(FIFOEventTest::suite());
+	pSuite->addTest(CopyOnWriteEventTest::suite());
 
 	return pSuite;
 }
@@ -47,6 +47,8 @@
 #include "Poco/DateTimeFormat.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/DirectoryIterator.h"
+#include "Poco/FileStream.h"
+#include "Poco/Exception.h"
 #include <vector>
 
 
@@ -434,6 +436,117 @@ void FileChannelTest::testPurgeCount()
 }
 
 
+void FileChannelTest::testAsync()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ASYNC, "true");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "100000");
+		try
+		{
+			pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "0");
+			fail("non-positive flush interval - must throw");
+		}
+		catch (Poco::InvalidArgumentException&)
+		{
+		}
+		assert (pChannel->getProperty(FileChannel::PROP_FLUSHINTERVAL) == "100000");
+		assert (pChannel->getProperty(FileChannel::PROP_ASYNC) == "true");
+		assert (pChannel->getProperty(FileChannel::PROP_FLUSHPRIORITY) == "error");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(msg);
+		}
+		assert (lines(name) == 0);
+
+		// an error is written synchronously, after everything queued before it
+		Message err("source", "This is an error", Message::PRIO_ERROR);
+		pChannel->log(err);
+		assert (lines(name) == 101);
+
+		pChannel->log(msg);
+		pChannel->flush();
+		assert (lines(name) == 102);
+
+		// the flush size wakes up the writer thread
+		pChannel->setProperty(FileChannel::PROP_FLUSHSIZE, "1024");
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(msg);
+		}
+		int n = 0;
+		while (lines(name) < 180 && n++ < 50) Thread::sleep(100);
+		assert (lines(name) >= 180);
+
+		pChannel->log(msg);
+		pChannel->close();
+		assert (lines(name) == 203);
+
+		// a full queue is written synchronously
+		pChannel->setProperty(FileChannel::PROP_FLUSHSIZE, "65536");
+		pChannel->setProperty(FileChannel::PROP_MAXQUEUESIZE, "200");
+		assert (pChannel->getProperty(FileChannel::PROP_MAXQUEUESIZE) == "200");
+		for (int i = 0; i < 10; ++i)
+		{
+			pChannel->log(msg);
+		}
+		// 8 messages fill the queue, the 9th writes them
+		assert (lines(name) == 212);
+		pChannel->log(msg);
+		pChannel->close();
+		assert (lines(name) == 214);
+
+		pChannel->log(msg);
+		pChannel->setProperty(FileChannel::PROP_ASYNC, "false");
+		assert (lines(name) == 215);
+		pChannel->log(msg);
+		assert (lines(name) == 216);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testAsyncRotateBySize()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "2 K");
+		pChannel->setProperty(FileChannel::PROP_ASYNC, "true");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "10");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 200; ++i)
+		{
+			pChannel->log(msg);
+		}
+		pChannel->close();
+		File f(name + ".0");
+		assert (f.exists());
+		f = name + ".1";
+		assert (f.exists());
+		f = name + ".2";
+		assert (!f.exists());
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
 void FileChannelTest::setUp()
 {
 }
@@ -471,6 +584,19 @@ void FileChannelTest::remove(const std::string& baseName)
 }
 
 
+int FileChannelTest::lines(const std::string& path)
+{
+	int n = 0;
+	if (File(path).exists())
+	{
+		Poco::FileInputStream istr(path);
+		std::string line;
+		while (std::getline(istr, line)) ++n;
+	}
+	return n;
+}
+
+
 std::string FileChannelTest::filename() const
 {
 	std::string name = "log_";
@@ -536,6 +662,8 @@ CppUnit::Test* FileChannelTest::suite()
 	CppUnit_addTest(pSuite, FileChannelTest, testCompress);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeAge);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeCount);
+	CppUnit_addTest(pSuite, FileChannelTest, testAsync);
+	CppUnit_addTest(pSuite, FileChannelTest, testAsyncRotateBySize);
 
 	return pSuite;
 }
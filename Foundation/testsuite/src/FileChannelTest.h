@@ -65,6 +65,8 @@ public:
 	void testCompress();
 	void testPurgeAge();
 	void testPurgeCount();
+	void testAsync();
+	void testAsyncRotateBySize();
 
 	void setUp();
 	void tearDown();
@@ -75,6 +77,7 @@ private:
 	template <class D> std::string rotation(TimeRotation rtype) const;
 	void remove(const std::string& baseName);
 	std::string filename() const;
+	static int lines(const std::string& path);
 };
 
 
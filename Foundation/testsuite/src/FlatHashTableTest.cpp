@@ -0,0 +1,558 @@
+//
+// FlatHashTableTest.cpp
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/FlatHashTableTest.cpp#1 $
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "FlatHashTableTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/FlatHashTable.h"
+#include "Poco/LinearHashTable.h"
+#include "Poco/SimpleHashTable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Random.h"
+#include "Poco/Exception.h"
+#include <set>
+#include <map>
+#include <vector>
+#include <iostream>
+
+
+using Poco::FlatHashTable;
+using Poco::LinearHashTable;
+using Poco::SimpleHashTable;
+using Poco::Hash;
+using Poco::Stopwatch;
+using Poco::NumberFormatter;
+
+
+namespace
+{
+	struct BadHash
+	{
+		std::size_t operator () (int value) const
+		{
+			return 0;
+		}
+	};
+
+	struct HalfBadHash
+	{
+		std::size_t operator () (int value) const
+		{
+			return value/2;
+		}
+	};
+
+	template <class Table>
+	void printTimes(const char* name, Table& table, const std::vector<typename Table::ValueType>& values)
+	{
+		Stopwatch sw;
+		sw.start();
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			table.insert(values[i]);
+		}
+		sw.stop();
+		std::cout << "Insert " << name << ": " << sw.elapsed()/1000 << " ms" << std::endl;
+		sw.restart();
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			table.find(values[i]);
+		}
+		sw.stop();
+		std::cout << "Find " << name << ": " << sw.elapsed()/1000 << " ms" << std::endl;
+		sw.restart();
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			table.erase(values[i]);
+		}
+		sw.stop();
+		std::cout << "Erase " << name << ": " << sw.elapsed()/1000 << " ms" << std::endl;
+	}
+
+	template <class Key>
+	void printTimesSHT(const std::vector<Key>& values)
+	{
+		// SimpleHashTable neither grows nor supports erasing
+		SimpleHashTable<Key, int> sht(static_cast<Poco::UInt32>(2*values.size()));
+		Stopwatch sw;
+		sw.start();
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			sht.insert(values[i], 0);
+		}
+		sw.stop();
+		std::cout << "Insert SHT: " << sw.elapsed()/1000 << " ms" << std::endl;
+		sw.restart();
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			sht.exists(values[i]);
+		}
+		sw.stop();
+		std::cout << "Find SHT: " << sw.elapsed()/1000 << " ms" << std::endl;
+	}
+
+	template <class Key>
+	void printTimesMap(const std::vector<Key>& values)
+	{
+		std::map<Key, int> m;
+		Stopwatch sw;
+		sw.start();
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			m.insert(std::make_pair(values[i], 0));
+		}
+		sw.stop();
+		std::cout << "Insert map: " << sw.elapsed()/1000 << " ms" << std::endl;
+		sw.restart();
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			m.find(values[i]);
+		}
+		sw.stop();
+		std::cout << "Find map: " << sw.elapsed()/1000 << " ms" << std::endl;
+		sw.restart();
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			m.erase(values[i]);
+		}
+		sw.stop();
+		std::cout << "Erase map: " << sw.elapsed()/1000 << " ms" << std::endl;
+	}
+}
+
+
+FlatHashTableTest::FlatHashTableTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+FlatHashTableTest::~FlatHashTableTest()
+{
+}
+
+
+void FlatHashTableTest::testInsert()
+{
+	const int N = 1000;
+
+	FlatHashTable<int, Hash<int> > ht;
+	
+	assert (ht.empty());
+	assert (ht.begin() == ht.end());
+	
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<FlatHashTable<int, Hash<int> >::Iterator, bool> res = ht.insert(i);
+		assert (*res.first == i);
+		assert (res.second);
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it != ht.end());
+		assert (*it == i);
+		assert (ht.size() == i + 1);
+	}		
+	assert (ht.capacity() == 2048);
+	
+	assert (!ht.empty());
+	
+	for (int i = 0; i < N; ++i)
+	{
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it != ht.end());
+		assert (*it == i);
+		assert (ht.count(i) == 1);
+	}
+	assert (ht.find(N) == ht.end());
+	assert (ht.count(N) == 0);
+	
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<FlatHashTable<int, Hash<int> >::Iterator, bool> res = ht.insert(i);
+		assert (*res.first == i);
+		assert (!res.second);
+		assert (ht.size() == N);
+	}
+
+	// multiples of powers of two must not collide
+	FlatHashTable<int, Hash<int> > ht2;
+	for (int i = 0; i < N; ++i)
+	{
+		ht2.insert(i << 16);
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht2.count(i << 16) == 1);
+	}
+}
+
+
+void FlatHashTableTest::testErase()
+{
+	const int N = 1000;
+
+	FlatHashTable<int, Hash<int> > ht;
+
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+	}
+	assert (ht.size() == N);
+	
+	for (int i = 0; i < N; i += 2)
+	{
+		ht.erase(i);
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it == ht.end());
+	}
+	assert (ht.size() == N/2);
+	
+	for (int i = 0; i < N; i += 2)
+	{
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it == ht.end());
+	}
+	
+	for (int i = 1; i < N; i += 2)
+	{
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it != ht.end());
+		assert (*it == i);
+	}
+
+	for (int i = 0; i < N; i += 2)
+	{
+		ht.insert(i);
+	}
+	
+	for (int i = 0; i < N; ++i)
+	{
+		FlatHashTable<int, Hash<int> >::Iterator it = ht.find(i);
+		assert (it != ht.end());
+		assert (*it == i);
+	}
+
+	ht.erase(ht.end());
+	ht.erase(N);
+	assert (ht.size() == N);
+
+	ht.clear();
+	assert (ht.empty());
+	assert (ht.begin() == ht.end());
+	assert (ht.find(1) == ht.end());
+}
+
+
+void FlatHashTableTest::testInsertErase()
+{
+	// random operations, checked against a std::set
+	const int N = 100000;
+	FlatHashTable<int, HalfBadHash> ht;
+	std::set<int> ref;
+	Poco::Random rnd;
+	rnd.seed(42);
+	for (int i = 0; i < N; ++i)
+	{
+		int value = static_cast<int>(rnd.next(2000));
+		if (rnd.next(3) == 0)
+		{
+			ht.erase(value);
+			ref.erase(value);
+		}
+		else
+		{
+			bool inserted = ht.insert(value).second;
+			assert (inserted == ref.insert(value).second);
+		}
+		assert (ht.size() == ref.size());
+		assert ((ht.count(value) == 1) == (ref.count(value) == 1));
+	}
+	for (int value = 0; value < 2000; ++value)
+	{
+		assert ((ht.count(value) == 1) == (ref.count(value) == 1));
+	}
+	std::set<int> values(ht.begin(), ht.end());
+	assert (values == ref);
+}
+
+
+void FlatHashTableTest::testIterator()
+{
+	const int N = 1000;
+
+	FlatHashTable<int, Hash<int> > ht;
+
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+	}
+	
+	std::set<int> values;
+	FlatHashTable<int, Hash<int> >::Iterator it = ht.begin();
+	while (it != ht.end())
+	{
+		assert (values.find(*it) == values.end());
+		values.insert(*it);
+		++it;
+	}
+	
+	assert (values.size() == N);
+}
+
+
+void FlatHashTableTest::testConstIterator()
+{
+	const int N = 1000;
+
+	FlatHashTable<int, Hash<int> > ht;
+
+	for (int i = 0; i < N; ++i)
+	{
+		ht.insert(i);
+	}
+
+	std::set<int> values;
+	FlatHashTable<int, Hash<int> >::ConstIterator it = ht.begin();
+	while (it != ht.end())
+	{
+		assert (values.find(*it) == values.end());
+		values.insert(*it);
+		++it;
+	}
+	
+	assert (values.size() == N);
+	
+	values.clear();
+	const FlatHashTable<int, Hash<int> > cht(ht);
+
+	FlatHashTable<int, Hash<int> >::ConstIterator cit = cht.begin();
+	while (cit != cht.end())
+	{
+		assert (values.find(*cit) == values.end());
+		values.insert(*cit);
+		++cit;
+	}
+	
+	assert (values.size() == N);	
+}
+
+
+void FlatHashTableTest::testStrings()
+{
+	const int N = 1000;
+
+	FlatHashTable<std::string, Hash<std::string> > ht;
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.insert(NumberFormatter::format(i)).second);
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		FlatHashTable<std::string, Hash<std::string> >::ConstIterator it = ht.find(NumberFormatter::format(i));
+		assert (it != ht.end());
+		assert (*it == NumberFormatter::format(i));
+	}
+	for (int i = 0; i < N; i += 3)
+	{
+		ht.erase(NumberFormatter::format(i));
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.count(NumberFormatter::format(i)) == (i % 3 == 0 ? 0 : 1));
+	}
+
+	FlatHashTable<std::string, Hash<std::string> > ht2;
+	ht2 = ht;
+	assert (ht2.size() == ht.size());
+	ht.clear();
+	assert (ht2.count("1") == 1);
+}
+
+
+void FlatHashTableTest::testCollisions()
+{
+	// up to 254 values with the same hash value can be stored
+	const int N = 254;
+	FlatHashTable<int, BadHash> ht;
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.insert(i).second);
+	}
+	for (int i = 0; i < N; i += 2)
+	{
+		ht.erase(i);
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.count(i) == i % 2);
+	}
+	for (int i = 0; i < N; i += 2)
+	{
+		assert (ht.insert(i).second);
+	}
+	assert (ht.size() == N);
+
+	try
+	{
+		ht.insert(N);
+		fail("too many collisions - must throw");
+	}
+	catch (Poco::RangeException&)
+	{
+	}
+	assert (ht.size() == N);
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.count(i) == 1);
+	}
+	assert (ht.count(N) == 0);
+
+	// growing the table keeps all colliding values
+	ht.reserve(4*N);
+	assert (ht.size() == N);
+	for (int i = 0; i < N; ++i)
+	{
+		assert (ht.count(i) == 1);
+	}
+}
+
+
+void FlatHashTableTest::testReserve()
+{
+	FlatHashTable<int, Hash<int> > ht(1000);
+	std::size_t capacity = ht.capacity();
+	assert (capacity >= 1000);
+	for (int i = 0; i < 1000; ++i)
+	{
+		ht.insert(i);
+	}
+	assert (ht.capacity() == capacity);
+
+	ht.reserve(5000);
+	assert (ht.capacity() >= 5000);
+	for (int i = 0; i < 1000; ++i)
+	{
+		assert (ht.count(i) == 1);
+	}
+	ht.reserve(10);
+	assert (ht.capacity() >= 5000);
+}
+
+
+void FlatHashTableTest::testHashString()
+{
+	// the string hash must depend on every character
+	std::set<std::size_t> hashes;
+	std::string str(20, 'a');
+	hashes.insert(Poco::hash(str));
+	for (std::size_t i = 0; i < str.size(); ++i)
+	{
+		std::string s(str);
+		s[i] = 'b';
+		assert (hashes.insert(Poco::hash(s)).second);
+		assert (hashes.insert(Poco::hash(s.substr(0, i))).second);
+	}
+	assert (Poco::hash(std::string("abc")) == Poco::hash(std::string("abc")));
+}
+
+
+void FlatHashTableTest::testPerformanceInt()
+{
+	const int N = 1000000;
+	std::vector<int> values;
+	for (int i = 0; i < N; ++i)
+	{
+		values.push_back(i*16);
+	}
+
+	{
+		FlatHashTable<int, Hash<int> > fht;
+		printTimes("FHT", fht, values);
+	}
+	{
+		LinearHashTable<int, Hash<int> > lht;
+		printTimes("LHT", lht, values);
+	}
+	printTimesSHT(values);
+	printTimesMap(values);
+}
+
+
+void FlatHashTableTest::testPerformanceStr()
+{
+	const int N = 1000000;
+	std::vector<std::string> values;
+	for (int i = 0; i < N; ++i)
+	{
+		values.push_back("key-" + NumberFormatter::format0(i, 12));
+	}
+
+	{
+		FlatHashTable<std::string, Hash<std::string> > fht;
+		printTimes("FHT", fht, values);
+	}
+	{
+		LinearHashTable<std::string, Hash<std::string> > lht;
+		printTimes("LHT", lht, values);
+	}
+	printTimesSHT(values);
+	printTimesMap(values);
+}
+
+
+void FlatHashTableTest::setUp()
+{
+}
+
+
+void FlatHashTableTest::tearDown()
+{
+}
+
+
+CppUnit::Test* FlatHashTableTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("FlatHashTableTest");
+
+	CppUnit_addTest(pSuite, FlatHashTableTest, testInsert);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testErase);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testInsertErase);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testIterator);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testConstIterator);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testStrings);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testCollisions);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testReserve);
+	CppUnit_addTest(pSuite, FlatHashTableTest, testHashString);
+	//CppUnit_addTest(pSuite, FlatHashTableTest, testPerformanceInt);
+	//CppUnit_addTest(pSuite, FlatHashTableTest, testPerformanceStr);
+
+	return pSuite;
+}
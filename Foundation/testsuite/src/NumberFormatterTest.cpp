@@ -34,11 +34,17 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/NumberFormatter.h"
+#include "Poco/Stopwatch.h"
+#include <limits>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
 
 
 using Poco::NumberFormatter;
 using Poco::Int64;
 using Poco::UInt64;
+using Poco::Stopwatch;
 
 
 NumberFormatterTest::NumberFormatterTest(const std::string& name): CppUnit::TestCase(name)
@@ -158,6 +164,153 @@ void NumberFormatterTest::testFormatFloat()
 }
 
 
+void NumberFormatterTest::testFormatLimits()
+{
+	char buffer[64];
+	
+	std::sprintf(buffer, "%d", std::numeric_limits<int>::min());
+	assert (NumberFormatter::format(std::numeric_limits<int>::min()) == buffer);
+	std::sprintf(buffer, "%d", std::numeric_limits<int>::max());
+	assert (NumberFormatter::format(std::numeric_limits<int>::max()) == buffer);
+	std::sprintf(buffer, "%u", std::numeric_limits<unsigned>::max());
+	assert (NumberFormatter::format(std::numeric_limits<unsigned>::max()) == buffer);
+	std::sprintf(buffer, "%ld", std::numeric_limits<long>::min());
+	assert (NumberFormatter::format(std::numeric_limits<long>::min()) == buffer);
+	std::sprintf(buffer, "%lu", std::numeric_limits<unsigned long>::max());
+	assert (NumberFormatter::format(std::numeric_limits<unsigned long>::max()) == buffer);
+	std::sprintf(buffer, "%X", std::numeric_limits<unsigned>::max());
+	assert (NumberFormatter::formatHex(-1) == buffer);
+
+	assert (NumberFormatter::format(0) == "0");
+	assert (NumberFormatter::format(0, 3) == "  0");
+	assert (NumberFormatter::format0(0, 3) == "000");
+	assert (NumberFormatter::format(-5, 1) == "-5");
+	assert (NumberFormatter::format0(-5, 2) == "-5");
+	assert (NumberFormatter::format0(-5, 3) == "-05");
+	assert (NumberFormatter::format(12345, 3) == "12345");
+	assert (NumberFormatter::formatHex(0) == "0");
+	assert (NumberFormatter::formatHex(0, 2) == "00");
+
+	for (int i = -1000; i <= 1000; ++i)
+	{
+		std::sprintf(buffer, "%d", i*997);
+		assert (NumberFormatter::format(i*997) == buffer);
+		std::sprintf(buffer, "%6d", i);
+		assert (NumberFormatter::format(i, 6) == buffer);
+		std::sprintf(buffer, "%06d", i);
+		assert (NumberFormatter::format0(i, 6) == buffer);
+		std::sprintf(buffer, "%04X", (unsigned) i);
+		assert (NumberFormatter::formatHex(i, 4) == buffer);
+	}
+
+#if defined(POCO_HAVE_INT64)
+	assert (NumberFormatter::format(std::numeric_limits<Int64>::min()) == "-9223372036854775808");
+	assert (NumberFormatter::format(std::numeric_limits<Int64>::max()) == "9223372036854775807");
+	assert (NumberFormatter::format(std::numeric_limits<UInt64>::max()) == "18446744073709551615");
+	assert (NumberFormatter::formatHex(std::numeric_limits<UInt64>::max()) == "FFFFFFFFFFFFFFFF");
+	assert (NumberFormatter::formatHex((Int64) -1) == "FFFFFFFFFFFFFFFF");
+	assert (NumberFormatter::format0((Int64) -123, 21) == "-00000000000000000123");
+#endif
+}
+
+
+void NumberFormatterTest::testFormatShortest()
+{
+	assert (NumberFormatter::formatShortest(0.0) == "0");
+	assert (NumberFormatter::formatShortest(1.0) == "1");
+	assert (NumberFormatter::formatShortest(-2.5) == "-2.5");
+	assert (NumberFormatter::formatShortest(0.1) == "0.1");
+	assert (NumberFormatter::formatShortest(0.1 + 0.2) == "0.30000000000000004");
+	assert (NumberFormatter::formatShortest(1e300) == "1e+300");
+	assert (NumberFormatter::formatShortest(1.0/3) == "0.3333333333333333");
+
+	double value = 1.0;
+	for (int i = 0; i < 1000; ++i)
+	{
+		value = value*1.1 + 0.0123;
+		std::string s = NumberFormatter::formatShortest(value);
+		assert (std::strtod(s.c_str(), 0) == value);
+		std::string t = NumberFormatter::format(value);
+		if (std::strtod(t.c_str(), 0) == value) assert (s.size() <= t.size());
+	}
+	std::string s;
+	NumberFormatter::appendShortest(s, std::numeric_limits<double>::max());
+	assert (std::strtod(s.c_str(), 0) == std::numeric_limits<double>::max());
+	s.clear();
+	NumberFormatter::appendShortest(s, std::numeric_limits<double>::min());
+	assert (std::strtod(s.c_str(), 0) == std::numeric_limits<double>::min());
+
+	// subnormal numbers need fewer digits
+	assert (NumberFormatter::formatShortest(std::numeric_limits<double>::denorm_min()) == "5e-324");
+}
+
+
+void NumberFormatterTest::testPerformance()
+{
+	const int COUNT = 2000000;
+
+	std::string result;
+	char buffer[64];
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		result.clear();
+		std::sprintf(buffer, "%d", i*2654435761U);
+		result.append(buffer);
+	}
+	sw.stop();
+	std::cout << "int, sprintf: " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		result.clear();
+		NumberFormatter::append(result, int(i*2654435761U));
+	}
+	sw.stop();
+	std::cout << "int, NumberFormatter: " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		result.clear();
+		std::sprintf(buffer, "%08X", i*2654435761U);
+		result.append(buffer);
+	}
+	sw.stop();
+	std::cout << "hex, sprintf: " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		result.clear();
+		NumberFormatter::appendHex(result, i*2654435761U, 8);
+	}
+	sw.stop();
+	std::cout << "hex, NumberFormatter: " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		result.clear();
+		std::sprintf(buffer, "%.17g", i*0.1);
+		result.append(buffer);
+	}
+	sw.stop();
+	std::cout << "double, sprintf(%.17g): " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		result.clear();
+		NumberFormatter::appendShortest(result, i*0.1);
+	}
+	sw.stop();
+	std::cout << "double, NumberFormatter (shortest): " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+}
+
+
 void NumberFormatterTest::setUp()
 {
 }
@@ -176,6 +329,9 @@ CppUnit::Test* NumberFormatterTest::suite()
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormat0);
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatHex);
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatFloat);
+	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatLimits);
+	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatShortest);
+	//CppUnit_addTest(pSuite, NumberFormatterTest, testPerformance);
 
 	return pSuite;
 }
@@ -50,6 +50,9 @@ public:
 	void testFormat0();
 	void testFormatHex();
 	void testFormatFloat();
+	void testFormatLimits();
+	void testFormatShortest();
+	void testPerformance();
 	
 	void setUp();
 	void tearDown();
@@ -34,11 +34,19 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
 #include "Poco/Exception.h"
+#include "Poco/Stopwatch.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
 
 
 using Poco::NumberParser;
+using Poco::NumberFormatter;
 using Poco::SyntaxException;
+using Poco::Stopwatch;
 
 
 NumberParserTest::NumberParserTest(const std::string& name): CppUnit::TestCase(name)
@@ -57,12 +65,15 @@ void NumberParserTest::testParse()
 	assert (NumberParser::parse("-123") == -123);
 	assert (NumberParser::parseUnsigned("123") == 123);
 	assert (NumberParser::parseHex("12AB") == 0x12ab);
+	assert (NumberParser::parseHex("+0x12AB") == 0x12ab);
+	assert (NumberParser::parseHex("-1") == 0xffffffff);
 
 #if defined(POCO_HAVE_INT64)
 	assert (NumberParser::parse64("123") == 123);
 	assert (NumberParser::parse64("-123") == -123);
 	assert (NumberParser::parseUnsigned64("123") == 123);
 	assert (NumberParser::parseHex64("12AB") == 0x12ab);
+	assert (NumberParser::parseHex64("-0x1") == Poco::UInt64(18446744073709551615ULL));
 #endif
 
 	assertEqualDelta (12.34, NumberParser::parseFloat("12.34"), 0.01);
@@ -175,6 +186,165 @@ void NumberParserTest::testParseError()
 }
 
 
+void NumberParserTest::testLimits()
+{
+	int i;
+	assert (NumberParser::tryParse("2147483647", i) && i == 2147483647);
+	assert (NumberParser::tryParse("-2147483648", i) && i == -2147483647 - 1);
+	assert (!NumberParser::tryParse("2147483648", i));
+	assert (!NumberParser::tryParse("-2147483649", i));
+	assert (!NumberParser::tryParse("99999999999", i));
+	assert (NumberParser::tryParse("  +42", i) && i == 42);
+	assert (NumberParser::tryParse("-0", i) && i == 0);
+	assert (!NumberParser::tryParse("42 ", i));
+	assert (!NumberParser::tryParse("-", i));
+	assert (!NumberParser::tryParse("4 2", i));
+
+	unsigned u;
+	assert (NumberParser::tryParseUnsigned("4294967295", u) && u == 4294967295U);
+	assert (!NumberParser::tryParseUnsigned("4294967296", u));
+	assert (NumberParser::tryParseUnsigned("-1", u) && u == 4294967295U);
+	assert (NumberParser::tryParseHex("FFFFFFFF", u) && u == 0xFFFFFFFF);
+	assert (NumberParser::tryParseHex("0x1f", u) && u == 0x1F);
+	assert (NumberParser::tryParseHex("0XaBc", u) && u == 0xABC);
+	assert (!NumberParser::tryParseHex("100000000", u));
+	assert (!NumberParser::tryParseHex("0x", u));
+	assert (NumberParser::tryParseHex("-1", u) && u == 0xFFFFFFFF);
+	assert (!NumberParser::tryParseHex("-", u));
+
+#if defined(POCO_HAVE_INT64)
+	Poco::Int64 i64;
+	assert (NumberParser::tryParse64("9223372036854775807", i64) && i64 == Poco::Int64(9223372036854775807LL));
+	assert (NumberParser::tryParse64("-9223372036854775808", i64) && i64 == -Poco::Int64(9223372036854775807LL) - 1);
+	assert (!NumberParser::tryParse64("9223372036854775808", i64));
+	
+	Poco::UInt64 u64;
+	assert (NumberParser::tryParseUnsigned64("18446744073709551615", u64) && u64 == Poco::UInt64(18446744073709551615ULL));
+	assert (!NumberParser::tryParseUnsigned64("18446744073709551616", u64));
+	assert (NumberParser::tryParseHex64("FFFFFFFFFFFFFFFF", u64) && u64 == Poco::UInt64(18446744073709551615ULL));
+	assert (!NumberParser::tryParseHex64("10000000000000000", u64));
+#endif
+}
+
+
+void NumberParserTest::testRange()
+{
+	const char* text = "123,-45,ff,2.5";
+	int i;
+	assert (NumberParser::tryParse(text, text + 3, i) && i == 123);
+	assert (NumberParser::tryParse(text + 4, text + 7, i) && i == -45);
+	assert (!NumberParser::tryParse(text, text + 4, i));
+	assert (!NumberParser::tryParse(text, text, i));
+	unsigned u;
+	assert (NumberParser::tryParseHex(text + 8, text + 10, u) && u == 0xFF);
+	double d;
+	assert (NumberParser::tryParseFloat(text + 11, text + 14, d) && d == 2.5);
+	assert (NumberParser::tryParseFloat(text + 11, text + 12, d) && d == 2);
+	assert (!NumberParser::tryParseFloat(text + 10, text + 14, d));
+	
+	// the range need not be zero-terminated
+	const char digits[] = {'9', '8', '7'};
+	assert (NumberParser::tryParse(digits, digits + 2, i) && i == 98);
+	assert (NumberParser::tryParseFloat(digits, digits + 3, d) && d == 987);
+}
+
+
+void NumberParserTest::testParseFloat()
+{
+	assert (NumberParser::parseFloat("0") == 0);
+	assert (NumberParser::parseFloat("-0.0") == 0);
+	assert (NumberParser::parseFloat("1.5") == 1.5);
+	assert (NumberParser::parseFloat("  -1.5e3") == -1500);
+	assert (NumberParser::parseFloat("+.5") == 0.5);
+	assert (NumberParser::parseFloat("5.") == 5);
+	assert (NumberParser::parseFloat("0.1") == 0.1);
+	assert (NumberParser::parseFloat("1E-2") == 0.01);
+	assert (NumberParser::parseFloat("0.000000000000000000000000123") == 1.23e-25);
+	assert (NumberParser::parseFloat("123456789012345678901234567890") == 123456789012345678901234567890.0);
+	assert (NumberParser::parseFloat("1e300") == 1e300);
+	assert (NumberParser::parseFloat("2.2250738585072014e-308") == 2.2250738585072014e-308);
+	assert (NumberParser::parseFloat("9007199254740993") == 9007199254740992.0);
+
+	double d;
+	assert (!NumberParser::tryParseFloat("", d));
+	assert (!NumberParser::tryParseFloat(".", d));
+	assert (!NumberParser::tryParseFloat("-", d));
+	assert (!NumberParser::tryParseFloat("1e", d));
+	assert (!NumberParser::tryParseFloat("1e+", d));
+	assert (!NumberParser::tryParseFloat("1.5 ", d));
+	assert (!NumberParser::tryParseFloat("1..5", d));
+
+	// results must be identical to the ones of std::strtod()
+	char buffer[64];
+	double value = 1.0;
+	for (int i = 0; i < 2000; ++i)
+	{
+		value = value*1.7 + 0.123;
+		if (value > 1e250) value = 1e-250;
+		std::sprintf(buffer, "%.*g", 10 + i % 8, value);
+		assert (NumberParser::parseFloat(buffer) == std::strtod(buffer, 0));
+		std::string s = NumberFormatter::formatShortest(value);
+		assert (NumberParser::parseFloat(s) == value);
+	}
+}
+
+
+void NumberParserTest::testPerformance()
+{
+	const int COUNT = 2000000;
+
+	std::vector<std::string> ints;
+	std::vector<std::string> doubles;
+	for (int i = 0; i < 1000; ++i)
+	{
+		ints.push_back(NumberFormatter::format(int(i*2654435761U)));
+		doubles.push_back(NumberFormatter::format(i*1.37, 3));
+	}
+
+	int n = 0;
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		int value;
+		char temp;
+		if (std::sscanf(ints[i % 1000].c_str(), "%d%c", &value, &temp) == 1) n += value;
+	}
+	sw.stop();
+	std::cout << "int, sscanf: " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		int value;
+		if (NumberParser::tryParse(ints[i % 1000], value)) n += value;
+	}
+	sw.stop();
+	std::cout << "int, NumberParser: " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+
+	double sum = 0;
+	sw.restart();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		double value;
+		char temp;
+		if (std::sscanf(doubles[i % 1000].c_str(), "%lf%c", &value, &temp) == 1) sum += value;
+	}
+	sw.stop();
+	std::cout << "double, sscanf: " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		double value;
+		if (NumberParser::tryParseFloat(doubles[i % 1000], value)) sum += value;
+	}
+	sw.stop();
+	std::cout << "double, NumberParser: " << COUNT/(sw.elapsed()/1000000.0) << " values/s" << std::endl;
+	std::cout << n << " " << sum << std::endl;
+}
+
+
 void NumberParserTest::setUp()
 {
 }
@@ -191,6 +361,10 @@ CppUnit::Test* NumberParserTest::suite()
 
 	CppUnit_addTest(pSuite, NumberParserTest, testParse);
 	CppUnit_addTest(pSuite, NumberParserTest, testParseError);
+	CppUnit_addTest(pSuite, NumberParserTest, testLimits);
+	CppUnit_addTest(pSuite, NumberParserTest, testRange);
+	CppUnit_addTest(pSuite, NumberParserTest, testParseFloat);
+	//CppUnit_addTest(pSuite, NumberParserTest, testPerformance);
 
 	return pSuite;
 }
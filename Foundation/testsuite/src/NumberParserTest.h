@@ -48,6 +48,10 @@ public:
 
 	void testParse();
 	void testParseError();
+	void testLimits();
+	void testRange();
+	void testParseFloat();
+	void testPerformance();
 
 	void setUp();
 	void tearDown();
@@ -36,11 +36,14 @@
 #include "Poco/PatternFormatter.h"
 #include "Poco/Message.h"
 #include "Poco/DateTime.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
 
 
 using Poco::PatternFormatter;
 using Poco::Message;
 using Poco::DateTime;
+using Poco::Stopwatch;
 
 
 PatternFormatterTest::PatternFormatterTest(const std::string& name): CppUnit::TestCase(name)
@@ -98,6 +101,78 @@ void PatternFormatterTest::testPatternFormatter()
 	fmt.setProperty("pattern", "%[testParam] %p");
 	fmt.format(msg, result);
 	assert (result == "Test Parameter Error");
+
+	result.clear();
+	fmt.setProperty("pattern", "100%% %[missing]%x%[unterminated");
+	fmt.format(msg, result);
+	assert (result == "100% x");
+
+	result.clear();
+	fmt.setProperty("pattern", "%");
+	fmt.format(msg, result);
+	assert (result.empty());
+}
+
+
+void PatternFormatterTest::testTimeCache()
+{
+	Message msg;
+	msg.setText("text");
+	PatternFormatter fmt("%Y-%m-%d %h:%M:%S.%F %A %W %B %z|%t");
+	
+	std::string result;
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 500, 1).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2005-01-01 02:30:15.500001 PM Saturday January Z|text");
+
+	result.clear();
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 999, 999).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2005-01-01 02:30:15.999999 PM Saturday January Z|text");
+
+	result.clear();
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 16, 0, 0).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2005-01-01 02:30:16.000000 PM Saturday January Z|text");
+
+	// going back in time must not return the cached second
+	result.clear();
+	msg.setTime(DateTime(2004, 12, 31, 0, 0, 0, 1, 0).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2004-12-31 12:00:00.001000 AM Friday December Z|text");
+
+	// changing the times property invalidates the cache
+	result.clear();
+	fmt.setProperty("pattern", "%H:%M:%S %Z");
+	fmt.setProperty("times", "local");
+	std::string local;
+	fmt.format(msg, local);
+	fmt.setProperty("times", "UTC");
+	fmt.format(msg, result);
+	assert (result == "00:00:00 GMT");
+	if (local.find("GMT") == std::string::npos) assert (local != result);
+}
+
+
+void PatternFormatterTest::testPerformance()
+{
+	const int MESSAGES = 1000000;
+
+	Message msg("TestSource", "Test message text", Message::PRIO_INFORMATION);
+	msg.setThread("TestThread");
+	PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i [%s:%I:%T] %p: %t");
+	fmt.setProperty("times", "local");
+
+	std::string result;
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < MESSAGES; ++i)
+	{
+		result.clear();
+		fmt.format(msg, result);
+	}
+	sw.stop();
+	std::cout << MESSAGES/(sw.elapsed()/1000000.0) << " messages/s" << std::endl;
 }
 
 
@@ -116,6 +191,8 @@ CppUnit::Test* PatternFormatterTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PatternFormatterTest");
 
 	CppUnit_addTest(pSuite, PatternFormatterTest, testPatternFormatter);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testTimeCache);
+	//CppUnit_addTest(pSuite, PatternFormatterTest, testPerformance);
 
 	return pSuite;
 }
@@ -47,6 +47,8 @@ public:
 	~PatternFormatterTest();
 
 	void testPatternFormatter();
+	void testTimeCache();
+	void testPerformance();
 
 	void setUp();
 	void tearDown();
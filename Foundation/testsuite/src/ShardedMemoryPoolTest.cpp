@@ -0,0 +1,314 @@
+//
+// ShardedMemoryPoolTest.cpp
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/ShardedMemoryPoolTest.cpp#1 $
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "ShardedMemoryPoolTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/ShardedMemoryPool.h"
+#include "Poco/MemoryPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include <vector>
+#include <cstring>
+#include <iostream>
+
+
+using Poco::ShardedMemoryPool;
+using Poco::MemoryPool;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class Releaser: public Runnable
+	{
+	public:
+		Releaser(ShardedMemoryPool& pool, void* ptr):
+			_pool(pool),
+			_ptr(ptr)
+		{
+		}
+
+		void run()
+		{
+			_pool.release(_ptr);
+		}
+
+	private:
+		ShardedMemoryPool& _pool;
+		void* _ptr;
+	};
+
+	template <class Pool>
+	class PoolUser: public Runnable
+	{
+	public:
+		PoolUser(Pool& pool, int iterations):
+			_pool(pool),
+			_iterations(iterations),
+			_ok(true)
+		{
+		}
+
+		void run()
+		{
+			std::size_t size = _pool.blockSize();
+			for (int i = 0; i < _iterations; ++i)
+			{
+				char* p[BLOCKS];
+				for (int k = 0; k < BLOCKS; ++k)
+				{
+					p[k] = reinterpret_cast<char*>(_pool.get());
+					std::memset(p[k], k, size);
+				}
+				for (int k = 0; k < BLOCKS; ++k)
+				{
+					if (p[k][0] != k || p[k][size - 1] != k) _ok = false;
+					_pool.release(p[k]);
+				}
+			}
+		}
+
+		bool ok() const
+		{
+			return _ok;
+		}
+
+		enum
+		{
+			BLOCKS = 3
+		};
+
+	private:
+		Pool& _pool;
+		int _iterations;
+		bool _ok;
+	};
+
+	template <class Pool>
+	Poco::Timestamp::TimeDiff runThreads(Pool& pool, int nThreads, int iterations)
+	{
+		std::vector<Thread*> threads;
+		std::vector<PoolUser<Pool>*> users;
+		for (int i = 0; i < nThreads; ++i)
+		{
+			threads.push_back(new Thread);
+			users.push_back(new PoolUser<Pool>(pool, iterations));
+		}
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < nThreads; ++i)
+		{
+			threads[i]->start(*users[i]);
+		}
+		for (int i = 0; i < nThreads; ++i)
+		{
+			threads[i]->join();
+		}
+		sw.stop();
+		bool ok = true;
+		for (int i = 0; i < nThreads; ++i)
+		{
+			ok = ok && users[i]->ok();
+			delete threads[i];
+			delete users[i];
+		}
+		return ok ? sw.elapsed() : -1;
+	}
+}
+
+
+ShardedMemoryPoolTest::ShardedMemoryPoolTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ShardedMemoryPoolTest::~ShardedMemoryPoolTest()
+{
+}
+
+
+void ShardedMemoryPoolTest::testShardedMemoryPool()
+{
+	ShardedMemoryPool pool1(100, 0, 10, 4);
+
+	assert (pool1.blockSize() == 100);
+	assert (pool1.shards() == 4);
+	assert (pool1.allocated() == 0);
+	assert (pool1.available() == 0);
+
+	std::vector<void*> ptrs;
+	for (int i = 0; i < 10; ++i)
+	{
+		ptrs.push_back(pool1.get());
+		assert (pool1.allocated() == i + 1);
+		assert (pool1.available() == 0);
+	}
+
+	try
+	{
+		pool1.get();
+		fail("pool exhausted - must throw exception");
+	}
+	catch (Poco::OutOfMemoryException&)
+	{
+	}
+
+	int av = 0;
+	for (std::vector<void*>::iterator it = ptrs.begin(); it != ptrs.end(); ++it)
+	{
+		pool1.release(*it);
+		++av;
+		assert (pool1.available() == av);
+	}
+
+	void* ptr = pool1.get();
+	assert (pool1.allocated() == 10);
+	assert (pool1.available() == 9);
+	pool1.release(ptr);
+
+	ShardedMemoryPool pool2(32, 5, 10);
+	assert (pool2.available() == 5);
+	assert (pool2.blockSize() == 32);
+	assert (pool2.allocated() == 5);
+	assert (pool2.shards() > 0);
+}
+
+
+void ShardedMemoryPoolTest::testDepot()
+{
+	const int N = 3*ShardedMemoryPool::BATCH_SIZE;
+
+	ShardedMemoryPool pool(8, 0, 0, 1);
+	std::vector<void*> ptrs;
+	for (int i = 0; i < N; ++i)
+	{
+		ptrs.push_back(pool.get());
+	}
+	assert (pool.allocated() == N);
+	for (std::vector<void*>::iterator it = ptrs.begin(); it != ptrs.end(); ++it)
+	{
+		pool.release(*it);
+	}
+	assert (pool.available() == N);
+
+	// blocks drained to the depot are reused
+	ptrs.clear();
+	for (int i = 0; i < N; ++i)
+	{
+		ptrs.push_back(pool.get());
+	}
+	assert (pool.allocated() == N);
+	assert (pool.available() == 0);
+	for (std::vector<void*>::iterator it = ptrs.begin(); it != ptrs.end(); ++it)
+	{
+		pool.release(*it);
+	}
+	assert (pool.available() == N);
+}
+
+
+void ShardedMemoryPoolTest::testSteal()
+{
+	ShardedMemoryPool pool(8, 0, 2, 2);
+	void* p1 = pool.get();
+	void* p2 = pool.get();
+	assert (pool.allocated() == 2);
+
+	// release p2 from another thread, which may use another shard
+	Releaser releaser(pool, p2);
+	Thread thread;
+	thread.start(releaser);
+	thread.join();
+	assert (pool.available() == 1);
+
+	void* p3 = pool.get();
+	assert (p3 == p2);
+	assert (pool.allocated() == 2);
+	assert (pool.available() == 0);
+
+	pool.release(p1);
+	pool.release(p3);
+	assert (pool.available() == 2);
+}
+
+
+void ShardedMemoryPoolTest::testConcurrency()
+{
+	ShardedMemoryPool pool(64, 0, 0, 4);
+	assert (runThreads(pool, 8, 10000) >= 0);
+	assert (pool.available() == pool.allocated());
+	assert (pool.allocated() <= 8*PoolUser<ShardedMemoryPool>::BLOCKS + 4*2*ShardedMemoryPool::BATCH_SIZE);
+}
+
+
+void ShardedMemoryPoolTest::testPerformance()
+{
+	const int ITERATIONS = 100000;
+
+	for (int nThreads = 1; nThreads <= 64; nThreads *= 2)
+	{
+		MemoryPool pool(4096);
+		ShardedMemoryPool shardedPool(4096);
+		Poco::Timestamp::TimeDiff t1 = runThreads(pool, nThreads, ITERATIONS/nThreads);
+		Poco::Timestamp::TimeDiff t2 = runThreads(shardedPool, nThreads, ITERATIONS/nThreads);
+		std::cout << nThreads << " threads: MemoryPool " << t1/1000 << " ms, ShardedMemoryPool " << t2/1000 << " ms" << std::endl;
+	}
+}
+
+
+void ShardedMemoryPoolTest::setUp()
+{
+}
+
+
+void ShardedMemoryPoolTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ShardedMemoryPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ShardedMemoryPoolTest");
+
+	CppUnit_addTest(pSuite, ShardedMemoryPoolTest, testShardedMemoryPool);
+	CppUnit_addTest(pSuite, ShardedMemoryPoolTest, testDepot);
+	CppUnit_addTest(pSuite, ShardedMemoryPoolTest, testSteal);
+	CppUnit_addTest(pSuite, ShardedMemoryPoolTest, testConcurrency);
+	//CppUnit_addTest(pSuite, ShardedMemoryPoolTest, testPerformance);
+
+	return pSuite;
+}
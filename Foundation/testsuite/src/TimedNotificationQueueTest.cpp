@@ -269,6 +269,95 @@ void TimedNotificationQueueTest::testWaitDequeueTimeout()
 }
 
 
+void TimedNotificationQueueTest::testWheel()
+{
+	TimedNotificationQueue queue(1000);
+	assert (queue.empty());
+	assertNullPtr(queue.dequeueNotification());
+	assertNullPtr(queue.waitDequeueNotification(10));
+
+	Poco::Timestamp ts1;
+	ts1 += 100000;
+	Poco::Timestamp ts2;
+	ts2 += 200000;
+	Poco::Timestamp ts3;
+	ts3 += 300000;
+	Poco::Timestamp ts4;
+	ts4 += 400000;
+	
+	queue.enqueueNotification(new QTestNotification("first"), ts1);
+	queue.enqueueNotification(new QTestNotification("fourth"), ts4);
+	queue.enqueueNotification(new QTestNotification("third"), ts3);
+	queue.enqueueNotification(new QTestNotification("second"), ts2);
+	assert (!queue.empty());
+	assert (queue.size() == 4);
+	assertNullPtr(queue.dequeueNotification());
+	assertNullPtr(queue.waitDequeueNotification(20));
+
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "first");
+	pTNf->release();
+	assert (ts1.elapsed() >= 0);
+	assert (queue.size() == 3);
+
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(220));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "second");
+	pTNf->release();
+	assert (ts2.elapsed() >= 0);
+	assert (queue.size() == 2);
+
+	pTNf = 0;
+	while (!pTNf) 
+	{
+		pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	}
+	assert (pTNf->data() == "third");
+	pTNf->release();
+	assert (ts3.elapsed() >= 0);
+	assert (queue.size() == 1);
+
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "fourth");
+	pTNf->release();
+	assert (ts4.elapsed() >= 0);
+	assert (queue.empty());
+	assert (queue.size() == 0);
+
+	Poco::Timestamp past;
+	past -= 1000000;
+	queue.enqueueNotification(new QTestNotification("past"), past);
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(100));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "past");
+	pTNf->release();
+}
+
+
+void TimedNotificationQueueTest::testWheelClear()
+{
+	Notification::Ptr pNf = new QTestNotification("data");
+	{
+		TimedNotificationQueue queue(1000);
+		Poco::Timestamp ts;
+		ts += 1000000;
+		queue.enqueueNotification(pNf, ts);
+		queue.enqueueNotification(pNf, ts);
+		assert (pNf->referenceCount() == 3);
+		queue.clear();
+		assert (queue.empty());
+		assert (pNf->referenceCount() == 1);
+
+		queue.enqueueNotification(pNf, ts);
+		queue.enqueueNotification(pNf, Poco::Timestamp());
+		assert (pNf->referenceCount() == 3);
+	}
+	assert (pNf->referenceCount() == 1);
+}
+
+
 void TimedNotificationQueueTest::setUp()
 {
 }
@@ -286,6 +375,8 @@ CppUnit::Test* TimedNotificationQueueTest::suite()
 	CppUnit_addTest(pSuite, TimedNotificationQueueTest, testDequeue);
 	CppUnit_addTest(pSuite, TimedNotificationQueueTest, testWaitDequeue);
 	CppUnit_addTest(pSuite, TimedNotificationQueueTest, testWaitDequeueTimeout);
+	CppUnit_addTest(pSuite, TimedNotificationQueueTest, testWheel);
+	CppUnit_addTest(pSuite, TimedNotificationQueueTest, testWheelClear);
 
 	return pSuite;
 }
@@ -52,6 +52,8 @@ public:
 	void testDequeue();
 	void testWaitDequeue();
 	void testWaitDequeueTimeout();
+	void testWheel();
+	void testWheelClear();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,362 @@
+//
+// TimingWheelTest.cpp
+//
+// $Id: //poco/1.4/Foundation/testsuite/src/TimingWheelTest.cpp#1 $
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "TimingWheelTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/TimingWheel.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include <iostream>
+
+
+using Poco::TimingWheel;
+using Poco::Timestamp;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class TestEntry: public TimingWheel::Entry
+	{
+	public:
+		TestEntry(int id = 0): _id(id)
+		{
+		}
+
+		int id() const
+		{
+			return _id;
+		}
+
+	private:
+		int _id;
+	};
+
+	const Timestamp::TimeDiff MS = 1000;
+}
+
+
+TimingWheelTest::TimingWheelTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+TimingWheelTest::~TimingWheelTest()
+{
+}
+
+
+void TimingWheelTest::testSchedule()
+{
+	Timestamp start;
+	TimingWheel wheel;
+	assert (wheel.empty());
+	assert (wheel.resolution() == 1000);
+
+	TestEntry e1(1);
+	TestEntry e2(2);
+	TestEntry e3(3);
+	wheel.schedule(e3, start + 30*MS);
+	wheel.schedule(e1, start + 10*MS);
+	wheel.schedule(e2, start + 20*MS);
+	assert (wheel.size() == 3);
+	assert (e1.isScheduled());
+	assert (e1.time() == start + 10*MS);
+
+	TimingWheel::EntryVec expired;
+	assert (wheel.advance(start + 9*MS, expired) == 0);
+	assert (expired.empty());
+	assert (wheel.advance(start + 11*MS, expired) == 1);
+	assert (expired.size() == 1);
+	assert (expired[0] == &e1);
+	assert (!e1.isScheduled());
+	assert (wheel.size() == 2);
+
+	expired.clear();
+	assert (wheel.advance(start + 31*MS, expired) == 2);
+	assert (expired.size() == 2);
+	assert (expired[0] == &e2);
+	assert (expired[1] == &e3);
+	assert (wheel.empty());
+
+	// a time in the past expires with the next tick
+	expired.clear();
+	wheel.schedule(e1, start);
+	assert (wheel.advance(start + 31*MS, expired) == 0);
+	assert (wheel.advance(start + 33*MS, expired) == 1);
+	assert (expired[0] == &e1);
+
+	try
+	{
+		TimingWheel invalid(0);
+		fail("invalid resolution - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void TimingWheelTest::testCancel()
+{
+	Timestamp start;
+	TimingWheel wheel;
+	TestEntry e1(1);
+	TestEntry e2(2);
+	wheel.schedule(e1, start + 10*MS);
+	wheel.schedule(e2, start + 10*MS);
+	wheel.cancel(e1);
+	assert (!e1.isScheduled());
+	assert (wheel.size() == 1);
+	wheel.cancel(e1);
+	assert (wheel.size() == 1);
+	{
+		TestEntry e3(3);
+		wheel.schedule(e3, start + 10*MS);
+		assert (wheel.size() == 2);
+	}
+	assert (wheel.size() == 1);
+
+	TimingWheel::EntryVec expired;
+	assert (wheel.advance(start + 20*MS, expired) == 1);
+	assert (expired[0] == &e2);
+
+	// an entry moves to another wheel when scheduled there
+	TimingWheel other;
+	wheel.schedule(e1, start + 30*MS);
+	other.schedule(e1, start + 30*MS);
+	assert (wheel.empty());
+	assert (other.size() == 1);
+}
+
+
+void TimingWheelTest::testReschedule()
+{
+	Timestamp start;
+	TimingWheel wheel;
+	TestEntry e1(1);
+	wheel.schedule(e1, start + 10*MS);
+	wheel.schedule(e1, start + 1000*MS);
+	assert (wheel.size() == 1);
+
+	TimingWheel::EntryVec expired;
+	assert (wheel.advance(start + 500*MS, expired) == 0);
+	wheel.schedule(e1, start + 600*MS);
+	assert (wheel.advance(start + 599*MS, expired) == 0);
+	assert (wheel.advance(start + 601*MS, expired) == 1);
+	assert (wheel.empty());
+}
+
+
+void TimingWheelTest::testCascade()
+{
+	// entries in every level of the wheel must
+	// expire neither early nor (more than one tick) late
+	Timestamp start;
+	TimingWheel wheel;
+	static const Timestamp::TimeDiff OFFSETS[] = 
+	{
+		1, 255, 256, 257, 1000, 16383, 16384, 16385, 100000, 
+		1048575, 1048576, 1048577, 5000000, 67108863, 67108864, 67108865
+	};
+	const int COUNT = sizeof(OFFSETS)/sizeof(OFFSETS[0]);
+	const int DENSE = 40000;
+	const int N = DENSE + 8*COUNT;
+	TestEntry* entries = new TestEntry[N];
+	for (int i = 0; i < DENSE; ++i)
+	{
+		wheel.schedule(entries[i], start + i*MS);
+	}
+	for (int i = DENSE; i < N; ++i)
+	{
+		Timestamp::TimeDiff offset = OFFSETS[i % COUNT] + (i - DENSE)/COUNT*777;
+		wheel.schedule(entries[i], start + offset*MS);
+	}
+	assert (wheel.size() == N);
+
+	// advance in irregular steps, checking every expired entry
+	TimingWheel::EntryVec expired;
+	Timestamp::TimeDiff prev = 0;
+	Timestamp::TimeDiff now = 0;
+	Timestamp::TimeDiff step = 1;
+	std::size_t total = 0;
+	while (!wheel.empty())
+	{
+		prev = now;
+		now += step;
+		step = step*3 + 1;
+		if (step > 4000000) step = 97;
+		expired.clear();
+		total += wheel.advance(start + now*MS, expired);
+		for (TimingWheel::EntryVec::const_iterator it = expired.begin(); it != expired.end(); ++it)
+		{
+			assert ((*it)->time() <= start + now*MS);
+			assert ((*it)->time() > start + (prev - 1)*MS);
+		}
+	}
+	assert (total == N);
+	for (int i = 0; i < N; ++i)
+	{
+		assert (!entries[i].isScheduled());
+	}
+	delete [] entries;
+}
+
+
+void TimingWheelTest::testFarFuture()
+{
+	// beyond the range of the outermost wheel (2^32 ticks)
+	Timestamp start;
+	TimingWheel wheel;
+	TestEntry e1(1);
+	Timestamp::TimeDiff days60 = Timestamp::TimeDiff(60)*24*3600*1000*MS;
+	wheel.schedule(e1, start + days60);
+
+	TimingWheel::EntryVec expired;
+	assert (wheel.advance(start + days60/2, expired) == 0);
+	assert (wheel.advance(start + days60 - MS, expired) == 0);
+	assert (e1.isScheduled());
+	assert (wheel.advance(start + days60 + MS, expired) == 1);
+	assert (expired[0] == &e1);
+}
+
+
+void TimingWheelTest::testNextExpiration()
+{
+	Timestamp start;
+	TimingWheel wheel;
+	Timestamp next;
+	assert (!wheel.nextExpiration(next));
+
+	TestEntry e1(1);
+	wheel.schedule(e1, start + 10*MS);
+	assert (wheel.nextExpiration(next));
+	assert (next >= start + 10*MS && next <= start + 11*MS);
+
+	// outer wheels give a lower bound
+	TestEntry e2(2);
+	wheel.schedule(e2, start + 100000*MS);
+	wheel.cancel(e1);
+	assert (wheel.nextExpiration(next));
+	assert (next > start + 10*MS && next <= start + 100000*MS);
+
+	TimingWheel::EntryVec expired;
+	while (expired.empty())
+	{
+		assert (wheel.nextExpiration(next));
+		assert (wheel.advance(next - 1, expired) == 0);
+		wheel.advance(next, expired);
+	}
+	assert (expired[0] == &e2);
+	assert (next >= start + 100000*MS);
+}
+
+
+void TimingWheelTest::testClear()
+{
+	Timestamp start;
+	TestEntry e1(1);
+	TestEntry e2(2);
+	{
+		TimingWheel wheel;
+		wheel.schedule(e1, start + 10*MS);
+		wheel.schedule(e2, start + 100000*MS);
+		TimingWheel::EntryVec cancelled;
+		wheel.clear(cancelled);
+		assert (cancelled.size() == 2);
+		assert (wheel.empty());
+		assert (!e1.isScheduled());
+		assert (!e2.isScheduled());
+		assert (wheel.advance(start + 200000*MS, cancelled) == 0);
+
+		wheel.schedule(e1, start + 10*MS);
+	}
+	assert (!e1.isScheduled());
+}
+
+
+void TimingWheelTest::testPerformance()
+{
+	const int N = 100000;
+	TestEntry* entries = new TestEntry[N];
+	Timestamp start;
+	TimingWheel wheel;
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < N; ++i)
+	{
+		wheel.schedule(entries[i], start + (i % 30000)*MS);
+	}
+	for (int round = 0; round < 10; ++round)
+	{
+		for (int i = 0; i < N; ++i)
+		{
+			wheel.schedule(entries[i], start + (i % 30000 + round)*MS);
+		}
+	}
+	TimingWheel::EntryVec expired;
+	expired.reserve(N);
+	wheel.advance(start + 40000*MS, expired);
+	sw.stop();
+	delete [] entries;
+	assert (expired.size() == N);
+	std::cout << "TimingWheel: " << 11*N << " schedules, " << N << " expirations: " << sw.elapsed()/1000 << " ms" << std::endl;
+}
+
+
+void TimingWheelTest::setUp()
+{
+}
+
+
+void TimingWheelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* TimingWheelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TimingWheelTest");
+
+	CppUnit_addTest(pSuite, TimingWheelTest, testSchedule);
+	CppUnit_addTest(pSuite, TimingWheelTest, testCancel);
+	CppUnit_addTest(pSuite, TimingWheelTest, testReschedule);
+	CppUnit_addTest(pSuite, TimingWheelTest, testCascade);
+	CppUnit_addTest(pSuite, TimingWheelTest, testFarFuture);
+	CppUnit_addTest(pSuite, TimingWheelTest, testNextExpiration);
+	CppUnit_addTest(pSuite, TimingWheelTest, testClear);
+	//CppUnit_addTest(pSuite, TimingWheelTest, testPerformance);
+
+	return pSuite;
+}
@@ -0,0 +1,236 @@
+//
+// BufferedSocketHandler.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/BufferedSocketHandler.h#1 $
+//
+// Library: Net
+// Package: Reactor
+// Module:  BufferedSocketHandler
+//
+// Definition of the BufferedSocketHandler class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_BufferedSocketHandler_INCLUDED
+#define Net_BufferedSocketHandler_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/FIFOBuffer.h"
+#include "Poco/Exception.h"
+#include <string>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API BufferedSocketHandler
+	/// BufferedSocketHandler is a base class for non-blocking
+	/// service handlers (see SocketAcceptor), which takes care of
+	/// input and output buffering for a connection served by a
+	/// SocketReactor.
+	///
+	/// The socket is put into non-blocking mode. Whenever the socket
+	/// becomes readable, all available data is read into the input
+	/// buffer, and onData() is called. onData() consumes as much
+	/// of the input buffer as it can process (e.g., all complete
+	/// messages) and leaves the rest in the buffer for the next call.
+	/// If onData() does not consume anything from a full input buffer,
+	/// the input buffer is enlarged, up to the maximum input buffer
+	/// size (see setMaxInputSize()). If the input buffer is full at
+	/// its maximum size, the connection fails with a NetException,
+	/// which is passed to onError(), so that a peer cannot make the
+	/// handler buffer an incomplete message of unlimited size.
+	///
+	/// Data passed to send() is sent immediately, as far as the
+	/// socket accepts it without blocking. Data that cannot be sent
+	/// immediately is kept in the output buffer, and the handler
+	/// registers itself for WritableNotification until the output
+	/// buffer has been written completely. This way, sockets are only
+	/// polled for writability while there actually is data to be written.
+	///
+	/// A BufferedSocketHandler must be created with new and destroys
+	/// itself when the connection is closed (after close() has been
+	/// called and all pending output has been sent, after an error,
+	/// or when the SocketReactor shuts down).
+	///
+	/// Subclasses must call start() at the end of their constructor,
+	/// to register the handler with the SocketReactor. Registering
+	/// the handler in the base class constructor could result in
+	/// notifications being dispatched (by the reactor thread) before
+	/// the subclass object has been fully constructed.
+	///
+	/// A BufferedSocketHandler is not thread safe. All methods
+	/// (including send() and close()) must only be called from
+	/// the reactor thread, i.e., from the handler callbacks.
+{
+public:
+	enum
+	{
+		DEFAULT_BUFFER_SIZE    = 4096,
+		DEFAULT_MAX_INPUT_SIZE = 1024*1024
+	};
+
+	BufferedSocketHandler(const StreamSocket& socket, SocketReactor& reactor, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+		/// Creates the BufferedSocketHandler for the given socket,
+		/// using input and output buffers with the given initial size.
+
+	virtual ~BufferedSocketHandler();
+		/// Unregisters the handler from the SocketReactor
+		/// and closes the socket.
+
+	void send(const char* buffer, std::size_t length);
+		/// Sends the given data, or queues it in the output
+		/// buffer if it cannot be sent without blocking.
+
+	void send(const std::string& data);
+		/// Sends the given data, or queues it in the output
+		/// buffer if it cannot be sent without blocking.
+
+	void close();
+		/// Closes the connection and destroys the handler, as soon
+		/// as all pending output has been sent. No more data
+		/// will be read from the socket.
+
+	void setMaxInputSize(std::size_t size);
+		/// Sets the maximum size of the input buffer, which is the
+		/// maximum size of data received but not yet consumed by onData().
+		/// Defaults to DEFAULT_MAX_INPUT_SIZE.
+
+	std::size_t getMaxInputSize() const;
+		/// Returns the maximum size of the input buffer.
+
+	std::size_t pendingOutput() const;
+		/// Returns the number of bytes in the output buffer, which
+		/// are waiting for the socket to become writable.
+
+	StreamSocket& socket();
+		/// Returns the socket.
+
+	SocketReactor& reactor();
+		/// Returns the SocketReactor.
+
+protected:
+	void start();
+		/// Registers the handler with the SocketReactor.
+		/// Must be called by subclasses at the end of
+		/// their constructor.
+
+	virtual void onData(Poco::FIFOBuffer& input) = 0;
+		/// Called when new data has been received.
+		///
+		/// Implementations must remove the data they have processed
+		/// from the input buffer (using read() or drain()).
+
+	virtual void onDrained();
+		/// Called when all data pending in the output buffer
+		/// has been sent.
+		///
+		/// The default implementation does nothing.
+
+	virtual void onPeerShutdown();
+		/// Called when the peer has shut down the connection
+		/// (i.e., a read returned 0 bytes).
+		///
+		/// The default implementation calls close().
+
+	virtual void onError(const Poco::Exception& exc);
+		/// Called when an error occurs on the socket.
+		/// The handler will be destroyed afterwards.
+		///
+		/// The default implementation does nothing.
+
+private:
+	BufferedSocketHandler();
+	BufferedSocketHandler(const BufferedSocketHandler&);
+	BufferedSocketHandler& operator = (const BufferedSocketHandler&);
+
+	void onReadable(ReadableNotification* pNf);
+	void onWritable(WritableNotification* pNf);
+	void onSocketError(ErrorNotification* pNf);
+	void onReactorShutdown(ShutdownNotification* pNf);
+	void receive();
+	void flush();
+	void update();
+	void enableReadable(bool flag);
+	void enableWritable(bool flag);
+
+	StreamSocket      _socket;
+	SocketReactor&    _reactor;
+	Poco::FIFOBuffer  _input;
+	Poco::FIFOBuffer  _output;
+	std::size_t       _maxInputSize;
+	bool              _started;
+	bool              _readable;
+	bool              _writable;
+	bool              _closing;
+	bool              _failed;
+};
+
+
+//
+// inlines
+//
+inline void BufferedSocketHandler::setMaxInputSize(std::size_t size)
+{
+	_maxInputSize = size;
+}
+
+
+inline std::size_t BufferedSocketHandler::getMaxInputSize() const
+{
+	return _maxInputSize;
+}
+
+
+inline std::size_t BufferedSocketHandler::pendingOutput() const
+{
+	return _output.used();
+}
+
+
+inline StreamSocket& BufferedSocketHandler::socket()
+{
+	return _socket;
+}
+
+
+inline SocketReactor& BufferedSocketHandler::reactor()
+{
+	return _reactor;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_BufferedSocketHandler_INCLUDED
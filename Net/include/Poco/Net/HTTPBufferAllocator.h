@@ -41,7 +41,7 @@
 
 
 #include "Poco/Net/Net.h"
-#include "Poco/MemoryPool.h"
+#include "Poco/ShardedMemoryPool.h"
 #include <ios>
 
 
@@ -62,7 +62,7 @@ public:
 	};
 
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ShardedMemoryPool _pool;
 };
 
 
@@ -42,7 +42,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPBasicStreamBuf.h"
-#include "Poco/MemoryPool.h"
+#include "Poco/ShardedMemoryPool.h"
 #include <cstddef>
 #include <istream>
 #include <ostream>
@@ -102,7 +102,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ShardedMemoryPool _pool;
 };
 
 
@@ -117,7 +117,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ShardedMemoryPool _pool;
 };
 
 
@@ -101,7 +101,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ShardedMemoryPool _pool;
 };
 
 
@@ -116,7 +116,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ShardedMemoryPool _pool;
 };
 
 
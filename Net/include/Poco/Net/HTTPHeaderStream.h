@@ -42,7 +42,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPBasicStreamBuf.h"
-#include "Poco/MemoryPool.h"
+#include "Poco/ShardedMemoryPool.h"
 #include <cstddef>
 #include <istream>
 #include <ostream>
@@ -72,6 +72,8 @@ protected:
 private:
 	HTTPSession& _session;
 	bool         _end;
+	std::size_t  _lineLength;
+	bool         _lineCR;
 };
 
 
@@ -99,7 +101,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ShardedMemoryPool _pool;
 };
 
 
@@ -114,7 +116,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ShardedMemoryPool _pool;
 };
 
 
@@ -0,0 +1,174 @@
+//
+// HTTPKeepAliveReactor.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/HTTPKeepAliveReactor.h#1 $
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPKeepAliveReactor
+//
+// Definition of the HTTPKeepAliveReactor class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_HTTPKeepAliveReactor_INCLUDED
+#define Net_HTTPKeepAliveReactor_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
+#include <set>
+#include <map>
+#include <string>
+
+
+namespace Poco {
+namespace Net {
+
+
+class SocketImpl;
+class TCPServerConnection;
+class TCPServerDispatcher;
+
+
+class Net_API HTTPKeepAliveReactor: public Poco::RefCountedObject
+	/// HTTPKeepAliveReactor is used internally by HTTPServer
+	/// in reactor mode (see HTTPServerParams::setReactorMode()).
+	///
+	/// A HTTPServerConnection that has finished a request on a
+	/// persistent connection parks the connection in the
+	/// HTTPKeepAliveReactor and returns its thread to the server.
+	/// The HTTPKeepAliveReactor watches all parked connections with a
+	/// single SocketReactor thread, and reads the next request header
+	/// as it arrives. As soon as a complete request header (or as much
+	/// of the header as fits into a HTTPSession buffer) has been
+	/// received, the connection is passed back to a connection thread
+	/// (using its own TCPServerDispatcher), which continues serving it
+	/// with a new HTTPServerConnection.
+	///
+	/// Parked connections that do not receive a new request within
+	/// the keep-alive timeout are closed, as are connections
+	/// closed by the client.
+{
+public:
+	typedef Poco::AutoPtr<HTTPKeepAliveReactor> Ptr;
+
+	HTTPKeepAliveReactor(HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory, Poco::ThreadPool& threadPool);
+		/// Creates the HTTPKeepAliveReactor.
+		///
+		/// Resumed connections are served by threads from the
+		/// given thread pool, subject to the limits given in pParams.
+		/// The reactor thread is started when the first connection
+		/// is parked.
+
+	void park(const StreamSocket& socket, int maxKeepAliveRequests);
+		/// Parks the given connection until the client sends its
+		/// next request. maxKeepAliveRequests is the number of requests
+		/// the client may still send over the connection (see
+		/// HTTPServerSession::maxKeepAliveRequests()).
+		///
+		/// If the HTTPKeepAliveReactor has been stopped, the
+		/// connection is closed.
+
+	void stop();
+		/// Stops the reactor thread and closes all parked connections.
+		///
+		/// Connections that have already been passed back to
+		/// a connection thread continue being served.
+
+	int parkedConnections() const;
+		/// Returns the number of currently parked connections.
+
+	int resumedConnections() const;
+		/// Returns the total number of connections that have been
+		/// passed back to a connection thread.
+
+protected:
+	~HTTPKeepAliveReactor();
+		/// Destroys the HTTPKeepAliveReactor.
+
+private:
+	class Reactor;
+	class ParkedConnection;
+	class ConnectionFactory;
+
+	struct ResumeData
+	{
+		StreamSocket socket;
+		std::string  data;
+		int          maxKeepAliveRequests;
+	};
+
+	typedef std::set<ParkedConnection*> ParkedSet;
+	typedef std::map<SocketImpl*, ResumeData> ResumeMap;
+
+	enum
+	{
+		SWEEP_INTERVAL = 250000
+	};
+
+	HTTPKeepAliveReactor();
+	HTTPKeepAliveReactor(const HTTPKeepAliveReactor&);
+	HTTPKeepAliveReactor& operator = (const HTTPKeepAliveReactor&);
+
+	void resume(ParkedConnection* pConnection);
+	void discard(ParkedConnection* pConnection);
+	void sweep();
+	TCPServerConnection* createConnection(const StreamSocket& socket);
+
+	HTTPServerParams::Ptr          _pParams;
+	HTTPRequestHandlerFactory::Ptr _pFactory;
+	Reactor*                       _pReactor;
+	Poco::Thread                   _thread;
+	TCPServerDispatcher*           _pDispatcher;
+	ParkedSet                      _parked;
+	ResumeMap                      _resumed;
+	int                            _resumedConnections;
+	Poco::Timestamp                _lastSweep;
+	bool                           _started;
+	bool                           _stopped;
+	mutable Poco::FastMutex        _mutex;
+
+	friend class Reactor;
+	friend class ParkedConnection;
+	friend class ConnectionFactory;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPKeepAliveReactor_INCLUDED
@@ -69,6 +69,16 @@ class Net_API HTTPServer: public TCPServer
 	/// Please see the TCPServer class for information about
 	/// connection and thread handling.
 	///
+	/// By default, a persistent connection occupies a connection
+	/// thread for its entire lifetime, even while it waits for the
+	/// client's next request. If reactor mode is enabled in the
+	/// HTTPServerParams, persistent connections that wait for the next
+	/// request are parked in a HTTPKeepAliveReactor instead. A parked
+	/// connection does not occupy a thread, and is handed over to a
+	/// connection thread again when a complete request header has
+	/// been received. This allows serving a large number of mostly
+	/// idle persistent connections with a small number of threads.
+	///
 	/// See RFC 2616 <http://www.faqs.org/rfcs/rfc2616.html> for more
 	/// information about the HTTP protocol.
 {
@@ -45,6 +45,8 @@
 #include "Poco/Net/HTTPResponse.h"
 #include "Poco/Net/HTTPRequestHandlerFactory.h"
 #include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPKeepAliveReactor.h"
+#include <string>
 
 
 namespace Poco {
@@ -62,18 +64,38 @@ public:
 	HTTPServerConnection(const StreamSocket& socket, HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory);
 		/// Creates the HTTPServerConnection.
 
+	HTTPServerConnection(const StreamSocket& socket, HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory, HTTPKeepAliveReactor::Ptr pKeepAliveReactor);
+		/// Creates the HTTPServerConnection for a HTTPServer
+		/// in reactor mode.
+		///
+		/// Instead of waiting for the next request on a persistent
+		/// connection, the connection is parked in the given
+		/// HTTPKeepAliveReactor, which frees the connection thread.
+
 	virtual ~HTTPServerConnection();
 		/// Destroys the HTTPServerConnection.
 		
 	void run();
 		/// Handles all HTTP requests coming in.
 
+	void resume(const char* buffer, std::size_t length, int maxKeepAliveRequests);
+		/// Prepares the connection for continuing a persistent
+		/// connection that has been parked in a HTTPKeepAliveReactor.
+		/// See HTTPServerSession::resume() for a description
+		/// of the arguments.
+		///
+		/// Must be called before the connection is started.
+
 protected:
 	void sendErrorResponse(HTTPServerSession& session, HTTPResponse::HTTPStatus status);
 
 private:
 	HTTPServerParams::Ptr          _pParams;
 	HTTPRequestHandlerFactory::Ptr _pFactory;
+	HTTPKeepAliveReactor::Ptr      _pKeepAliveReactor;
+	bool                           _resumed;
+	std::string                    _resumeData;
+	int                            _maxKeepAliveRequests;
 };
 
 
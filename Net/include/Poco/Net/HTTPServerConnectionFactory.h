@@ -44,6 +44,8 @@
 #include "Poco/Net/TCPServerConnectionFactory.h"
 #include "Poco/Net/HTTPRequestHandlerFactory.h"
 #include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPKeepAliveReactor.h"
+#include "Poco/ThreadPool.h"
 
 
 namespace Poco {
@@ -57,6 +59,17 @@ class Net_API HTTPServerConnectionFactory: public TCPServerConnectionFactory
 public:
 	HTTPServerConnectionFactory(HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory);
 		/// Creates the HTTPServerConnectionFactory.
+		///
+		/// If reactor mode is enabled in the given HTTPServerParams,
+		/// resumed connections are served by threads from
+		/// the default thread pool.
+
+	HTTPServerConnectionFactory(HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory, Poco::ThreadPool& threadPool);
+		/// Creates the HTTPServerConnectionFactory.
+		///
+		/// If reactor mode is enabled in the given HTTPServerParams,
+		/// resumed connections are served by threads from
+		/// the given thread pool.
 
 	~HTTPServerConnectionFactory();
 		/// Destroys the HTTPServerConnectionFactory.
@@ -68,6 +81,7 @@ public:
 private:
 	HTTPServerParams::Ptr          _pParams;
 	HTTPRequestHandlerFactory::Ptr _pFactory;
+	HTTPKeepAliveReactor::Ptr      _pKeepAliveReactor;
 };
 
 
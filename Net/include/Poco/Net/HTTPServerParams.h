@@ -65,6 +65,7 @@ public:
 		///   - keepAlive:            true
 		///   - maxKeepAliveRequests: 0
 		///   - keepAliveTimeout:     10 seconds
+		///   - reactorMode:          false
 		
 	void setServerName(const std::string& serverName);
 		/// Sets the name and port (name:port) that the server uses to identify itself.
@@ -117,6 +118,23 @@ public:
 		/// during a persistent connection, or 0 if
 		/// unlimited connections are allowed.
 
+	void setReactorMode(bool reactorMode);
+		/// Enables (reactorMode == true) or disables (reactorMode == false)
+		/// the event-driven handling of idle connections.
+		///
+		/// Normally, a persistent connection occupies a connection
+		/// thread for its entire lifetime, including the time it
+		/// spends waiting for the next request. In reactor mode,
+		/// connections waiting for a request are handed over to a
+		/// SocketReactor (see HTTPKeepAliveReactor), and are only
+		/// given back to a connection thread when a complete request
+		/// header has been received. Thus, idle connections do not
+		/// occupy any threads.
+
+	bool getReactorMode() const;
+		/// Returns true iff the event-driven handling of
+		/// idle connections is enabled.
+
 protected:
 	virtual ~HTTPServerParams();
 		/// Destroys the HTTPServerParams.
@@ -128,6 +146,7 @@ private:
 	bool           _keepAlive;
 	int            _maxKeepAliveRequests;
 	Poco::Timespan _keepAliveTimeout;
+	bool           _reactorMode;
 };
 
 
@@ -170,6 +189,12 @@ inline const Poco::Timespan& HTTPServerParams::getKeepAliveTimeout() const
 }
 
 
+inline bool HTTPServerParams::getReactorMode() const
+{
+	return _reactorMode;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -69,6 +69,26 @@ public:
 	
 	bool canKeepAlive() const;
 		/// Returns true if the session can be kept alive.
+
+	bool idle();
+		/// Returns true if the client may send another request
+		/// over this session, but nothing of it has been
+		/// received yet.
+
+	int maxKeepAliveRequests() const;
+		/// Returns the number of requests that may still be
+		/// sent over this session, or a negative number if the
+		/// number of requests is not limited.
+
+	void resume(const char* buffer, std::size_t length, int maxKeepAliveRequests);
+		/// Resumes a persistent connection that has been parked
+		/// in a HTTPKeepAliveReactor while waiting for the next
+		/// request.
+		///
+		/// The given data, which has already been received from the
+		/// socket, is put into the session's buffer. maxKeepAliveRequests
+		/// must be the value returned by maxKeepAliveRequests() before
+		/// the connection has been parked.
 	
 	SocketAddress clientAddress();
 		/// Returns the client's address.
@@ -92,6 +112,12 @@ inline bool HTTPServerSession::canKeepAlive() const
 }
 
 
+inline int HTTPServerSession::maxKeepAliveRequests() const
+{
+	return _maxKeepAliveRequests;
+}
+
+
 } } // namespace Poco::Net
 
 
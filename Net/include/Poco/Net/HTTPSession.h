@@ -170,6 +170,15 @@ protected:
 
 	void refill();
 		/// Refills the internal buffer.
+
+	void refill(const char* buffer, std::size_t length);
+		/// Refills the internal buffer with the given data,
+		/// which has already been received from the socket
+		/// by other means. Subsequent reads will return this
+		/// data first.
+		///
+		/// The internal buffer must be empty, and length must
+		/// not exceed HTTPBufferAllocator::BUFFER_SIZE.
 		
 	virtual void connect(const SocketAddress& address);
 		/// Connects the underlying socket to the given address
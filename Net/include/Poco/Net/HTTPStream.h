@@ -42,7 +42,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPBasicStreamBuf.h"
-#include "Poco/MemoryPool.h"
+#include "Poco/ShardedMemoryPool.h"
 #include <cstddef>
 #include <istream>
 #include <ostream>
@@ -100,7 +100,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ShardedMemoryPool _pool;
 };
 
 
@@ -115,7 +115,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ShardedMemoryPool _pool;
 };
 
 
@@ -96,6 +96,18 @@ public:
 		/// containing \r\n or \n), as well as at the end of
 		/// the stream.
 		///
+		/// If the complete header is already available in the
+		/// stream's buffer, it is parsed in place, using a
+		/// MessageHeaderParser. HTTPHeaderInputStream, which is
+		/// used by the HTTP server and client, buffers complete
+		/// headers of up to HTTPBufferAllocator::BUFFER_SIZE bytes
+		/// for this purpose.
+		///
+		/// In any case, all names and values are copied into the
+		/// MessageHeader. Code that only needs a few fields of a
+		/// header available in a buffer can use a MessageHeaderParser
+		/// directly, which only creates strings for these fields.
+		///
 		/// Some basic sanity checking of the input stream is
 		/// performed.
 		///
@@ -148,6 +160,8 @@ private:
 		MAX_NAME_LENGTH  = 256,
 		MAX_VALUE_LENGTH = 4096
 	};
+
+	friend class MessageHeaderParser;
 };
 
 
@@ -0,0 +1,168 @@
+//
+// MessageHeaderParser.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/MessageHeaderParser.h#1 $
+//
+// Library: Net
+// Package: Messages
+// Module:  MessageHeaderParser
+//
+// Definition of the MessageHeaderParser class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_MessageHeaderParser_INCLUDED
+#define Net_MessageHeaderParser_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/NameValueCollection.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API MessageHeaderParser
+	/// MessageHeaderParser parses a message header in RFC 2822
+	/// format (see MessageHeader) in place, directly from a
+	/// memory buffer.
+	///
+	/// In contrast to MessageHeader::read(), which reads the header
+	/// character by character from a stream, MessageHeaderParser
+	/// locates line ends and colons with memchr(), and does not copy
+	/// anything. The header fields are stored as offsets into the
+	/// buffer, and strings are only created when a field's name
+	/// or value is requested.
+	///
+	/// Therefore, the buffer must remain valid and unchanged
+	/// as long as fields are being accessed.
+	///
+	/// The parser accepts the same input as MessageHeader::read(),
+	/// and yields the same names and values.
+{
+public:
+	MessageHeaderParser();
+		/// Creates the MessageHeaderParser.
+
+	~MessageHeaderParser();
+		/// Destroys the MessageHeaderParser.
+
+	bool parse(const char* buffer, std::size_t length);
+		/// Parses the header fields in the given buffer.
+		///
+		/// Returns true if the buffer contains the complete header,
+		/// up to the empty line (or at least the first character
+		/// of the empty line) terminating it.
+		///
+		/// Returns false if the header is incomplete, or if it
+		/// contains fields exceeding the limits imposed by
+		/// MessageHeader::read(), or malformed line ends. In the
+		/// latter case, MessageHeader::read() will throw a
+		/// MessageException with a detailed error message.
+
+	std::size_t length() const;
+		/// Returns the length of the parsed header fields,
+		/// not including the terminating empty line.
+
+	std::size_t count() const;
+		/// Returns the number of header fields.
+
+	std::string name(std::size_t index) const;
+		/// Returns the name of the header field with the given index.
+
+	std::string value(std::size_t index) const;
+		/// Returns the value of the header field with the given index.
+		///
+		/// Folded values are unfolded.
+
+	bool has(const std::string& name) const;
+		/// Returns true if there is at least one
+		/// header field with the given name.
+		///
+		/// Names are compared case-insensitively.
+
+	std::string get(const std::string& name) const;
+		/// Returns the value of the first header field
+		/// with the given name.
+		///
+		/// Throws a NotFoundException if the field does not exist.
+
+	const std::string get(const std::string& name, const std::string& defaultValue) const;
+		/// Returns the value of the first header field with the
+		/// given name, or defaultValue if the field does not exist.
+
+	void copyTo(NameValueCollection& collection) const;
+		/// Adds all header fields to the given collection.
+		///
+		/// Names and values are assigned to temporary strings
+		/// that are reused for all fields, so the only copies
+		/// made are the ones stored in the collection.
+
+private:
+	struct Field
+	{
+		std::size_t nameOffset;
+		std::size_t nameLength;
+		std::size_t valueOffset;
+		std::size_t valueLength;
+		bool        folded;
+	};
+
+	typedef std::vector<Field> FieldVec;
+
+	int find(const std::string& name) const;
+	void assignValue(const Field& field, std::string& value) const;
+
+	const char* _pBuffer;
+	std::size_t _length;
+	FieldVec    _fields;
+};
+
+
+//
+// inlines
+//
+inline std::size_t MessageHeaderParser::length() const
+{
+	return _length;
+}
+
+
+inline std::size_t MessageHeaderParser::count() const
+{
+	return _fields.size();
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_MessageHeaderParser_INCLUDED
@@ -0,0 +1,286 @@
+//
+// ParallelSocketAcceptor.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/ParallelSocketAcceptor.h#1 $
+//
+// Library: Net
+// Package: Reactor
+// Module:  ParallelSocketAcceptor
+//
+// Definition of the ParallelSocketAcceptor class template.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_ParallelSocketAcceptor_INCLUDED
+#define Net_ParallelSocketAcceptor_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/ParallelSocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Observer.h"
+#include "Poco/Environment.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Mutex.h"
+#include <vector>
+
+
+namespace Poco {
+namespace Net {
+
+
+template <class ServiceHandler, class SR = SocketReactor>
+class ParallelSocketAcceptor
+	/// This class implements the Acceptor part of the
+	/// Acceptor-Connector design pattern, like SocketAcceptor,
+	/// but distributes the accepted connections over a number
+	/// of reactor threads, so that a reactor-based server can
+	/// make use of more than one processor.
+	///
+	/// The ParallelSocketAcceptor owns a pool of ParallelSocketReactor
+	/// objects (each running in its own thread). The number of
+	/// reactors defaults to the number of processors in the system.
+	///
+	/// The ParallelSocketAcceptor can work in two modes:
+	///
+	///   - Shared socket mode: a single ServerSocket is registered
+	///     with a SocketReactor (either given in the constructor or
+	///     via registerAcceptor()). When a connection request arrives,
+	///     the connection is accepted and the ServiceHandler is created
+	///     for the next reactor in the pool (round-robin). Subclasses
+	///     can override reactor() to implement a different policy.
+	///
+	///   - Reuse port mode: every reactor in the pool owns its own
+	///     listening ServerSocket, all bound to the same address with
+	///     SO_REUSEPORT. The operating system distributes incoming
+	///     connections over the sockets, and each connection is
+	///     serviced by the reactor that accepted it, so no connection
+	///     is ever handed over between threads. This mode requires
+	///     operating system support for SO_REUSEPORT with load
+	///     balancing (e.g., Linux 3.9 or newer).
+	///
+	/// The ServiceHandler class must provide a constructor that
+	/// takes a StreamSocket and a SocketReactor as arguments,
+	/// e.g.:
+	///     MyServiceHandler(const StreamSocket& socket, SocketReactor& reactor)
+	///
+	/// When the ServiceHandler is done, it must destroy itself.
+	///
+	/// Subclasses can override the createServiceHandler() factory method
+	/// if special steps are necessary to create a ServiceHandler object.
+{
+public:
+	typedef Poco::Net::ParallelSocketReactor<SR> ParallelReactor;
+	typedef typename ParallelReactor::Ptr        ReactorPtr;
+	typedef std::vector<ReactorPtr>              ReactorVec;
+
+	explicit ParallelSocketAcceptor(ServerSocket& socket, unsigned threads = Poco::Environment::processorCount()):
+		_pReactor(0),
+		_next(0),
+		_reusePort(false)
+		/// Creates a ParallelSocketAcceptor in shared socket mode,
+		/// using the given number of reactor threads.
+		///
+		/// The acceptor must be registered with a SocketReactor
+		/// with registerAcceptor() to start accepting connections.
+	{
+		_sockets.push_back(socket);
+		init(threads);
+	}
+
+	ParallelSocketAcceptor(ServerSocket& socket, SocketReactor& reactor, unsigned threads = Poco::Environment::processorCount()):
+		_pReactor(0),
+		_next(0),
+		_reusePort(false)
+		/// Creates a ParallelSocketAcceptor in shared socket mode,
+		/// using the given number of reactor threads, and registers
+		/// it with the given SocketReactor, which accepts the connections.
+	{
+		_sockets.push_back(socket);
+		init(threads);
+		registerAcceptor(reactor);
+	}
+
+	ParallelSocketAcceptor(const SocketAddress& address, unsigned threads = Poco::Environment::processorCount(), int backlog = 64):
+		_pReactor(0),
+		_next(0),
+		_reusePort(true)
+		/// Creates a ParallelSocketAcceptor in reuse port mode.
+		///
+		/// One ServerSocket is created for each of the given number of
+		/// reactor threads. All sockets are bound to the given address,
+		/// with SO_REUSEADDR and SO_REUSEPORT set, and each socket is
+		/// registered with its own reactor.
+		///
+		/// If the port number of the given address is 0, the first socket
+		/// is bound to an ephemeral port, and all other sockets are bound
+		/// to the same port.
+	{
+		init(threads);
+		SocketAddress bindAddress(address);
+		for (typename ReactorVec::iterator it = _reactors.begin(); it != _reactors.end(); ++it)
+		{
+			ServerSocket socket;
+			socket.bind(bindAddress, true);
+			socket.listen(backlog);
+			bindAddress = socket.address();
+			_sockets.push_back(socket);
+		}
+		for (std::size_t i = 0; i < _reactors.size(); ++i)
+		{
+			_reactors[i]->addEventHandler(_sockets[i], Poco::Observer<ParallelSocketAcceptor, ReadableNotification>(*this, &ParallelSocketAcceptor::onAccept));
+		}
+	}
+
+	virtual ~ParallelSocketAcceptor()
+		/// Destroys the ParallelSocketAcceptor and stops its reactor threads.
+	{
+		try
+		{
+			unregisterAcceptor();
+			if (reusePort())
+			{
+				for (std::size_t i = 0; i < _reactors.size(); ++i)
+				{
+					_reactors[i]->removeEventHandler(_sockets[i], Poco::Observer<ParallelSocketAcceptor, ReadableNotification>(*this, &ParallelSocketAcceptor::onAccept));
+				}
+			}
+		}
+		catch (...)
+		{
+			Poco::ErrorHandler::handle();
+		}
+	}
+
+	virtual void registerAcceptor(SocketReactor& reactor)
+		/// Registers the ParallelSocketAcceptor with a SocketReactor,
+		/// which then accepts connections on the shared server socket.
+		///
+		/// Must not be used in reuse port mode.
+	{
+		poco_assert (!reusePort());
+
+		_pReactor = &reactor;
+		_pReactor->addEventHandler(_sockets[0], Poco::Observer<ParallelSocketAcceptor, ReadableNotification>(*this, &ParallelSocketAcceptor::onAccept));
+	}
+
+	virtual void unregisterAcceptor()
+		/// Unregisters the ParallelSocketAcceptor from the SocketReactor
+		/// given to registerAcceptor().
+	{
+		if (_pReactor)
+		{
+			_pReactor->removeEventHandler(_sockets[0], Poco::Observer<ParallelSocketAcceptor, ReadableNotification>(*this, &ParallelSocketAcceptor::onAccept));
+			_pReactor = 0;
+		}
+	}
+
+	void onAccept(ReadableNotification* pNotification)
+	{
+		pNotification->release();
+		ServerSocket server(pNotification->socket());
+		StreamSocket sock = server.acceptConnection();
+		if (reusePort())
+			createServiceHandler(sock, pNotification->source());
+		else
+			createServiceHandler(sock, *reactor());
+	}
+
+	SocketAddress address() const
+		/// Returns the address the server socket(s) are bound to.
+	{
+		return _sockets[0].address();
+	}
+
+	std::size_t threads() const
+		/// Returns the number of reactor threads.
+	{
+		return _reactors.size();
+	}
+
+protected:
+	virtual ServiceHandler* createServiceHandler(StreamSocket& socket, SocketReactor& reactor)
+	{
+		return new ServiceHandler(socket, reactor);
+	}
+
+	virtual SocketReactor* reactor()
+		/// Returns the reactor for the next connection, in
+		/// shared socket mode. The default implementation
+		/// cycles through all reactors in the pool.
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (_next == _reactors.size()) _next = 0;
+		return _reactors[_next++].get();
+	}
+
+	ReactorVec& reactors()
+	{
+		return _reactors;
+	}
+
+	bool reusePort() const
+		/// Returns true iff the acceptor works in reuse port mode.
+	{
+		return _reusePort;
+	}
+
+private:
+	void init(unsigned threads)
+	{
+		poco_assert (threads > 0);
+
+		_reactors.reserve(threads);
+		for (unsigned i = 0; i < threads; ++i)
+		{
+			_reactors.push_back(new ParallelReactor);
+		}
+	}
+
+	ParallelSocketAcceptor();
+	ParallelSocketAcceptor(const ParallelSocketAcceptor&);
+	ParallelSocketAcceptor& operator = (const ParallelSocketAcceptor&);
+
+	std::vector<ServerSocket> _sockets;
+	SocketReactor*            _pReactor;
+	ReactorVec                _reactors;
+	std::size_t               _next;
+	bool                      _reusePort;
+	Poco::FastMutex           _mutex;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_ParallelSocketAcceptor_INCLUDED
@@ -0,0 +1,123 @@
+//
+// ParallelSocketReactor.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/ParallelSocketReactor.h#1 $
+//
+// Library: Net
+// Package: Reactor
+// Module:  ParallelSocketReactor
+//
+// Definition of the ParallelSocketReactor class template.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_ParallelSocketReactor_INCLUDED
+#define Net_ParallelSocketReactor_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Thread.h"
+#include "Poco/Timespan.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/ErrorHandler.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+template <class SR = SocketReactor>
+class ParallelSocketReactor: public SR
+	/// A SocketReactor (or subclass of SocketReactor, given as
+	/// template argument) that runs in its own thread.
+	///
+	/// The reactor thread is started when the ParallelSocketReactor
+	/// is created, and stopped and joined when it is destroyed.
+	///
+	/// ParallelSocketReactor is used by ParallelSocketAcceptor
+	/// to distribute connections over multiple reactor threads.
+{
+public:
+	typedef Poco::SharedPtr<ParallelSocketReactor> Ptr;
+
+	ParallelSocketReactor()
+		/// Creates the ParallelSocketReactor and starts its thread.
+	{
+		_thread.start(*this);
+	}
+
+	explicit ParallelSocketReactor(const Poco::Timespan& timeout):
+		SR(timeout)
+		/// Creates the ParallelSocketReactor, using the given timeout,
+		/// and starts its thread.
+	{
+		_thread.start(*this);
+	}
+
+	~ParallelSocketReactor()
+		/// Stops the reactor and waits for its thread to terminate.
+	{
+		try
+		{
+			this->stop();
+			_thread.join();
+		}
+		catch (...)
+		{
+			Poco::ErrorHandler::handle();
+		}
+	}
+
+protected:
+	void onIdle()
+		/// Dispatches the IdleNotification and sleeps for a short
+		/// time, so that a reactor without sockets does not keep
+		/// a processor busy.
+	{
+		SR::onIdle();
+		Poco::Thread::sleep(IDLE_SLEEP);
+	}
+
+private:
+	enum
+	{
+		IDLE_SLEEP = 10 // milliseconds
+	};
+
+	ParallelSocketReactor(const ParallelSocketReactor&);
+	ParallelSocketReactor& operator = (const ParallelSocketReactor&);
+
+	Poco::Thread _thread;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_ParallelSocketReactor_INCLUDED
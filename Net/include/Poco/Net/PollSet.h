@@ -0,0 +1,140 @@
+//
+// PollSet.h
+//
+// $Id: //poco/1.4/Net/include/Poco/Net/PollSet.h#1 $
+//
+// Library: Net
+// Package: Sockets
+// Module:  PollSet
+//
+// Definition of the PollSet class.
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#ifndef Net_PollSet_INCLUDED
+#define Net_PollSet_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/Socket.h"
+#include <map>
+
+
+namespace Poco {
+namespace Net {
+
+
+class PollSetImpl;
+
+
+class Net_API PollSet
+	/// A set of sockets that can be efficiently polled as a whole.
+	///
+	/// In contrast to Socket::select(), which has to be given the
+	/// complete list of sockets (and, if epoll is used, sets up
+	/// a new epoll instance) for every call, a PollSet keeps the
+	/// interest set between calls to poll(). Sockets are only
+	/// registered, modified or unregistered when add(), update()
+	/// or remove() is called, and poll() only returns the sockets
+	/// that are actually ready.
+	///
+	/// If the platform supports it (POCO_HAVE_FD_EPOLL), PollSet
+	/// is implemented on top of a single, long-lived epoll instance.
+	/// Otherwise, PollSet falls back to Socket::select().
+	///
+	/// It is safe to call add(), update() and remove() from another
+	/// thread while a call to poll() is in progress.
+{
+public:
+	enum Mode
+	{
+		POLL_READ  = Socket::SELECT_READ,
+		POLL_WRITE = Socket::SELECT_WRITE,
+		POLL_ERROR = Socket::SELECT_ERROR
+	};
+
+	typedef std::map<Socket, int> SocketModeMap;
+
+	PollSet();
+		/// Creates an empty PollSet.
+
+	~PollSet();
+		/// Destroys the PollSet.
+
+	void add(const Socket& socket, int mode);
+		/// Adds the given socket to the set, for polling with
+		/// the given mode, which can be an OR'd combination of
+		/// POLL_READ, POLL_WRITE and POLL_ERROR.
+		///
+		/// If the socket is already in the set, its mode is updated.
+
+	void remove(const Socket& socket);
+		/// Removes the given socket from the set.
+		///
+		/// Does nothing if the socket is not in the set.
+
+	void update(const Socket& socket, int mode);
+		/// Updates the mode of the given socket, which must
+		/// already be in the set.
+
+	bool has(const Socket& socket) const;
+		/// Returns true if the given socket is in the set.
+
+	bool empty() const;
+		/// Returns true if the set is empty.
+
+	std::size_t count() const;
+		/// Returns the number of sockets in the set.
+
+	void clear();
+		/// Removes all sockets from the set.
+
+	SocketModeMap poll(const Poco::Timespan& timeout);
+		/// Waits until the state of at least one of the sockets
+		/// in the set changes accordingly to its mode, or the
+		/// timeout expires.
+		///
+		/// Returns a map of all sockets that are ready,
+		/// together with the ready modes (OR'd combination
+		/// of POLL_READ, POLL_WRITE and POLL_ERROR).
+		///
+		/// An empty map is returned if the timeout expires,
+		/// or immediately if the set is empty.
+
+private:
+	PollSet(const PollSet&);
+	PollSet& operator = (const PollSet&);
+
+	PollSetImpl* _pImpl;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_PollSet_INCLUDED
@@ -246,6 +246,11 @@
 #endif
 
 
+#if defined(POCO_OS_FAMILY_UNIX) && (POCO_OS != POCO_OS_VXWORKS)
+#define POCO_HAVE_FD_POLL 1
+#endif
+
+
 #if defined(POCO_HAVE_ADDRINFO)
 #if !defined(AI_ADDRCONFIG)
 #define AI_ADDRCONFIG 0
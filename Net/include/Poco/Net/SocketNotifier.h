@@ -45,6 +45,8 @@
 #include "Poco/RefCountedObject.h"
 #include "Poco/NotificationCenter.h"
 #include "Poco/Observer.h"
+#include "Poco/TimingWheel.h"
+#include "Poco/Timespan.h"
 #include <set>
 
 
@@ -57,9 +59,13 @@ class SocketReactor;
 class SocketNotification;
 
 
-class Net_API SocketNotifier: public Poco::RefCountedObject
+class Net_API SocketNotifier: public Poco::RefCountedObject, public Poco::TimingWheel::Entry
 	/// This class is used internally by SocketReactor
 	/// to notify registered event handlers of socket events.
+	///
+	/// A SocketNotifier is also the entry SocketReactor
+	/// keeps in its TimingWheel for the idle timeout
+	/// of the socket.
 {
 public:
 	explicit SocketNotifier(const Socket& socket);
@@ -83,6 +89,12 @@ public:
 	std::size_t countObservers() const;
 		/// Returns the number of subscribers;
 
+	void setIdleTimeout(const Poco::Timespan& timeout);
+		/// Sets the idle timeout of the socket.
+
+	const Poco::Timespan& getIdleTimeout() const;
+		/// Returns the idle timeout of the socket.
+
 protected:
 	~SocketNotifier();
 		/// Destroys the SocketNotifier.
@@ -93,6 +105,7 @@ private:
 	EventSet                 _events;
 	Poco::NotificationCenter _nc;
 	Socket                   _socket;
+	Poco::Timespan           _idleTimeout;
 };
 
 
@@ -117,6 +130,18 @@ inline std::size_t SocketNotifier::countObservers() const
 }
 
 
+inline void SocketNotifier::setIdleTimeout(const Poco::Timespan& timeout)
+{
+	_idleTimeout = timeout;
+}
+
+
+inline const Poco::Timespan& SocketNotifier::getIdleTimeout() const
+{
+	return _idleTimeout;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -42,8 +42,10 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/Socket.h"
+#include "Poco/Net/PollSet.h"
 #include "Poco/Runnable.h"
 #include "Poco/Timespan.h"
+#include "Poco/TimingWheel.h"
 #include "Poco/Observer.h"
 #include "Poco/AutoPtr.h"
 #include <map>
@@ -86,7 +88,11 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// as argument.
 	///
 	/// Once started, the SocketReactor waits for events
-	/// on the registered sockets, using Socket::select().
+	/// on the registered sockets, using a PollSet.
+	/// The PollSet is only updated when event handlers are
+	/// added or removed, so the cost of waiting for events
+	/// does not grow with the number of idle sockets
+	/// (if the PollSet is backed by epoll).
 	/// If an event is detected, the corresponding event handler
 	/// is invoked. There are five event types (and corresponding
 	/// notification classes) defined: ReadableNotification, WritableNotification,
@@ -104,8 +110,16 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// which can be overridden by subclasses to perform custom
 	/// timeout processing.
 	///
-	/// If there are no sockets for the SocketReactor to pass to
-	/// Socket::select(), an IdleNotification will be dispatched to
+	/// Additionally, an idle timeout can be set for individual sockets
+	/// with setIdleTimeout(). If no event has been dispatched for such
+	/// a socket within its idle timeout, a TimeoutNotification is
+	/// dispatched to the event handlers registered for this socket only.
+	/// Idle timeouts are kept in a Poco::TimingWheel, so that setting
+	/// and resetting them takes constant time, even with a large
+	/// number of connections.
+	///
+	/// If there are no sockets for the SocketReactor to wait
+	/// for, an IdleNotification will be dispatched to
 	/// all event handlers registered for it. This is done in the
 	/// onIdle() method which can be overridden by subclasses
 	/// to perform custom idle processing. Since onIdle() will be
@@ -156,12 +170,25 @@ public:
 		///
 		/// The default timeout is 250 milliseconds;
 		///
-		/// The timeout is passed to the Socket::select()
+		/// The timeout is passed to the PollSet::poll()
 		/// method.
 		
 	const Poco::Timespan& getTimeout() const;
 		/// Returns the timeout.
 
+	void setIdleTimeout(const Socket& socket, const Poco::Timespan& timeout);
+		/// Sets the idle timeout for the given socket.
+		///
+		/// If no event is dispatched for the socket within the
+		/// given timeout, a TimeoutNotification is dispatched to the
+		/// event handlers registered for the socket. The idle timeout
+		/// then starts again. A timeout of zero disables the idle
+		/// timeout, which is the default.
+		///
+		/// At least one event handler must have been registered for the
+		/// socket, otherwise the call has no effect. The idle timeout
+		/// is discarded together with the last event handler.
+
 	void addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer);
 		/// Registers an event handler with the SocketReactor.
 		///
@@ -218,6 +245,20 @@ private:
 	typedef std::map<Socket, NotifierPtr>     EventHandlerMap;
 
 	void dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification);
+	bool nextIdleTimeout(Poco::Timespan& timeout);
+		/// Shortens timeout to the time until the next idle
+		/// timeout may expire. Returns true if timeout
+		/// has been shortened.
+
+	void dispatchIdleTimeouts();
+		/// Dispatches the TimeoutNotification to all sockets
+		/// whose idle timeout has expired, and restarts their
+		/// idle timeouts.
+
+	void updatePollSet(const Socket& socket, NotifierPtr& pNotifier);
+		/// Updates the interest set for the given socket according
+		/// to the notifications accepted by its SocketNotifier.
+		/// Must be called with _mutex locked.
 
 	enum
 	{
@@ -227,6 +268,8 @@ private:
 	bool            _stop;
 	Poco::Timespan  _timeout;
 	EventHandlerMap _handlers;
+	PollSet         _pollSet;
+	Poco::TimingWheel _idleWheel;
 	NotificationPtr _pReadableNotification;
 	NotificationPtr _pWritableNotification;
 	NotificationPtr _pErrorNotification;
@@ -127,6 +127,9 @@ public:
 		///
 		/// Certain socket implementations may also return a negative
 		/// value denoting a certain condition.
+		///
+		/// If the socket is in non-blocking mode and no data
+		/// can be sent without blocking, -1 is returned.
 
 	int receiveBytes(void* buffer, int length, int flags = 0);
 		/// Receives data from the socket and stores it
@@ -136,6 +139,9 @@ public:
 		/// A return value of 0 means a graceful shutdown 
 		/// of the connection from the peer.
 		///
+		/// If the socket is in non-blocking mode and no data
+		/// is available, -1 is returned.
+		///
 		/// Throws a TimeoutException if a receive timeout has
 		/// been set and nothing is received within that interval.
 		/// Throws a NetException (or a subclass) in case of other errors.
@@ -0,0 +1,294 @@
+//
+// BufferedSocketHandler.cpp
+//
+// $Id: //poco/1.4/Net/src/BufferedSocketHandler.cpp#1 $
+//
+// Library: Net
+// Package: Reactor
+// Module:  BufferedSocketHandler
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/BufferedSocketHandler.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Observer.h"
+#include "Poco/ErrorHandler.h"
+
+
+using Poco::Observer;
+using Poco::FIFOBuffer;
+
+
+namespace Poco {
+namespace Net {
+
+
+BufferedSocketHandler::BufferedSocketHandler(const StreamSocket& socket, SocketReactor& reactor, std::size_t bufferSize):
+	_socket(socket),
+	_reactor(reactor),
+	_input(bufferSize),
+	_output(bufferSize),
+	_maxInputSize(DEFAULT_MAX_INPUT_SIZE),
+	_started(false),
+	_readable(false),
+	_writable(false),
+	_closing(false),
+	_failed(false)
+{
+	_socket.setBlocking(false);
+}
+
+
+BufferedSocketHandler::~BufferedSocketHandler()
+{
+	try
+	{
+		if (_started)
+		{
+			enableReadable(false);
+			enableWritable(false);
+			_reactor.removeEventHandler(_socket, Observer<BufferedSocketHandler, ErrorNotification>(*this, &BufferedSocketHandler::onSocketError));
+			_reactor.removeEventHandler(_socket, Observer<BufferedSocketHandler, ShutdownNotification>(*this, &BufferedSocketHandler::onReactorShutdown));
+		}
+		_socket.close();
+	}
+	catch (...)
+	{
+		Poco::ErrorHandler::handle();
+	}
+}
+
+
+void BufferedSocketHandler::start()
+{
+	poco_assert (!_started);
+
+	_started = true;
+	_reactor.addEventHandler(_socket, Observer<BufferedSocketHandler, ErrorNotification>(*this, &BufferedSocketHandler::onSocketError));
+	_reactor.addEventHandler(_socket, Observer<BufferedSocketHandler, ShutdownNotification>(*this, &BufferedSocketHandler::onReactorShutdown));
+	enableReadable(true);
+	enableWritable(!_output.isEmpty());
+}
+
+
+void BufferedSocketHandler::send(const char* buffer, std::size_t length)
+{
+	if (_closing || _failed) return;
+
+	if (_output.isEmpty())
+	{
+		// Nothing queued, so try to send directly without
+		// copying the data to the output buffer first.
+		int n = _socket.sendBytes(buffer, (int) length);
+		if (n > 0)
+		{
+			buffer += n;
+			length -= n;
+		}
+	}
+	if (length > 0)
+	{
+		if (length > _output.available())
+		{
+			std::size_t newSize = _output.size();
+			while (newSize - _output.used() < length) newSize *= 2;
+			_output.resize(newSize);
+		}
+		_output.write(buffer, length);
+		if (_started) enableWritable(true);
+	}
+}
+
+
+void BufferedSocketHandler::send(const std::string& data)
+{
+	send(data.data(), data.size());
+}
+
+
+void BufferedSocketHandler::close()
+{
+	_closing = true;
+}
+
+
+void BufferedSocketHandler::onDrained()
+{
+}
+
+
+void BufferedSocketHandler::onPeerShutdown()
+{
+	close();
+}
+
+
+void BufferedSocketHandler::onError(const Poco::Exception& exc)
+{
+}
+
+
+void BufferedSocketHandler::onReadable(ReadableNotification* pNf)
+{
+	pNf->release();
+	try
+	{
+		receive();
+	}
+	catch (Poco::Exception& exc)
+	{
+		_failed = true;
+		onError(exc);
+	}
+	update();
+}
+
+
+void BufferedSocketHandler::onWritable(WritableNotification* pNf)
+{
+	pNf->release();
+	try
+	{
+		flush();
+		if (_output.isEmpty()) onDrained();
+	}
+	catch (Poco::Exception& exc)
+	{
+		_failed = true;
+		onError(exc);
+	}
+	update();
+}
+
+
+void BufferedSocketHandler::onSocketError(ErrorNotification* pNf)
+{
+	pNf->release();
+	int err = _socket.impl()->socketError();
+	if (err)
+	{
+		_failed = true;
+		onError(Poco::IOException("socket error", err));
+		update();
+	}
+}
+
+
+void BufferedSocketHandler::onReactorShutdown(ShutdownNotification* pNf)
+{
+	pNf->release();
+	delete this;
+}
+
+
+void BufferedSocketHandler::receive()
+{
+	while (!_closing && !_failed)
+	{
+		if (_input.available() == 0)
+		{
+			if (_input.size() >= _maxInputSize)
+				throw NetException("Input buffer limit exceeded");
+			std::size_t newSize = 2*_input.size();
+			_input.resize(newSize < _maxInputSize ? newSize : _maxInputSize);
+		}
+
+		int length = (int) _input.available();
+		int n = _socket.receiveBytes(_input.next(), length);
+		if (n > 0)
+		{
+			_input.advance(n);
+			onData(_input);
+			// A short read means there is nothing more to
+			// read for now, so save the extra system call.
+			if (n < length) break;
+		}
+		else if (n == 0)
+		{
+			enableReadable(false);
+			onPeerShutdown();
+			break;
+		}
+		else break;
+	}
+}
+
+
+void BufferedSocketHandler::flush()
+{
+	while (!_output.isEmpty())
+	{
+		int length = (int) _output.used();
+		int n = _socket.sendBytes(_output.begin(), length);
+		if (n > 0) _output.drain(n);
+		if (n < length) break;
+	}
+}
+
+
+void BufferedSocketHandler::update()
+{
+	if (_failed || (_closing && _output.isEmpty()))
+	{
+		delete this;
+	}
+	else
+	{
+		if (_closing) enableReadable(false);
+		enableWritable(!_output.isEmpty());
+	}
+}
+
+
+void BufferedSocketHandler::enableReadable(bool flag)
+{
+	if (flag != _readable)
+	{
+		if (flag)
+			_reactor.addEventHandler(_socket, Observer<BufferedSocketHandler, ReadableNotification>(*this, &BufferedSocketHandler::onReadable));
+		else
+			_reactor.removeEventHandler(_socket, Observer<BufferedSocketHandler, ReadableNotification>(*this, &BufferedSocketHandler::onReadable));
+		_readable = flag;
+	}
+}
+
+
+void BufferedSocketHandler::enableWritable(bool flag)
+{
+	if (flag != _writable)
+	{
+		if (flag)
+			_reactor.addEventHandler(_socket, Observer<BufferedSocketHandler, WritableNotification>(*this, &BufferedSocketHandler::onWritable));
+		else
+			_reactor.removeEventHandler(_socket, Observer<BufferedSocketHandler, WritableNotification>(*this, &BufferedSocketHandler::onWritable));
+		_writable = flag;
+	}
+}
+
+
+} } // namespace Poco::Net
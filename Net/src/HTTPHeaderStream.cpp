@@ -36,6 +36,7 @@
 
 #include "Poco/Net/HTTPHeaderStream.h"
 #include "Poco/Net/HTTPSession.h"
+#include <cstring>
 
 
 namespace Poco {
@@ -50,7 +51,9 @@ namespace Net {
 HTTPHeaderStreamBuf::HTTPHeaderStreamBuf(HTTPSession& session, openmode mode):
 	HTTPBasicStreamBuf(HTTPBufferAllocator::BUFFER_SIZE, mode),
 	_session(session),
-	_end(false)
+	_end(false),
+	_lineLength(0),
+	_lineCR(false)
 {
 }
 
@@ -62,22 +65,40 @@ HTTPHeaderStreamBuf::~HTTPHeaderStreamBuf()
 
 int HTTPHeaderStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 {
-	// read line-by-line; an empty line denotes the end of the headers.
-	static const int eof = std::char_traits<char>::eof();
-
+	// Take over as much of the session buffer as possible, so that
+	// MessageHeader::read() usually finds the complete header in our
+	// buffer and can parse it in place. An empty line denotes the end
+	// of the headers; anything after it is left in the session buffer.
 	if (_end) return 0;
 
 	int n = 0;
-	int ch = _session.get();
-	while (ch != eof && ch != '\n' && n < length - 1)
-	{
-		*buffer++ = (char) ch; ++n;
-		ch = _session.get();
-	}
-	if (ch != eof)
+	while (n < length && !_end)
 	{
-		*buffer++ = (char) ch; ++n;
-		if (n == 2) _end = true;
+		if (_session._pCurrent == _session._pEnd)
+		{
+			_session.refill();
+			if (_session._pCurrent == _session._pEnd) break;
+		}
+		const char* begin = _session._pCurrent;
+		std::size_t avail = _session._pEnd - begin;
+		if (avail > std::size_t(length - n)) avail = std::size_t(length - n);
+		const char* eol = static_cast<const char*>(std::memchr(begin, '\n', avail));
+		std::size_t count = eol ? eol - begin + 1 : avail;
+		if (eol)
+		{
+			std::size_t lineLength = _lineLength + (eol - begin);
+			_end = lineLength == 0 || (lineLength == 1 && (_lineCR || *begin == '\r'));
+			_lineLength = 0;
+			_lineCR = false;
+		}
+		else
+		{
+			if (_lineLength == 0 && count > 0) _lineCR = *begin == '\r';
+			_lineLength += count;
+		}
+		std::memcpy(buffer + n, begin, count);
+		_session._pCurrent += count;
+		n += static_cast<int>(count);
 	}
 	return n;
 }
@@ -124,7 +145,7 @@ HTTPHeaderStreamBuf* HTTPHeaderIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPHeaderInputStream::_pool(sizeof(HTTPHeaderInputStream));
+Poco::ShardedMemoryPool HTTPHeaderInputStream::_pool(sizeof(HTTPHeaderInputStream));
 
 
 HTTPHeaderInputStream::HTTPHeaderInputStream(HTTPSession& session):
@@ -156,7 +177,7 @@ void HTTPHeaderInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPHeaderOutputStream::_pool(sizeof(HTTPHeaderOutputStream));
+Poco::ShardedMemoryPool HTTPHeaderOutputStream::_pool(sizeof(HTTPHeaderOutputStream));
 
 
 HTTPHeaderOutputStream::HTTPHeaderOutputStream(HTTPSession& session):
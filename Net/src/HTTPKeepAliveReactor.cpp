@@ -0,0 +1,424 @@
+//
+// HTTPKeepAliveReactor.cpp
+//
+// $Id: //poco/1.4/Net/src/HTTPKeepAliveReactor.cpp#1 $
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPKeepAliveReactor
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/HTTPKeepAliveReactor.h"
+#include "Poco/Net/HTTPServerConnection.h"
+#include "Poco/Net/HTTPBufferAllocator.h"
+#include "Poco/Net/TCPServerDispatcher.h"
+#include "Poco/Net/TCPServerConnectionFactory.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Observer.h"
+#include "Poco/Buffer.h"
+#include "Poco/Exception.h"
+#include "Poco/ErrorHandler.h"
+#include <vector>
+
+
+using Poco::Observer;
+using Poco::FastMutex;
+
+
+namespace Poco {
+namespace Net {
+
+
+//
+// HTTPKeepAliveReactor::Reactor
+//
+
+
+class HTTPKeepAliveReactor::Reactor: public SocketReactor
+	/// The SocketReactor watching the parked connections,
+	/// which also takes care of expiring them.
+{
+public:
+	enum
+	{
+		IDLE_SLEEP = 10
+	};
+
+	Reactor(HTTPKeepAliveReactor& owner):
+		SocketReactor(Poco::Timespan(SWEEP_INTERVAL)),
+		_owner(owner)
+	{
+	}
+
+protected:
+	void onTimeout()
+	{
+		_owner.sweep();
+	}
+
+	void onIdle()
+	{
+		_owner.sweep();
+		Poco::Thread::sleep(IDLE_SLEEP);
+	}
+
+	void onBusy()
+	{
+		_owner.sweep();
+	}
+
+private:
+	HTTPKeepAliveReactor& _owner;
+};
+
+
+//
+// HTTPKeepAliveReactor::ParkedConnection
+//
+
+
+class HTTPKeepAliveReactor::ParkedConnection
+	/// A connection waiting for its next request.
+{
+public:
+	ParkedConnection(HTTPKeepAliveReactor& owner, const StreamSocket& socket, int maxKeepAliveRequests):
+		_owner(owner),
+		_socket(socket),
+		_maxKeepAliveRequests(maxKeepAliveRequests),
+		_buffer(HTTPBufferAllocator::BUFFER_SIZE),
+		_length(0)
+	{
+		_expires += owner._pParams->getKeepAliveTimeout().totalMicroseconds();
+	}
+
+	void onReadable(ReadableNotification* pNf)
+	{
+		pNf->release();
+		try
+		{
+			int n = _socket.receiveBytes(_buffer.begin() + _length, static_cast<int>(_buffer.size() - _length));
+			if (n > 0)
+			{
+				_length += n;
+				if (headerComplete() || _length == _buffer.size())
+					_owner.resume(this);
+			}
+			else if (n == 0)
+			{
+				_owner.discard(this);
+			}
+		}
+		catch (Poco::Exception&)
+		{
+			_owner.discard(this);
+		}
+	}
+
+	StreamSocket& socket()
+	{
+		return _socket;
+	}
+
+	int maxKeepAliveRequests() const
+	{
+		return _maxKeepAliveRequests;
+	}
+
+	const char* data() const
+	{
+		return _buffer.begin();
+	}
+
+	std::size_t length() const
+	{
+		return _length;
+	}
+
+	bool expired(const Poco::Timestamp& now) const
+	{
+		return now >= _expires;
+	}
+
+private:
+	bool headerComplete() const
+	{
+		// The header ends with an empty line. Like the HTTP message
+		// parser, accept lines terminated by a single LF as well.
+		const char* p = _buffer.begin();
+		for (std::size_t i = 1; i < _length; ++i)
+		{
+			if (p[i] == '\n' && (p[i - 1] == '\n' || (i > 1 && p[i - 1] == '\r' && p[i - 2] == '\n')))
+				return true;
+		}
+		return false;
+	}
+
+	HTTPKeepAliveReactor& _owner;
+	StreamSocket          _socket;
+	int                   _maxKeepAliveRequests;
+	Poco::Timestamp       _expires;
+	Poco::Buffer<char>    _buffer;
+	std::size_t           _length;
+};
+
+
+//
+// HTTPKeepAliveReactor::ConnectionFactory
+//
+
+
+class HTTPKeepAliveReactor::ConnectionFactory: public TCPServerConnectionFactory
+	/// Creates the HTTPServerConnection objects
+	/// for resumed connections.
+{
+public:
+	ConnectionFactory(HTTPKeepAliveReactor* pOwner):
+		_pOwner(pOwner, true)
+	{
+	}
+
+	TCPServerConnection* createConnection(const StreamSocket& socket)
+	{
+		return _pOwner->createConnection(socket);
+	}
+
+private:
+	HTTPKeepAliveReactor::Ptr _pOwner;
+};
+
+
+//
+// HTTPKeepAliveReactor
+//
+
+
+HTTPKeepAliveReactor::HTTPKeepAliveReactor(HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory, Poco::ThreadPool& threadPool):
+	_pParams(pParams),
+	_pFactory(pFactory),
+	_pReactor(0),
+	_thread("HTTPKeepAliveReactor"),
+	_pDispatcher(0),
+	_resumedConnections(0),
+	_started(false),
+	_stopped(false)
+{
+	poco_check_ptr (pFactory);
+
+	_pReactor = new Reactor(*this);
+	// The dispatcher's connection factory keeps this object alive
+	// until the cycle is broken by stop().
+	_pDispatcher = new TCPServerDispatcher(new ConnectionFactory(this), threadPool, _pParams);
+}
+
+
+HTTPKeepAliveReactor::~HTTPKeepAliveReactor()
+{
+	try
+	{
+		if (_pDispatcher) _pDispatcher->release();
+		delete _pReactor;
+	}
+	catch (...)
+	{
+		Poco::ErrorHandler::handle();
+	}
+}
+
+
+void HTTPKeepAliveReactor::park(const StreamSocket& socket, int maxKeepAliveRequests)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_stopped)
+	{
+		StreamSocket(socket).close();
+		return;
+	}
+
+	ParkedConnection* pConnection = new ParkedConnection(*this, socket, maxKeepAliveRequests);
+	try
+	{
+		pConnection->socket().setBlocking(false);
+		_parked.insert(pConnection);
+		_pReactor->addEventHandler(pConnection->socket(), Observer<ParkedConnection, ReadableNotification>(*pConnection, &ParkedConnection::onReadable));
+		if (!_started)
+		{
+			_thread.start(*_pReactor);
+			_started = true;
+		}
+	}
+	catch (...)
+	{
+		_parked.erase(pConnection);
+		_pReactor->removeEventHandler(pConnection->socket(), Observer<ParkedConnection, ReadableNotification>(*pConnection, &ParkedConnection::onReadable));
+		pConnection->socket().close();
+		delete pConnection;
+		throw;
+	}
+}
+
+
+void HTTPKeepAliveReactor::stop()
+{
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (_stopped) return;
+		_stopped = true;
+	}
+	if (_started)
+	{
+		_pReactor->stop();
+		_thread.join();
+	}
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (ParkedSet::iterator it = _parked.begin(); it != _parked.end(); ++it)
+	{
+		_pReactor->removeEventHandler((*it)->socket(), Observer<ParkedConnection, ReadableNotification>(**it, &ParkedConnection::onReadable));
+		(*it)->socket().close();
+		delete *it;
+	}
+	_parked.clear();
+	_resumed.clear();
+	_pDispatcher->stop();
+	_pDispatcher->release();
+	_pDispatcher = 0;
+}
+
+
+int HTTPKeepAliveReactor::parkedConnections() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return static_cast<int>(_parked.size());
+}
+
+
+int HTTPKeepAliveReactor::resumedConnections() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _resumedConnections;
+}
+
+
+void HTTPKeepAliveReactor::resume(ParkedConnection* pConnection)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_parked.erase(pConnection);
+	StreamSocket socket = pConnection->socket();
+	_pReactor->removeEventHandler(socket, Observer<ParkedConnection, ReadableNotification>(*pConnection, &ParkedConnection::onReadable));
+	try
+	{
+		socket.setBlocking(true);
+
+		ResumeData& rd = _resumed[socket.impl()];
+		rd.socket = socket;
+		rd.data.assign(pConnection->data(), pConnection->length());
+		rd.maxKeepAliveRequests = pConnection->maxKeepAliveRequests();
+
+		// All connections are enqueued by the reactor thread,
+		// so a change in the refused count must be ours.
+		int refused = _pDispatcher->refusedConnections();
+		_pDispatcher->enqueue(socket);
+		if (_pDispatcher->refusedConnections() == refused)
+		{
+			++_resumedConnections;
+		}
+		else
+		{
+			_resumed.erase(socket.impl());
+			socket.close();
+		}
+	}
+	catch (...)
+	{
+		_resumed.erase(socket.impl());
+		socket.close();
+		delete pConnection;
+		throw;
+	}
+	delete pConnection;
+}
+
+
+void HTTPKeepAliveReactor::discard(ParkedConnection* pConnection)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_parked.erase(pConnection);
+	_pReactor->removeEventHandler(pConnection->socket(), Observer<ParkedConnection, ReadableNotification>(*pConnection, &ParkedConnection::onReadable));
+	pConnection->socket().close();
+	delete pConnection;
+}
+
+
+void HTTPKeepAliveReactor::sweep()
+{
+	Poco::Timestamp now;
+	if (now - _lastSweep < SWEEP_INTERVAL) return;
+	_lastSweep = now;
+
+	std::vector<ParkedConnection*> expired;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		for (ParkedSet::iterator it = _parked.begin(); it != _parked.end(); ++it)
+		{
+			if ((*it)->expired(now)) expired.push_back(*it);
+		}
+	}
+	for (std::vector<ParkedConnection*>::iterator it = expired.begin(); it != expired.end(); ++it)
+	{
+		discard(*it);
+	}
+}
+
+
+TCPServerConnection* HTTPKeepAliveReactor::createConnection(const StreamSocket& socket)
+{
+	HTTPServerConnection* pConnection = new HTTPServerConnection(socket, _pParams, _pFactory, HTTPKeepAliveReactor::Ptr(this, true));
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	ResumeMap::iterator it = _resumed.find(socket.impl());
+	if (it != _resumed.end())
+	{
+		pConnection->resume(it->second.data.data(), it->second.data.size(), it->second.maxKeepAliveRequests);
+		_resumed.erase(it);
+	}
+	return pConnection;
+}
+
+
+} } // namespace Poco::Net
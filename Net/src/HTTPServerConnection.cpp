@@ -53,7 +53,21 @@ namespace Net {
 HTTPServerConnection::HTTPServerConnection(const StreamSocket& socket, HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory):
 	TCPServerConnection(socket),
 	_pParams(pParams),
-	_pFactory(pFactory)
+	_pFactory(pFactory),
+	_resumed(false),
+	_maxKeepAliveRequests(0)
+{
+	poco_check_ptr (pFactory);
+}
+
+
+HTTPServerConnection::HTTPServerConnection(const StreamSocket& socket, HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory, HTTPKeepAliveReactor::Ptr pKeepAliveReactor):
+	TCPServerConnection(socket),
+	_pParams(pParams),
+	_pFactory(pFactory),
+	_pKeepAliveReactor(pKeepAliveReactor),
+	_resumed(false),
+	_maxKeepAliveRequests(0)
 {
 	poco_check_ptr (pFactory);
 }
@@ -68,6 +82,8 @@ void HTTPServerConnection::run()
 {
 	std::string server = _pParams->getSoftwareVersion();
 	HTTPServerSession session(socket(), _pParams);
+	if (_resumed)
+		session.resume(_resumeData.data(), _resumeData.size(), _maxKeepAliveRequests);
 	while (session.hasMoreRequests())
 	{
 		try
@@ -109,10 +125,25 @@ void HTTPServerConnection::run()
 		{
 			sendErrorResponse(session, HTTPResponse::HTTP_BAD_REQUEST);
 		}
+		if (_pKeepAliveReactor && session.idle())
+		{
+			// Nothing to do until the client sends its next request,
+			// so leave the waiting to the reactor and free the thread.
+			_pKeepAliveReactor->park(session.detachSocket(), session.maxKeepAliveRequests());
+			break;
+		}
 	}
 }
 
 
+void HTTPServerConnection::resume(const char* buffer, std::size_t length, int maxKeepAliveRequests)
+{
+	_resumed = true;
+	_resumeData.assign(buffer, length);
+	_maxKeepAliveRequests = maxKeepAliveRequests;
+}
+
+
 void HTTPServerConnection::sendErrorResponse(HTTPServerSession& session, HTTPResponse::HTTPStatus status)
 {
 	HTTPServerResponseImpl response(session);
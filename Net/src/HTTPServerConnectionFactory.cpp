@@ -37,6 +37,7 @@
 #include "Poco/Net/HTTPServerConnectionFactory.h"
 #include "Poco/Net/HTTPServerConnection.h"
 #include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/ErrorHandler.h"
 
 
 namespace Poco {
@@ -48,17 +49,45 @@ HTTPServerConnectionFactory::HTTPServerConnectionFactory(HTTPServerParams::Ptr p
 	_pFactory(pFactory)
 {
 	poco_check_ptr (pFactory);
+
+	if (_pParams->getReactorMode())
+		_pKeepAliveReactor = new HTTPKeepAliveReactor(_pParams, _pFactory, Poco::ThreadPool::defaultPool());
+}
+
+
+HTTPServerConnectionFactory::HTTPServerConnectionFactory(HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory, Poco::ThreadPool& threadPool):
+	_pParams(pParams),
+	_pFactory(pFactory)
+{
+	poco_check_ptr (pFactory);
+
+	if (_pParams->getReactorMode())
+		_pKeepAliveReactor = new HTTPKeepAliveReactor(_pParams, _pFactory, threadPool);
 }
 
 
 HTTPServerConnectionFactory::~HTTPServerConnectionFactory()
 {
+	if (_pKeepAliveReactor)
+	{
+		try
+		{
+			_pKeepAliveReactor->stop();
+		}
+		catch (...)
+		{
+			Poco::ErrorHandler::handle();
+		}
+	}
 }
 
 
 TCPServerConnection* HTTPServerConnectionFactory::createConnection(const StreamSocket& socket)
 {
-	return new HTTPServerConnection(socket, _pParams, _pFactory);
+	if (_pKeepAliveReactor)
+		return new HTTPServerConnection(socket, _pParams, _pFactory, _pKeepAliveReactor);
+	else
+		return new HTTPServerConnection(socket, _pParams, _pFactory);
 }
 
 
@@ -45,7 +45,8 @@ HTTPServerParams::HTTPServerParams():
 	_timeout(60000000),
 	_keepAlive(true),
 	_maxKeepAliveRequests(0),
-	_keepAliveTimeout(15000000)
+	_keepAliveTimeout(15000000),
+	_reactorMode(false)
 {
 }
 
@@ -90,6 +91,12 @@ void HTTPServerParams::setMaxKeepAliveRequests(int maxKeepAliveRequests)
 	poco_assert (maxKeepAliveRequests >= 0);
 	_maxKeepAliveRequests = maxKeepAliveRequests;
 }
+
+
+void HTTPServerParams::setReactorMode(bool reactorMode)
+{
+	_reactorMode = reactorMode;
+}
 	
 
 } } // namespace Poco::Net
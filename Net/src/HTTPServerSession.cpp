@@ -77,6 +77,20 @@ bool HTTPServerSession::hasMoreRequests()
 }
 
 
+bool HTTPServerSession::idle()
+{
+	return getKeepAlive() && canKeepAlive() && buffered() == 0 && socket().available() == 0;
+}
+
+
+void HTTPServerSession::resume(const char* buffer, std::size_t length, int maxKeepAliveRequests)
+{
+	refill(buffer, length);
+	_firstRequest = false;
+	_maxKeepAliveRequests = maxKeepAliveRequests;
+}
+
+
 SocketAddress HTTPServerSession::clientAddress()
 {
 	return socket().peerAddress();
@@ -186,6 +186,20 @@ void HTTPSession::refill()
 }
 
 
+void HTTPSession::refill(const char* buffer, std::size_t length)
+{
+	poco_assert (_pCurrent == _pEnd && length <= HTTPBufferAllocator::BUFFER_SIZE);
+
+	if (!_pBuffer)
+	{
+		_pBuffer = HTTPBufferAllocator::allocate(HTTPBufferAllocator::BUFFER_SIZE);
+	}
+	std::memcpy(_pBuffer, buffer, length);
+	_pCurrent = _pBuffer;
+	_pEnd = _pBuffer + length;
+}
+
+
 bool HTTPSession::connected() const
 {
 	return _socket.impl()->initialized();
@@ -118,7 +118,7 @@ HTTPStreamBuf* HTTPIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPInputStream::_pool(sizeof(HTTPInputStream));
+Poco::ShardedMemoryPool HTTPInputStream::_pool(sizeof(HTTPInputStream));
 
 
 HTTPInputStream::HTTPInputStream(HTTPSession& session):
@@ -150,7 +150,7 @@ void HTTPInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPOutputStream::_pool(sizeof(HTTPOutputStream));
+Poco::ShardedMemoryPool HTTPOutputStream::_pool(sizeof(HTTPOutputStream));
 
 
 HTTPOutputStream::HTTPOutputStream(HTTPSession& session):
@@ -35,11 +35,37 @@
 
 
 #include "Poco/Net/MessageHeader.h"
+#include "Poco/Net/MessageHeaderParser.h"
 #include "Poco/Net/NetException.h"
 #include "Poco/String.h"
 #include "Poco/Ascii.h"
 
 
+namespace
+{
+	class StreamBufAccess: public std::streambuf
+		/// Provides access to the get area of a stream buffer,
+		/// so that data already buffered can be parsed in place.
+	{
+	public:
+		static const char* begin(std::streambuf& buf)
+		{
+			return (buf.*&StreamBufAccess::gptr)();
+		}
+
+		static const char* end(std::streambuf& buf)
+		{
+			return (buf.*&StreamBufAccess::egptr)();
+		}
+
+		static void advance(std::streambuf& buf, int n)
+		{
+			(buf.*&StreamBufAccess::gbump)(n);
+		}
+	};
+}
+
+
 namespace Poco {
 namespace Net {
 
@@ -83,6 +109,19 @@ void MessageHeader::read(std::istream& istr)
 	static const int eof = std::char_traits<char>::eof();
 	std::streambuf& buf = *istr.rdbuf();
 
+	const char* begin = StreamBufAccess::begin(buf);
+	const char* end   = StreamBufAccess::end(buf);
+	if (begin < end)
+	{
+		MessageHeaderParser parser;
+		if (parser.parse(begin, end - begin))
+		{
+			parser.copyTo(*this);
+			StreamBufAccess::advance(buf, static_cast<int>(parser.length()));
+			return;
+		}
+	}
+
 	std::string name;
 	std::string value;
 	name.reserve(32);
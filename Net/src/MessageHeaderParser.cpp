@@ -0,0 +1,220 @@
+//
+// MessageHeaderParser.cpp
+//
+// $Id: //poco/1.4/Net/src/MessageHeaderParser.cpp#1 $
+//
+// Library: Net
+// Package: Messages
+// Module:  MessageHeaderParser
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/MessageHeaderParser.h"
+#include "Poco/Net/MessageHeader.h"
+#include "Poco/Exception.h"
+#include "Poco/Ascii.h"
+#include <cstring>
+
+
+namespace Poco {
+namespace Net {
+
+
+MessageHeaderParser::MessageHeaderParser():
+	_pBuffer(0),
+	_length(0)
+{
+	_fields.reserve(16);
+}
+
+
+MessageHeaderParser::~MessageHeaderParser()
+{
+}
+
+
+bool MessageHeaderParser::parse(const char* buffer, std::size_t length)
+{
+	_pBuffer = buffer;
+	_length  = 0;
+	_fields.clear();
+
+	const char* p   = buffer;
+	const char* end = buffer + length;
+	while (p < end && *p != '\r' && *p != '\n')
+	{
+		const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+		if (!eol) return false;
+		const char* colon = static_cast<const char*>(std::memchr(p, ':', eol - p));
+		if (!colon)
+		{
+			// ignore invalid header lines
+			if (eol - p >= MessageHeader::MAX_NAME_LENGTH) return false;
+			p = eol + 1;
+			continue;
+		}
+		if (colon - p > MessageHeader::MAX_NAME_LENGTH) return false;
+
+		const char* v = colon + 1;
+		while (v < eol && *v != '\r' && Poco::Ascii::isSpace(*v)) ++v;
+		const char* ve = eol;
+		if (ve > v && ve[-1] == '\r') --ve;
+		if (std::memchr(v, '\r', ve - v)) return false;
+		std::size_t valueLength = ve - v;
+		bool folded = false;
+		const char* next = eol + 1;
+		while (next < end && (*next == ' ' || *next == '\t'))
+		{
+			eol = static_cast<const char*>(std::memchr(next, '\n', end - next));
+			if (!eol) return false;
+			const char* cve = eol;
+			if (cve[-1] == '\r') --cve;
+			if (std::memchr(next, '\r', cve - next)) return false;
+			valueLength += cve - next;
+			ve = cve;
+			folded = true;
+			next = eol + 1;
+		}
+		if (valueLength > MessageHeader::MAX_VALUE_LENGTH) return false;
+		// CR and LF within folded values count as space, too
+		while (ve > v && Poco::Ascii::isSpace(ve[-1])) --ve;
+
+		Field field;
+		field.nameOffset  = p - buffer;
+		field.nameLength  = colon - p;
+		field.valueOffset = v - buffer;
+		field.valueLength = ve - v;
+		field.folded      = folded;
+		_fields.push_back(field);
+		p = next;
+	}
+	if (p == end) return false;
+
+	_length = p - buffer;
+	return true;
+}
+
+
+std::string MessageHeaderParser::name(std::size_t index) const
+{
+	poco_assert (index < _fields.size());
+
+	const Field& field = _fields[index];
+	return std::string(_pBuffer + field.nameOffset, field.nameLength);
+}
+
+
+std::string MessageHeaderParser::value(std::size_t index) const
+{
+	poco_assert (index < _fields.size());
+
+	std::string result;
+	assignValue(_fields[index], result);
+	return result;
+}
+
+
+bool MessageHeaderParser::has(const std::string& name) const
+{
+	return find(name) >= 0;
+}
+
+
+std::string MessageHeaderParser::get(const std::string& name) const
+{
+	int index = find(name);
+	if (index < 0) throw NotFoundException(name);
+	return value(index);
+}
+
+
+const std::string MessageHeaderParser::get(const std::string& name, const std::string& defaultValue) const
+{
+	int index = find(name);
+	if (index < 0) return defaultValue;
+	return value(index);
+}
+
+
+void MessageHeaderParser::copyTo(NameValueCollection& collection) const
+{
+	std::string name;
+	std::string value;
+	name.reserve(32);
+	value.reserve(64);
+	for (FieldVec::const_iterator it = _fields.begin(); it != _fields.end(); ++it)
+	{
+		name.assign(_pBuffer + it->nameOffset, it->nameLength);
+		assignValue(*it, value);
+		collection.add(name, value);
+	}
+}
+
+
+int MessageHeaderParser::find(const std::string& name) const
+{
+	for (std::size_t i = 0; i < _fields.size(); ++i)
+	{
+		const Field& field = _fields[i];
+		if (field.nameLength == name.size())
+		{
+			const char* p = _pBuffer + field.nameOffset;
+			std::string::const_iterator it = name.begin();
+			std::string::const_iterator end = name.end();
+			while (it != end && Poco::Ascii::toLower(*p) == Poco::Ascii::toLower(*it))
+			{
+				++p;
+				++it;
+			}
+			if (it == end) return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
+
+void MessageHeaderParser::assignValue(const Field& field, std::string& value) const
+{
+	const char* it  = _pBuffer + field.valueOffset;
+	const char* end = it + field.valueLength;
+	if (!field.folded)
+	{
+		value.assign(it, end);
+		return;
+	}
+
+	value.clear();
+	value.reserve(field.valueLength);
+	for (; it != end; ++it)
+	{
+		if (*it != '\r' && *it != '\n') value += *it;
+	}
+}
+
+
+} } // namespace Poco::Net
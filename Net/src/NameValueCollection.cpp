@@ -36,7 +36,9 @@
 
 #include "Poco/Net/NameValueCollection.h"
 #include "Poco/Exception.h"
+#include "Poco/Ascii.h"
 #include <algorithm>
+#include <limits>
 
 
 using Poco::NotFoundException;
@@ -46,6 +48,33 @@ namespace Poco {
 namespace Net {
 
 
+NameValueCollection::Entry::Entry(const std::string& name, const std::string& value, Poco::UInt64 key):
+	first(_name),
+	second(value),
+	_name(name),
+	_key(key)
+{
+}
+
+
+NameValueCollection::Entry::Entry(const Entry& entry):
+	first(_name),
+	second(entry.second),
+	_name(entry._name),
+	_key(entry._key)
+{
+}
+
+
+NameValueCollection::Entry& NameValueCollection::Entry::operator = (const Entry& entry)
+{
+	_name  = entry._name;
+	second = entry.second;
+	_key   = entry._key;
+	return *this;
+}
+
+
 NameValueCollection::NameValueCollection()
 {
 }
@@ -80,9 +109,9 @@ void NameValueCollection::swap(NameValueCollection& nvc)
 	
 const std::string& NameValueCollection::operator [] (const std::string& name) const
 {
-	ConstIterator it = _map.find(name);
-	if (it != _map.end())
-		return it->second;
+	std::size_t pos = findImpl(name, sortKey(name));
+	if (pos != _map.size())
+		return _map[pos].second;
 	else
 		throw NotFoundException(name);
 }
@@ -90,25 +119,26 @@ const std::string& NameValueCollection::operator [] (const std::string& name) co
 	
 void NameValueCollection::set(const std::string& name, const std::string& value)	
 {
-	Iterator it = _map.find(name);
-	if (it != _map.end())
-		it->second = value;
+	Poco::UInt64 key = sortKey(name);
+	std::size_t pos = findImpl(name, key);
+	if (pos != _map.size())
+		_map[pos].second = value;
 	else
-		_map.insert(HeaderMap::value_type(name, value));
+		insertImpl(name, value, key);
 }
 
 	
 void NameValueCollection::add(const std::string& name, const std::string& value)
 {
-	_map.insert(HeaderMap::value_type(name, value));
+	insertImpl(name, value, sortKey(name));
 }
 
 	
 const std::string& NameValueCollection::get(const std::string& name) const
 {
-	ConstIterator it = _map.find(name);
-	if (it != _map.end())
-		return it->second;
+	std::size_t pos = findImpl(name, sortKey(name));
+	if (pos != _map.size())
+		return _map[pos].second;
 	else
 		throw NotFoundException(name);
 }
@@ -116,9 +146,9 @@ const std::string& NameValueCollection::get(const std::string& name) const
 
 const std::string& NameValueCollection::get(const std::string& name, const std::string& defaultValue) const
 {
-	ConstIterator it = _map.find(name);
-	if (it != _map.end())
-		return it->second;
+	std::size_t pos = findImpl(name, sortKey(name));
+	if (pos != _map.size())
+		return _map[pos].second;
 	else
 		return defaultValue;
 }
@@ -126,13 +156,13 @@ const std::string& NameValueCollection::get(const std::string& name, const std::
 
 bool NameValueCollection::has(const std::string& name) const
 {
-	return _map.find(name) != _map.end();
+	return findImpl(name, sortKey(name)) != _map.size();
 }
 
 
 NameValueCollection::ConstIterator NameValueCollection::find(const std::string& name) const
 {
-	return _map.find(name);
+	return _map.begin() + findImpl(name, sortKey(name));
 }
 
 	
@@ -162,7 +192,11 @@ int NameValueCollection::size() const
 
 void NameValueCollection::erase(const std::string& name)
 {
-	_map.erase(name);
+	Poco::UInt64 key = sortKey(name);
+	std::size_t first = findImpl(name, key);
+	std::size_t last = first;
+	while (last != _map.size() && compare(_map[last], name, key) == 0) ++last;
+	_map.erase(_map.begin() + first, _map.begin() + last);
 }
 
 
@@ -172,4 +206,84 @@ void NameValueCollection::clear()
 }
 
 
+Poco::UInt64 NameValueCollection::sortKey(const std::string& name)
+{
+	// Poco::icompare() compares plain chars, so if char is signed,
+	// the sign bit must be flipped to keep the same order.
+	static const unsigned char SIGN = std::numeric_limits<char>::is_signed ? 0x80 : 0;
+
+	Poco::UInt64 key = 0;
+	std::string::const_iterator it = name.begin();
+	for (int i = 0; i < 8; ++i)
+	{
+		key <<= 8;
+		if (it != name.end())
+		{
+			key |= static_cast<unsigned char>(Poco::Ascii::toLower(*it)) ^ SIGN;
+			++it;
+		}
+	}
+	return key;
+}
+
+
+inline int NameValueCollection::compare(const Entry& entry, const std::string& name, Poco::UInt64 key)
+{
+	if (entry.key() < key)
+		return -1;
+	else if (entry.key() > key)
+		return 1;
+	else
+		return Poco::icompare(entry.first, name);
+}
+
+
+std::size_t NameValueCollection::lowerBound(const std::string& name, Poco::UInt64 key) const
+{
+	std::size_t first = 0;
+	std::size_t count = _map.size();
+	while (count > 0)
+	{
+		std::size_t step = count/2;
+		if (compare(_map[first + step], name, key) < 0)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else count = step;
+	}
+	return first;
+}
+
+
+std::size_t NameValueCollection::findImpl(const std::string& name, Poco::UInt64 key) const
+{
+	std::size_t pos = lowerBound(name, key);
+	if (pos != _map.size() && compare(_map[pos], name, key) == 0)
+		return pos;
+	else
+		return _map.size();
+}
+
+
+void NameValueCollection::insertImpl(const std::string& name, const std::string& value, Poco::UInt64 key)
+{
+	if (_map.empty()) _map.reserve(INITIAL_CAPACITY);
+
+	// Name-value pairs with the same name are kept in insertion order,
+	// so the new pair goes after all pairs not greater than it.
+	// Appending is by far the most common case, so check for it first.
+	if (_map.empty() || compare(_map.back(), name, key) <= 0)
+	{
+		_map.push_back(Entry(name, value, key));
+	}
+	else
+	{
+		std::size_t pos = lowerBound(name, key);
+		while (pos != _map.size() && compare(_map[pos], name, key) == 0) ++pos;
+		_map.insert(_map.begin() + pos, Entry(name, value, key));
+	}
+}
+
+
 } } // namespace Poco::Net
@@ -0,0 +1,391 @@
+//
+// PollSet.cpp
+//
+// $Id: //poco/1.4/Net/src/PollSet.cpp#1 $
+//
+// Library: Net
+// Package: Sockets
+// Module:  PollSet
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/SocketImpl.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Mutex.h"
+#include "Poco/Timestamp.h"
+#include <vector>
+#include <string.h>
+#if defined(POCO_HAVE_FD_EPOLL)
+#include <sys/epoll.h>
+#endif
+
+
+namespace Poco {
+namespace Net {
+
+
+class PollSetImpl
+	/// The platform-specific implementation of PollSet.
+{
+public:
+	struct SocketEntry
+	{
+		SocketEntry(const Socket& s, poco_socket_t f, int m):
+			socket(s),
+			fd(f),
+			mode(m)
+		{
+		}
+
+		Socket        socket;
+		poco_socket_t fd;
+		int           mode;
+	};
+
+	typedef std::map<SocketImpl*, SocketEntry> SocketMap;
+
+#if defined(POCO_HAVE_FD_EPOLL)
+
+	enum
+	{
+		MAX_EVENTS = 256
+	};
+
+	PollSetImpl():
+		_epollfd(-1)
+	{
+		_epollfd = epoll_create(1);
+		if (_epollfd < 0)
+		{
+			char buf[1024];
+			strerror_r(errno, buf, sizeof(buf));
+			SocketImpl::error(std::string("Can't create epoll queue: ") + buf);
+		}
+	}
+
+	~PollSetImpl()
+	{
+		::close(_epollfd);
+	}
+
+	void add(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketImpl* pImpl = socket.impl();
+		poco_socket_t fd = pImpl->sockfd();
+		if (fd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		ev.events   = eventsFor(mode);
+		ev.data.ptr = pImpl;
+
+		SocketMap::iterator it = _socketMap.find(pImpl);
+		int rc;
+		if (it == _socketMap.end())
+		{
+			rc = epoll_ctl(_epollfd, EPOLL_CTL_ADD, fd, &ev);
+			if (rc < 0 && errno == EEXIST)
+				rc = epoll_ctl(_epollfd, EPOLL_CTL_MOD, fd, &ev);
+		}
+		else
+		{
+			rc = epoll_ctl(_epollfd, EPOLL_CTL_MOD, fd, &ev);
+			// the descriptor may have been closed and reopened in the meantime
+			if (rc < 0 && errno == ENOENT)
+				rc = epoll_ctl(_epollfd, EPOLL_CTL_ADD, fd, &ev);
+		}
+		if (rc < 0)
+		{
+			char buf[1024];
+			strerror_r(errno, buf, sizeof(buf));
+			SocketImpl::error(std::string("Can't insert socket to epoll queue: ") + buf);
+		}
+
+		if (it == _socketMap.end())
+			_socketMap.insert(SocketMap::value_type(pImpl, SocketEntry(socket, fd, mode)));
+		else
+		{
+			it->second.fd   = fd;
+			it->second.mode = mode;
+		}
+	}
+
+	void remove(const Socket& socket)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketMap::iterator it = _socketMap.find(socket.impl());
+		if (it != _socketMap.end())
+		{
+			// If the socket has been closed in the meantime, the kernel
+			// has already removed the descriptor from the epoll set.
+			// The descriptor may even have been reused by another socket,
+			// so it must not be touched then.
+			if (it->first->sockfd() == it->second.fd)
+			{
+				struct epoll_event ev;
+				memset(&ev, 0, sizeof(ev));
+				epoll_ctl(_epollfd, EPOLL_CTL_DEL, it->second.fd, &ev);
+			}
+			_socketMap.erase(it);
+		}
+	}
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		PollSet::SocketModeMap result;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			if (_socketMap.empty()) return result;
+		}
+
+		struct epoll_event events[MAX_EVENTS];
+		Poco::Timespan remainingTime(timeout);
+		int rc;
+		do
+		{
+			Poco::Timestamp start;
+			rc = epoll_wait(_epollfd, events, MAX_EVENTS, remainingTime.totalMilliseconds());
+			if (rc < 0 && SocketImpl::lastError() == POCO_EINTR)
+			{
+				Poco::Timestamp end;
+				Poco::Timespan waited = end - start;
+				if (waited < remainingTime)
+					remainingTime -= waited;
+				else
+					remainingTime = 0;
+			}
+		}
+		while (rc < 0 && SocketImpl::lastError() == POCO_EINTR);
+		if (rc < 0) SocketImpl::error();
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		for (int i = 0; i < rc; ++i)
+		{
+			// The socket may have been removed while we were waiting.
+			SocketMap::iterator it = _socketMap.find(reinterpret_cast<SocketImpl*>(events[i].data.ptr));
+			if (it != _socketMap.end())
+			{
+				int mode = 0;
+				if (events[i].events & EPOLLIN)
+					mode |= PollSet::POLL_READ;
+				if (events[i].events & EPOLLOUT)
+					mode |= PollSet::POLL_WRITE;
+				if (events[i].events & EPOLLERR)
+					mode |= PollSet::POLL_ERROR;
+				if (events[i].events & EPOLLHUP)
+				{
+					// report a hangup the same way select() does, so that
+					// the next receive or send operation sees the condition
+					mode |= it->second.mode;
+				}
+				if (mode) result[it->second.socket] |= mode;
+			}
+		}
+		return result;
+	}
+
+#else
+
+	PollSetImpl()
+	{
+	}
+
+	~PollSetImpl()
+	{
+	}
+
+	void add(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketImpl* pImpl = socket.impl();
+		SocketMap::iterator it = _socketMap.find(pImpl);
+		if (it == _socketMap.end())
+			_socketMap.insert(SocketMap::value_type(pImpl, SocketEntry(socket, pImpl->sockfd(), mode)));
+		else
+			it->second.mode = mode;
+	}
+
+	void remove(const Socket& socket)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_socketMap.erase(socket.impl());
+	}
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		PollSet::SocketModeMap result;
+		Socket::SocketList readList;
+		Socket::SocketList writeList;
+		Socket::SocketList exceptList;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			if (_socketMap.empty()) return result;
+
+			for (SocketMap::iterator it = _socketMap.begin(); it != _socketMap.end(); ++it)
+			{
+				if (it->second.mode & PollSet::POLL_READ)
+					readList.push_back(it->second.socket);
+				if (it->second.mode & PollSet::POLL_WRITE)
+					writeList.push_back(it->second.socket);
+				if (it->second.mode & PollSet::POLL_ERROR)
+					exceptList.push_back(it->second.socket);
+			}
+		}
+		if (Socket::select(readList, writeList, exceptList, timeout))
+		{
+			for (Socket::SocketList::iterator it = readList.begin(); it != readList.end(); ++it)
+				result[*it] |= PollSet::POLL_READ;
+			for (Socket::SocketList::iterator it = writeList.begin(); it != writeList.end(); ++it)
+				result[*it] |= PollSet::POLL_WRITE;
+			for (Socket::SocketList::iterator it = exceptList.begin(); it != exceptList.end(); ++it)
+				result[*it] |= PollSet::POLL_ERROR;
+		}
+		return result;
+	}
+
+#endif // POCO_HAVE_FD_EPOLL
+
+	bool has(const Socket& socket) const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.find(socket.impl()) != _socketMap.end();
+	}
+
+	std::size_t count() const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.size();
+	}
+
+	void clear()
+	{
+		std::vector<Socket> sockets;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			sockets.reserve(_socketMap.size());
+			for (SocketMap::iterator it = _socketMap.begin(); it != _socketMap.end(); ++it)
+				sockets.push_back(it->second.socket);
+		}
+		for (std::vector<Socket>::iterator it = sockets.begin(); it != sockets.end(); ++it)
+			remove(*it);
+	}
+
+private:
+#if defined(POCO_HAVE_FD_EPOLL)
+	static unsigned eventsFor(int mode)
+	{
+		unsigned events = 0;
+		if (mode & PollSet::POLL_READ)
+			events |= EPOLLIN;
+		if (mode & PollSet::POLL_WRITE)
+			events |= EPOLLOUT;
+		if (mode & PollSet::POLL_ERROR)
+			events |= EPOLLERR;
+		return events;
+	}
+
+	int _epollfd;
+#endif
+
+	SocketMap _socketMap;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+PollSet::PollSet():
+	_pImpl(new PollSetImpl)
+{
+}
+
+
+PollSet::~PollSet()
+{
+	delete _pImpl;
+}
+
+
+void PollSet::add(const Socket& socket, int mode)
+{
+	_pImpl->add(socket, mode);
+}
+
+
+void PollSet::remove(const Socket& socket)
+{
+	_pImpl->remove(socket);
+}
+
+
+void PollSet::update(const Socket& socket, int mode)
+{
+	poco_assert_dbg (_pImpl->has(socket));
+
+	_pImpl->add(socket, mode);
+}
+
+
+bool PollSet::has(const Socket& socket) const
+{
+	return _pImpl->has(socket);
+}
+
+
+bool PollSet::empty() const
+{
+	return _pImpl->count() == 0;
+}
+
+
+std::size_t PollSet::count() const
+{
+	return _pImpl->count();
+}
+
+
+void PollSet::clear()
+{
+	_pImpl->clear();
+}
+
+
+PollSet::SocketModeMap PollSet::poll(const Poco::Timespan& timeout)
+{
+	return _pImpl->poll(timeout);
+}
+
+
+} } // namespace Poco::Net
@@ -40,8 +40,8 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/Timestamp.h"
 #include <string.h> // FD_SET needs memset on some platforms, so we can't use <cstring>
-#if defined(POCO_HAVE_FD_EPOLL)
-#include <sys/epoll.h>
+#if defined(POCO_HAVE_FD_POLL)
+#include <poll.h>
 #endif
 
 
@@ -294,7 +294,14 @@ int SocketImpl::sendBytes(const void* buffer, int length, int flags)
 		rc = ::send(_sockfd, reinterpret_cast<const char*>(buffer), length, flags);
 	}
 	while (rc < 0 && lastError() == POCO_EINTR);
-	if (rc < 0) error();
+	if (rc < 0)
+	{
+		int err = lastError();
+		if (!_blocking && (err == POCO_EAGAIN || err == POCO_EWOULDBLOCK))
+			return -1;
+		else
+			error(err);
+	}
 	return rc;
 }
 
@@ -319,7 +326,9 @@ int SocketImpl::receiveBytes(void* buffer, int length, int flags)
 	if (rc < 0) 
 	{
 		int err = lastError();
-		if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
+		if (!_blocking && (err == POCO_EAGAIN || err == POCO_EWOULDBLOCK))
+			return -1;
+		else if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
 			throw TimeoutException();
 		else
 			error(err);
@@ -410,43 +419,27 @@ bool SocketImpl::poll(const Poco::Timespan& timeout, int mode)
 	poco_socket_t sockfd = _sockfd;
 	if (sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
 
-#if defined(POCO_HAVE_FD_EPOLL)
-
-	int epollfd = epoll_create(1);
-	if (epollfd < 0)
-	{
-		char buf[1024];
-		strerror_r(errno, buf, sizeof(buf));
-		error(std::string("Can't create epoll queue: ") + buf);
-	}
-
-	struct epoll_event evin;
-	memset(&evin, 0, sizeof(evin));
+#if defined(POCO_HAVE_FD_POLL)
 
+	// A single descriptor is best served by poll(), which, unlike
+	// select(), is not limited to FD_SETSIZE and, unlike epoll,
+	// needs no additional kernel object per call.
+	struct pollfd pfd;
+	memset(&pfd, 0, sizeof(pfd));
+	pfd.fd = sockfd;
 	if (mode & SELECT_READ)
-		evin.events |= EPOLLIN;
+		pfd.events |= POLLIN;
 	if (mode & SELECT_WRITE)
-		evin.events |= EPOLLOUT;
+		pfd.events |= POLLOUT;
 	if (mode & SELECT_ERROR)
-		evin.events |= EPOLLERR;
-
-	if (epoll_ctl(epollfd, EPOLL_CTL_ADD, sockfd, &evin) < 0)
-	{
-		char buf[1024];
-		strerror_r(errno, buf, sizeof(buf));
-		::close(epollfd);
-		error(std::string("Can't insert socket to epoll queue: ") + buf);
-	}
+		pfd.events |= POLLPRI;
 
 	Poco::Timespan remainingTime(timeout);
 	int rc;
 	do
 	{
-		struct epoll_event evout;
-		memset(&evout, 0, sizeof(evout));
-
 		Poco::Timestamp start;
-		rc = epoll_wait(epollfd, &evout, 1, remainingTime.totalMilliseconds());
+		rc = ::poll(&pfd, 1, remainingTime.totalMilliseconds());
 		if (rc < 0 && lastError() == POCO_EINTR)
 		{
 			Poco::Timestamp end;
@@ -458,8 +451,6 @@ bool SocketImpl::poll(const Poco::Timespan& timeout, int mode)
 		}
 	}
 	while (rc < 0 && lastError() == POCO_EINTR);
-
-	::close(epollfd);
 	if (rc < 0) error();
 	return rc > 0; 
 
@@ -506,7 +497,7 @@ bool SocketImpl::poll(const Poco::Timespan& timeout, int mode)
 	if (rc < 0) error();
 	return rc > 0; 
 
-#endif // POCO_HAVE_FD_EPOLL
+#endif // POCO_HAVE_FD_POLL
 }
 
 	
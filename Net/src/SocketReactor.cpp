@@ -45,6 +45,8 @@
 using Poco::FastMutex;
 using Poco::Exception;
 using Poco::ErrorHandler;
+using Poco::TimingWheel;
+using Poco::Timestamp;
 
 
 namespace Poco {
@@ -79,60 +81,54 @@ SocketReactor::SocketReactor(const Poco::Timespan& timeout):
 
 SocketReactor::~SocketReactor()
 {
+	FastMutex::ScopedLock lock(_mutex);
+
+	_idleWheel.clear();
 }
 
 
 void SocketReactor::run()
 {
-	Socket::SocketList readable;
-	Socket::SocketList writable;
-	Socket::SocketList except;
-	
+	Timestamp lastEvent;
 	while (!_stop)
 	{
 		try
 		{
-			readable.clear();
-			writable.clear();
-			except.clear();
-			int nSockets = 0;
+			if (_pollSet.empty())
+			{
+				onIdle();
+				dispatchIdleTimeouts();
+			}
+			else
 			{
-				FastMutex::ScopedLock lock(_mutex);
-				for (EventHandlerMap::iterator it = _handlers.begin(); it != _handlers.end(); ++it)
+				Poco::Timespan timeout(_timeout);
+				bool shortened = nextIdleTimeout(timeout);
+				PollSet::SocketModeMap sm = _pollSet.poll(timeout);
+				if (!sm.empty())
 				{
-					if (it->second->accepts(_pReadableNotification))
-					{
-						readable.push_back(it->first);
-						nSockets++;
-					}
-					if (it->second->accepts(_pWritableNotification))
-					{
-						writable.push_back(it->first);
-						nSockets++;
-					}
-					if (it->second->accepts(_pErrorNotification))
+					onBusy();
+
+					for (PollSet::SocketModeMap::iterator it = sm.begin(); it != sm.end(); ++it)
 					{
-						except.push_back(it->first);
-						nSockets++;
+						if (it->second & PollSet::POLL_READ)
+							dispatch(it->first, _pReadableNotification);
+						if (it->second & PollSet::POLL_WRITE)
+							dispatch(it->first, _pWritableNotification);
+						if (it->second & PollSet::POLL_ERROR)
+							dispatch(it->first, _pErrorNotification);
 					}
+					lastEvent.update();
+				}
+				dispatchIdleTimeouts();
+				// The poll timeout may have been shortened for an idle
+				// timeout, so onTimeout() is only called once the full
+				// timeout has passed without any event.
+				if (sm.empty() && (!shortened || lastEvent.isElapsed(_timeout.totalMicroseconds())))
+				{
+					lastEvent.update();
+					onTimeout();
 				}
 			}
-			if (nSockets == 0)
-			{
-				onIdle();
-			}
-			else if (Socket::select(readable, writable, except, _timeout))
-			{
-				onBusy();
-
-				for (Socket::SocketList::iterator it = readable.begin(); it != readable.end(); ++it)
-					dispatch(*it, _pReadableNotification);
-				for (Socket::SocketList::iterator it = writable.begin(); it != writable.end(); ++it)
-					dispatch(*it, _pWritableNotification);
-				for (Socket::SocketList::iterator it = except.begin(); it != except.end(); ++it)
-					dispatch(*it, _pErrorNotification);
-			}
-			else onTimeout();
 		}
 		catch (Exception& exc)
 		{
@@ -169,47 +165,83 @@ const Poco::Timespan& SocketReactor::getTimeout() const
 }
 
 
+void SocketReactor::setIdleTimeout(const Socket& socket, const Poco::Timespan& timeout)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	EventHandlerMap::iterator it = _handlers.find(socket);
+	if (it != _handlers.end())
+	{
+		SocketNotifier& notifier = *it->second;
+		notifier.setIdleTimeout(timeout);
+		if (timeout > 0)
+			_idleWheel.schedule(notifier, Timestamp() + timeout.totalMicroseconds());
+		else
+			_idleWheel.cancel(notifier);
+	}
+}
+
+
 void SocketReactor::addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer)
 {
+	FastMutex::ScopedLock lock(_mutex);
+
 	NotifierPtr pNotifier;
+	EventHandlerMap::iterator it = _handlers.find(socket);
+	if (it == _handlers.end())
 	{
-		FastMutex::ScopedLock lock(_mutex);
-		
-		EventHandlerMap::iterator it = _handlers.find(socket);
-		if (it == _handlers.end())
-		{
-			pNotifier = new SocketNotifier(socket);
-			_handlers[socket] = pNotifier;
-		}
-		else pNotifier = it->second;
+		pNotifier = new SocketNotifier(socket);
+		_handlers[socket] = pNotifier;
 	}
+	else pNotifier = it->second;
+
 	pNotifier->addObserver(this, observer);
+	updatePollSet(socket, pNotifier);
 }
 
 
 void SocketReactor::removeEventHandler(const Socket& socket, const Poco::AbstractObserver& observer)
 {
-	NotifierPtr pNotifier;
+	FastMutex::ScopedLock lock(_mutex);
+
+	EventHandlerMap::iterator it = _handlers.find(socket);
+	if (it != _handlers.end())
 	{
-		FastMutex::ScopedLock lock(_mutex);
-		
-		EventHandlerMap::iterator it = _handlers.find(socket);
-		if (it != _handlers.end())
+		NotifierPtr pNotifier = it->second;
+		pNotifier->removeObserver(this, observer);
+		if (pNotifier->hasObservers())
 		{
-			pNotifier = it->second;
-			if (pNotifier->countObservers() == 1)
-			{
-				_handlers.erase(it);
-			}
+			updatePollSet(socket, pNotifier);
+		}
+		else
+		{
+			_idleWheel.cancel(*pNotifier);
+			_handlers.erase(it);
+			_pollSet.remove(socket);
 		}
-	}
-	if (pNotifier)
-	{
-		pNotifier->removeObserver(this, observer);
 	}
 }
 
 
+void SocketReactor::updatePollSet(const Socket& socket, NotifierPtr& pNotifier)
+{
+	int mode = 0;
+	if (pNotifier->accepts(_pReadableNotification))
+		mode |= PollSet::POLL_READ;
+	if (pNotifier->accepts(_pWritableNotification))
+		mode |= PollSet::POLL_WRITE;
+	if (pNotifier->accepts(_pErrorNotification))
+		mode |= PollSet::POLL_ERROR;
+
+	// Sockets without a valid descriptor cannot be polled;
+	// Socket::select() used to silently skip them as well.
+	if (mode && socket.impl()->initialized())
+		_pollSet.add(socket, mode);
+	else
+		_pollSet.remove(socket);
+}
+
+
 void SocketReactor::onTimeout()
 {
 	dispatch(_pTimeoutNotification);
@@ -243,6 +275,8 @@ void SocketReactor::dispatch(const Socket& socket, SocketNotification* pNotifica
 			pNotifier = it->second;
 		else
 			return;
+		if (pNotifier->getIdleTimeout() > 0)
+			_idleWheel.schedule(*pNotifier, Timestamp() + pNotifier->getIdleTimeout().totalMicroseconds());
 	}
 	dispatch(pNotifier, pNotification);
 }
@@ -264,6 +298,55 @@ void SocketReactor::dispatch(SocketNotification* pNotification)
 }
 
 
+bool SocketReactor::nextIdleTimeout(Poco::Timespan& timeout)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	Timestamp next;
+	if (_idleWheel.nextExpiration(next))
+	{
+		// round up to full milliseconds, to avoid polling
+		// repeatedly with a timeout of zero
+		Timestamp now;
+		Timestamp::TimeDiff diff = next > now ? next - now : 0;
+		Poco::Timespan remaining(((diff + 999)/1000)*1000);
+		if (remaining < timeout)
+		{
+			timeout = remaining;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void SocketReactor::dispatchIdleTimeouts()
+{
+	std::vector<NotifierPtr> delegates;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (_idleWheel.empty()) return;
+
+		Timestamp now;
+		TimingWheel::EntryVec expired;
+		if (_idleWheel.advance(now, expired) == 0) return;
+
+		delegates.reserve(expired.size());
+		for (TimingWheel::EntryVec::iterator it = expired.begin(); it != expired.end(); ++it)
+		{
+			SocketNotifier* pNotifier = static_cast<SocketNotifier*>(*it);
+			delegates.push_back(NotifierPtr(pNotifier, true));
+			_idleWheel.schedule(*pNotifier, now + pNotifier->getIdleTimeout().totalMicroseconds());
+		}
+	}
+	for (std::vector<NotifierPtr>::iterator it = delegates.begin(); it != delegates.end(); ++it)
+	{
+		dispatch(*it, _pTimeoutNotification);
+	}
+}
+
+
 void SocketReactor::dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification)
 {
 	try
@@ -34,6 +34,13 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPServerSession.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPHeaderStream.h"
+#include "Poco/Net/HTTPFixedLengthStream.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
 #include "Poco/Net/NetException.h"
 #include <sstream>
 
@@ -42,6 +49,13 @@ using Poco::Net::HTTPRequest;
 using Poco::Net::HTTPMessage;
 using Poco::Net::MessageException;
 using Poco::Net::NameValueCollection;
+using Poco::Net::HTTPServerSession;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPHeaderInputStream;
+using Poco::Net::HTTPFixedLengthInputStream;
+using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
 
 
 HTTPRequestTest::HTTPRequestTest(const std::string& name): CppUnit::TestCase(name)
@@ -255,6 +269,55 @@ void HTTPRequestTest::tearDown()
 }
 
 
+void HTTPRequestTest::testReadFromSession()
+{
+	ServerSocket ss(SocketAddress("localhost", 0));
+	StreamSocket cs(SocketAddress("localhost", ss.address().port()));
+	StreamSocket sock = ss.acceptConnection();
+
+	std::string header(
+		"POST /test HTTP/1.1\r\n"
+		"Host: localhost\r\n"
+		"Content-Type: text/plain\r\n"
+		"Content-Length: 4\r\n"
+		"X-Folded: folded\r\n value\r\n"
+		"\r\n");
+	std::string rest("bodyGET /next HTTP/1.1\r\n\r\n");
+	std::string data(header + rest);
+	cs.sendBytes(data.data(), (int) data.size());
+
+	HTTPServerSession session(sock, new HTTPServerParams);
+	HTTPHeaderInputStream his(session);
+	assert (his.peek() == 'P');
+	// the complete header, but nothing following it, has been handed
+	// over to the stream, so that MessageHeader::read() can parse it in place
+	assert (his.rdbuf()->in_avail() == (std::streamsize) header.size());
+
+	HTTPRequest request;
+	request.read(his);
+	assert (request.getMethod() == HTTPRequest::HTTP_POST);
+	assert (request.getURI() == "/test");
+	assert (request.getHost() == "localhost");
+	assert (request.getContentType() == "text/plain");
+	assert (request.getContentLength() == 4);
+	assert (request.get("X-Folded") == "folded value");
+	assert (request.size() == 4);
+	assert (his.rdbuf()->in_avail() == 0);
+
+	HTTPFixedLengthInputStream fis(session, request.getContentLength());
+	std::string body;
+	fis >> body;
+	assert (body == "body");
+
+	HTTPHeaderInputStream his2(session);
+	HTTPRequest request2;
+	request2.read(his2);
+	assert (request2.getMethod() == HTTPRequest::HTTP_GET);
+	assert (request2.getURI() == "/next");
+	assert (request2.empty());
+}
+
+
 CppUnit::Test* HTTPRequestTest::suite()
 {
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPRequestTest");
@@ -270,6 +333,7 @@ CppUnit::Test* HTTPRequestTest::suite()
 	CppUnit_addTest(pSuite, HTTPRequestTest, testInvalid2);
 	CppUnit_addTest(pSuite, HTTPRequestTest, testInvalid3);
 	CppUnit_addTest(pSuite, HTTPRequestTest, testCookies);
+	CppUnit_addTest(pSuite, HTTPRequestTest, testReadFromSession);
 
 	return pSuite;
 }
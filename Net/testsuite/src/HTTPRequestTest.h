@@ -57,6 +57,7 @@ public:
 	void testInvalid2();
 	void testInvalid3();
 	void testCookies();
+	void testReadFromSession();
 	
 	void setUp();
 	void tearDown();
@@ -44,7 +44,10 @@
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Stopwatch.h"
 #include <sstream>
+#include <vector>
 
 
 using Poco::Net::HTTPServer;
@@ -60,6 +63,8 @@ using Poco::Net::HTTPServerResponse;
 using Poco::Net::HTTPMessage;
 using Poco::Net::ServerSocket;
 using Poco::StreamCopier;
+using Poco::SharedPtr;
+using Poco::Stopwatch;
 
 
 namespace
@@ -547,6 +552,100 @@ void HTTPServerTest::testBuffer()
 }
 
 
+void HTTPServerTest::testReactorMode()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setMaxKeepAliveRequests(4);
+	pParams->setReactorMode(true);
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+	
+	HTTPClientSession cs("localhost", svs.address().port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+	request.setContentType("text/plain");
+	request.setChunkedTransferEncoding(true);
+	std::string body(5000, 'x');
+	for (int i = 0; i < 3; ++i)
+	{
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assert (response.getChunkedTransferEncoding());
+		assert (response.getKeepAlive());
+		assert (rbody == body);
+	}
+
+	{
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assert (response.getChunkedTransferEncoding());
+		assert (!response.getKeepAlive());
+		assert (rbody == body);
+	}
+
+	{
+		cs.setKeepAlive(false);
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assert (response.getChunkedTransferEncoding());
+		assert (!response.getKeepAlive());
+		assert (rbody == body);
+	}
+}
+
+
+void HTTPServerTest::testReactorModeIdleConnections()
+{
+	// With only two connection threads, the idle persistent
+	// connections would block all other clients until their
+	// keep-alive timeout expires, unless they are parked.
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setKeepAliveTimeout(Poco::Timespan(10, 0));
+	pParams->setMaxThreads(2);
+	pParams->setReactorMode(true);
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	Stopwatch sw;
+	sw.start();
+	std::vector<SharedPtr<HTTPClientSession> > sessions;
+	for (int i = 0; i < 8; ++i)
+	{
+		SharedPtr<HTTPClientSession> pSession = new HTTPClientSession("localhost", svs.address().port());
+		pSession->setKeepAlive(true);
+		sessions.push_back(pSession);
+	}
+	for (int k = 0; k < 3; ++k)
+	{
+		for (std::vector<SharedPtr<HTTPClientSession> >::iterator it = sessions.begin(); it != sessions.end(); ++it)
+		{
+			std::string body(100, 'a' + k);
+			HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+			request.setContentLength((int) body.length());
+			request.setContentType("text/plain");
+			(*it)->sendRequest(request) << body;
+			HTTPResponse response;
+			std::string rbody;
+			(*it)->receiveResponse(response) >> rbody;
+			assert (response.getKeepAlive());
+			assert (rbody == body);
+		}
+	}
+	sw.stop();
+	assert (sw.elapsedSeconds() < 10);
+}
+
+
 void HTTPServerTest::setUp()
 {
 }
@@ -575,6 +674,8 @@ CppUnit::Test* HTTPServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPServerTest, testAuth);
 	CppUnit_addTest(pSuite, HTTPServerTest, testNotImpl);
 	CppUnit_addTest(pSuite, HTTPServerTest, testBuffer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testReactorMode);
+	CppUnit_addTest(pSuite, HTTPServerTest, testReactorModeIdleConnections);
 
 	return pSuite;
 }
@@ -60,6 +60,8 @@ public:
 	void testAuth();
 	void testNotImpl();
 	void testBuffer();
+	void testReactorMode();
+	void testReactorModeIdleConnections();
 
 	void setUp();
 	void tearDown();
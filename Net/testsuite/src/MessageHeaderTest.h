@@ -59,6 +59,9 @@ public:
 	void testReadFolding5();
 	void testReadInvalid1();
 	void testReadInvalid2();
+	void testReadInPlace();
+	void testParser();
+	void testReadPerformance();
 	void testSplitElements();
 	void testSplitParameters();
 
@@ -35,10 +35,14 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Net/NameValueCollection.h"
 #include "Poco/Exception.h"
+#include "Poco/Stopwatch.h"
+#include <map>
+#include <iostream>
 
 
 using Poco::Net::NameValueCollection;
 using Poco::NotFoundException;
+using Poco::Stopwatch;
 
 
 NameValueCollectionTest::NameValueCollectionTest(const std::string& name): CppUnit::TestCase(name)
@@ -128,6 +132,128 @@ void NameValueCollectionTest::testNameValueCollection()
 }
 
 
+void NameValueCollectionTest::testOrder()
+{
+	NameValueCollection nvc;
+	nvc.add("Host", "localhost");
+	nvc.add("Cookie", "a=1");
+	nvc.add("accept", "text/html");
+	nvc.add("cookie", "b=2");
+	nvc.add("Zulu", "z");
+	nvc.add("COOKIE", "c=3");
+
+	// sorted by name, same names in insertion order
+	NameValueCollection::ConstIterator it = nvc.begin();
+	assert (it->first == "accept");
+	++it;
+	assert (it->first == "Cookie" && it->second == "a=1");
+	++it;
+	assert (it->first == "cookie" && it->second == "b=2");
+	++it;
+	assert (it->first == "COOKIE" && it->second == "c=3");
+	++it;
+	assert (it->first == "Host");
+	++it;
+	assert (it->first == "Zulu");
+	++it;
+	assert (it == nvc.end());
+
+	it = nvc.find("cookie");
+	assert (it->second == "a=1");
+	assert (nvc.get("COOKIE") == "a=1");
+
+	nvc.set("Cookie", "d=4");
+	assert (nvc.size() == 6);
+	assert (nvc.get("cookie") == "d=4");
+
+	nvc.erase("cookie");
+	assert (nvc.size() == 3);
+	assert (!nvc.has("Cookie"));
+	assert (nvc.has("zulu"));
+
+	NameValueCollection nvc2(nvc);
+	assert (nvc2.size() == 3);
+	assert (nvc2.get("HOST") == "localhost");
+	assert (NameValueCollection::sortKey("Content-Length") == NameValueCollection::sortKey("content-type"));
+	assert (NameValueCollection::sortKey("Accept") < NameValueCollection::sortKey("accept-encoding"));
+	assert (NameValueCollection::sortKey("HOST") < NameValueCollection::sortKey("if-modified-since"));
+
+	// names sharing the first eight characters
+	NameValueCollection nvc3;
+	nvc3.add("Content-Type", "text/plain");
+	nvc3.add("Content-Length", "100");
+	nvc3.add("content-", "x");
+	nvc3.add("Content-Location", "/");
+	it = nvc3.begin();
+	assert (it->first == "content-");
+	++it;
+	assert (it->first == "Content-Length");
+	++it;
+	assert (it->first == "Content-Location");
+	++it;
+	assert (it->first == "Content-Type");
+	assert (nvc3.get("CONTENT-LENGTH") == "100");
+	assert (nvc3.get("content-location") == "/");
+	assert (!nvc3.has("Content-Lengt"));
+	nvc3.erase("Content-Location");
+	assert (nvc3.size() == 3);
+	assert (nvc3.get("content-type") == "text/plain");
+
+	// copied entries keep their own names
+	NameValueCollection nvc4;
+	nvc4 = nvc3;
+	nvc3.clear();
+	it = nvc4.begin();
+	assert (it->first == "content-" && it->second == "x");
+	++it;
+	assert (it->first == "Content-Length" && it->second == "100");
+	++it;
+	assert (it->first == "Content-Type" && it->second == "text/plain");
+}
+
+
+void NameValueCollectionTest::testPerformance()
+{
+	static const char* names[] =
+	{
+		"Host", "User-Agent", "Accept", "Accept-Language", "Accept-Encoding",
+		"Connection", "Referer", "Cookie", "Cache-Control", "Content-Type",
+		"Content-Length", "If-Modified-Since"
+	};
+	const int NAMES = sizeof(names)/sizeof(names[0]);
+	const int ITERATIONS = 100000;
+	std::vector<std::string> keys(names, names + NAMES);
+	std::string value("value");
+
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < ITERATIONS; ++i)
+	{
+		std::multimap<std::string, std::string, NameValueCollection::ILT> map;
+		for (int k = 0; k < NAMES; ++k)
+			map.insert(std::make_pair(keys[k], value));
+		map.find("content-length");
+		map.find("connection");
+		map.find("transfer-encoding");
+	}
+	sw.stop();
+	std::cout << "std::multimap: " << sw.elapsed()/1000 << " ms" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < ITERATIONS; ++i)
+	{
+		NameValueCollection nvc;
+		for (int k = 0; k < NAMES; ++k)
+			nvc.add(keys[k], value);
+		nvc.find("content-length");
+		nvc.find("connection");
+		nvc.find("transfer-encoding");
+	}
+	sw.stop();
+	std::cout << "NameValueCollection: " << sw.elapsed()/1000 << " ms" << std::endl;
+}
+
+
 void NameValueCollectionTest::setUp()
 {
 }
@@ -143,6 +269,8 @@ CppUnit::Test* NameValueCollectionTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("NameValueCollectionTest");
 
 	CppUnit_addTest(pSuite, NameValueCollectionTest, testNameValueCollection);
+	CppUnit_addTest(pSuite, NameValueCollectionTest, testOrder);
+	//CppUnit_addTest(pSuite, NameValueCollectionTest, testPerformance);
 
 	return pSuite;
 }
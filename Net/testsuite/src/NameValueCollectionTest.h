@@ -47,6 +47,8 @@ public:
 	~NameValueCollectionTest();
 
 	void testNameValueCollection();
+	void testOrder();
+	void testPerformance();
 
 	void setUp();
 	void tearDown();
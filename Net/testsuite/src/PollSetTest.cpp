@@ -0,0 +1,197 @@
+//
+// PollSetTest.cpp
+//
+// $Id: //poco/1.4/Net/testsuite/src/PollSetTest.cpp#1 $
+//
+// Copyright (c) 2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+
+#include "PollSetTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "EchoServer.h"
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Timespan.h"
+#include "Poco/Stopwatch.h"
+
+
+using Poco::Net::Socket;
+using Poco::Net::StreamSocket;
+using Poco::Net::ServerSocket;
+using Poco::Net::SocketAddress;
+using Poco::Net::PollSet;
+using Poco::Timespan;
+using Poco::Stopwatch;
+
+
+PollSetTest::PollSetTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+PollSetTest::~PollSetTest()
+{
+}
+
+
+void PollSetTest::testAddUpdate()
+{
+	EchoServer echoServer;
+	StreamSocket ss1(SocketAddress("localhost", echoServer.port()));
+	StreamSocket ss2(SocketAddress("localhost", echoServer.port()));
+
+	PollSet ps;
+	assert (ps.empty());
+	assert (!ps.has(ss1));
+
+	ps.add(ss1, PollSet::POLL_READ);
+	ps.add(ss2, PollSet::POLL_READ);
+	assert (!ps.empty());
+	assert (ps.count() == 2);
+	assert (ps.has(ss1));
+	assert (ps.has(ss2));
+
+	ps.add(ss1, PollSet::POLL_READ | PollSet::POLL_WRITE);
+	assert (ps.count() == 2);
+
+	ps.remove(ss1);
+	assert (ps.count() == 1);
+	assert (!ps.has(ss1));
+	ps.remove(ss1);
+	assert (ps.count() == 1);
+
+	ps.clear();
+	assert (ps.empty());
+	assert (!ps.has(ss2));
+}
+
+
+void PollSetTest::testPoll()
+{
+	Timespan timeout(1000000);
+
+	EchoServer echoServer1;
+	EchoServer echoServer2;
+	StreamSocket ss1(SocketAddress("localhost", echoServer1.port()));
+	StreamSocket ss2(SocketAddress("localhost", echoServer2.port()));
+
+	PollSet ps;
+	ps.add(ss1, PollSet::POLL_READ);
+	ps.add(ss2, PollSet::POLL_READ);
+
+	// nothing readable
+	Stopwatch sw;
+	sw.start();
+	PollSet::SocketModeMap sm = ps.poll(Timespan(250000));
+	assert (sm.empty());
+	assert (sw.elapsed() >= 200000);
+
+	ss1.sendBytes("hello", 5);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.find(ss1) != sm.end());
+	assert (sm.find(ss2) == sm.end());
+	assert (sm.find(ss1)->second == PollSet::POLL_READ);
+
+	// level-triggered: still readable until the data has been read
+	sm = ps.poll(timeout);
+	assert (sm.find(ss1) != sm.end());
+
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "hello");
+
+	ps.update(ss2, PollSet::POLL_READ | PollSet::POLL_WRITE);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.find(ss2) != sm.end());
+	assert (sm.find(ss2)->second == PollSet::POLL_WRITE);
+
+	ps.remove(ss2);
+	ss2.sendBytes("HELLO", 5);
+	sm = ps.poll(Timespan(250000));
+	assert (sm.empty());
+
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "HELLO");
+
+	ss1.close();
+	ss2.close();
+	ps.clear();
+	assert (ps.poll(timeout).empty());
+}
+
+
+void PollSetTest::testPollClosedServer()
+{
+	ServerSocket server(SocketAddress("localhost", 0));
+	StreamSocket ss(SocketAddress("localhost", server.address().port()));
+	StreamSocket peer = server.acceptConnection();
+
+	PollSet ps;
+	ps.add(ss, PollSet::POLL_READ);
+	peer.close();
+
+	PollSet::SocketModeMap sm = ps.poll(Timespan(1000000));
+	assert (sm.size() == 1);
+	assert (sm.find(ss)->second & PollSet::POLL_READ);
+
+	char buffer[16];
+	assert (ss.receiveBytes(buffer, sizeof(buffer)) == 0);
+
+	// closing a socket that is still in the set must not confuse the set
+	ss.close();
+	ps.remove(ss);
+	assert (ps.empty());
+}
+
+
+void PollSetTest::setUp()
+{
+}
+
+
+void PollSetTest::tearDown()
+{
+}
+
+
+CppUnit::Test* PollSetTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PollSetTest");
+
+	CppUnit_addTest(pSuite, PollSetTest, testAddUpdate);
+	CppUnit_addTest(pSuite, PollSetTest, testPoll);
+	CppUnit_addTest(pSuite, PollSetTest, testPollClosedServer);
+
+	return pSuite;
+}
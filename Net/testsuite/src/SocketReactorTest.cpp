@@ -37,16 +37,29 @@
 #include "Poco/Net/SocketNotification.h"
 #include "Poco/Net/SocketConnector.h"
 #include "Poco/Net/SocketAcceptor.h"
+#include "Poco/Net/ParallelSocketAcceptor.h"
+#include "Poco/Net/BufferedSocketHandler.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/NetException.h"
 #include "Poco/Observer.h"
+#include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Mutex.h"
+#include "Poco/AtomicCounter.h"
 #include <sstream>
+#include <iostream>
+#include <vector>
+#include <set>
+#include <cstring>
 
 
 using Poco::Net::SocketReactor;
 using Poco::Net::SocketConnector;
 using Poco::Net::SocketAcceptor;
+using Poco::Net::ParallelSocketAcceptor;
+using Poco::Net::BufferedSocketHandler;
 using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
@@ -56,6 +69,12 @@ using Poco::Net::WritableNotification;
 using Poco::Net::TimeoutNotification;
 using Poco::Net::ShutdownNotification;
 using Poco::Observer;
+using Poco::Thread;
+using Poco::Stopwatch;
+using Poco::FastMutex;
+using Poco::FIFOBuffer;
+using Poco::Timespan;
+using Poco::AtomicCounter;
 
 
 namespace
@@ -96,6 +115,191 @@ namespace
 		SocketReactor& _reactor;
 	};
 	
+	class ParallelEchoServiceHandler: public EchoServiceHandler
+	{
+	public:
+		ParallelEchoServiceHandler(StreamSocket& socket, SocketReactor& reactor):
+			EchoServiceHandler(socket, reactor)
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			_reactors.insert(&reactor);
+		}
+		
+		static std::size_t reactorCount()
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			return _reactors.size();
+		}
+		
+		static void reset()
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			_reactors.clear();
+		}
+		
+	private:
+		static std::set<SocketReactor*> _reactors;
+		static FastMutex _mutex;
+	};
+	
+	
+	std::set<SocketReactor*> ParallelEchoServiceHandler::_reactors;
+	FastMutex ParallelEchoServiceHandler::_mutex;
+	
+	
+	class BufferedEchoServiceHandler: public BufferedSocketHandler
+	{
+	public:
+		BufferedEchoServiceHandler(StreamSocket& socket, SocketReactor& reactor):
+			BufferedSocketHandler(socket, reactor)
+		{
+			++_count;
+			start();
+		}
+		
+		~BufferedEchoServiceHandler()
+		{
+			--_count;
+		}
+		
+		static int count()
+		{
+			return _count;
+		}
+		
+	protected:
+		void onData(FIFOBuffer& input)
+		{
+			send(input.begin(), input.used());
+			input.drain(input.used());
+		}
+		
+	private:
+		static Poco::AtomicCounter _count;
+	};
+	
+	
+	Poco::AtomicCounter BufferedEchoServiceHandler::_count;
+	
+	
+	class UnterminatedServiceHandler: public BufferedSocketHandler
+		/// Waits for a message terminator that never comes.
+	{
+	public:
+		UnterminatedServiceHandler(StreamSocket& socket, SocketReactor& reactor):
+			BufferedSocketHandler(socket, reactor)
+		{
+			++_count;
+			setMaxInputSize(64*1024);
+			start();
+		}
+		
+		~UnterminatedServiceHandler()
+		{
+			--_count;
+		}
+		
+		static int count()
+		{
+			return _count;
+		}
+		
+		static int errors()
+		{
+			return _errors;
+		}
+		
+	protected:
+		void onData(FIFOBuffer& input)
+		{
+			if (std::memchr(input.begin(), '\n', input.used()))
+				input.drain(input.used());
+		}
+		
+		void onError(const Poco::Exception& exc)
+		{
+			if (dynamic_cast<const Poco::Net::NetException*>(&exc)) ++_errors;
+		}
+		
+	private:
+		static Poco::AtomicCounter _count;
+		static Poco::AtomicCounter _errors;
+	};
+	
+	
+	Poco::AtomicCounter UnterminatedServiceHandler::_count;
+	Poco::AtomicCounter UnterminatedServiceHandler::_errors;
+	
+	
+	class IdleServiceHandler
+	{
+	public:
+		IdleServiceHandler(StreamSocket& socket, SocketReactor& reactor):
+			_socket(socket),
+			_reactor(reactor),
+			_timeouts(0)
+		{
+			_reactor.addEventHandler(_socket, Observer<IdleServiceHandler, ReadableNotification>(*this, &IdleServiceHandler::onReadable));
+			_reactor.addEventHandler(_socket, Observer<IdleServiceHandler, TimeoutNotification>(*this, &IdleServiceHandler::onTimeout));
+		}
+		
+		~IdleServiceHandler()
+		{
+			_reactor.removeEventHandler(_socket, Observer<IdleServiceHandler, ReadableNotification>(*this, &IdleServiceHandler::onReadable));
+			_reactor.removeEventHandler(_socket, Observer<IdleServiceHandler, TimeoutNotification>(*this, &IdleServiceHandler::onTimeout));
+		}
+		
+		void onReadable(ReadableNotification* pNf)
+		{
+			pNf->release();
+			char buffer[64];
+			_socket.receiveBytes(buffer, sizeof(buffer));
+		}
+		
+		void onTimeout(TimeoutNotification* pNf)
+		{
+			pNf->release();
+			++_timeouts;
+		}
+		
+		int timeouts() const
+		{
+			return _timeouts.value();
+		}
+		
+	private:
+		StreamSocket   _socket;
+		SocketReactor& _reactor;
+		AtomicCounter  _timeouts;
+	};
+
+	void echoConnections(const SocketAddress& sa, int count)
+	{
+		std::vector<StreamSocket> sockets;
+		for (int i = 0; i < count; ++i)
+		{
+			sockets.push_back(StreamSocket(sa));
+		}
+		for (std::vector<StreamSocket>::iterator it = sockets.begin(); it != sockets.end(); ++it)
+		{
+			it->sendBytes("hello", 5);
+		}
+		for (std::vector<StreamSocket>::iterator it = sockets.begin(); it != sockets.end(); ++it)
+		{
+			char buffer[8];
+			int n = 0;
+			while (n < 5)
+			{
+				int rc = it->receiveBytes(buffer + n, sizeof(buffer) - n);
+				if (rc <= 0) break;
+				n += rc;
+			}
+			poco_assert (std::string(buffer, n) == "hello");
+			it->close();
+		}
+	}
+
+
 	class ClientServiceHandler
 	{
 	public:
@@ -277,9 +481,219 @@ void SocketReactorTest::testSocketConnectorTimeout()
 }
 
 
+void SocketReactorTest::testParallelSocketAcceptor()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketReactor reactor;
+	Poco::Thread thread;
+	{
+		ParallelSocketAcceptor<ParallelEchoServiceHandler> acceptor(ss, reactor, 4);
+		assert (acceptor.threads() == 4);
+		thread.start(reactor);
+
+		SocketAddress sa("localhost", ss.address().port());
+		echoConnections(sa, 8);
+		assert (ParallelEchoServiceHandler::reactorCount() == 4);
+		reactor.stop();
+		thread.join();
+	}
+}
+
+
+void SocketReactorTest::testParallelSocketAcceptorReusePort()
+{
+	ParallelSocketAcceptor<ParallelEchoServiceHandler> acceptor(SocketAddress("localhost", 0), 2);
+	assert (acceptor.threads() == 2);
+	assert (acceptor.address().port() != 0);
+
+	SocketAddress sa("localhost", acceptor.address().port());
+	echoConnections(sa, 16);
+	assert (ParallelEchoServiceHandler::reactorCount() >= 1);
+}
+
+
+void SocketReactorTest::testBufferedSocketHandler()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketReactor reactor;
+	SocketAcceptor<BufferedEchoServiceHandler> acceptor(ss, reactor);
+	Thread thread;
+	thread.start(reactor);
+
+	// The client does not read before it has sent everything,
+	// so the handler cannot send its echo without blocking
+	// and has to queue it in its output buffer.
+	const int SIZE = 4*1024*1024;
+	std::string data;
+	data.reserve(SIZE);
+	for (int i = 0; i < SIZE; ++i) data += char('a' + i % 26);
+
+	SocketAddress sa("localhost", ss.address().port());
+	StreamSocket sock(sa);
+	int sent = 0;
+	while (sent < SIZE)
+	{
+		int n = sock.sendBytes(data.data() + sent, SIZE - sent);
+		assert (n > 0);
+		sent += n;
+	}
+	sock.shutdownSend();
+
+	std::string echo;
+	char buffer[8192];
+	int n = sock.receiveBytes(buffer, sizeof(buffer));
+	while (n > 0)
+	{
+		echo.append(buffer, n);
+		n = sock.receiveBytes(buffer, sizeof(buffer));
+	}
+	assert (echo == data);
+	sock.close();
+	assert (BufferedEchoServiceHandler::count() == 0);
+
+	reactor.stop();
+	thread.join();
+}
+
+
+void SocketReactorTest::testBufferedSocketHandlerInputLimit()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketReactor reactor;
+	SocketAcceptor<UnterminatedServiceHandler> acceptor(ss, reactor);
+	Thread thread;
+	thread.start(reactor);
+
+	SocketAddress sa("localhost", ss.address().port());
+	StreamSocket sock(sa);
+	std::string data(1024*1024, 'x');
+	try
+	{
+		int sent = 0;
+		while (sent < (int) data.size())
+		{
+			int n = sock.sendBytes(data.data() + sent, (int) data.size() - sent);
+			if (n <= 0) break;
+			sent += n;
+		}
+		// the handler closes the connection once its
+		// input buffer limit has been exceeded
+		char buffer[256];
+		while (sock.receiveBytes(buffer, sizeof(buffer)) > 0);
+	}
+	catch (Poco::Exception&)
+	{
+	}
+	sock.close();
+	assert (UnterminatedServiceHandler::errors() == 1);
+	assert (UnterminatedServiceHandler::count() == 0);
+
+	reactor.stop();
+	thread.join();
+}
+
+
+void SocketReactorTest::testIdleTimeout()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketAddress sa("localhost", ss.address().port());
+	StreamSocket client1(sa);
+	StreamSocket server1 = ss.acceptConnection();
+	StreamSocket client2(sa);
+	StreamSocket server2 = ss.acceptConnection();
+
+	// the reactor timeout is much longer than the test
+	SocketReactor reactor(Timespan(30, 0));
+	IdleServiceHandler handler1(server1, reactor);
+	IdleServiceHandler handler2(server2, reactor);
+	reactor.setIdleTimeout(server1, Timespan(0, 200000));
+	Thread thread;
+	thread.start(reactor);
+
+	Thread::sleep(700);
+	assert (handler1.timeouts() >= 2);
+	assert (handler1.timeouts() <= 4);
+	assert (handler2.timeouts() == 0);
+
+	// events restart the idle timeout
+	int timeouts = handler1.timeouts();
+	for (int i = 0; i < 10; ++i)
+	{
+		client1.sendBytes("x", 1);
+		Thread::sleep(50);
+	}
+	assert (handler1.timeouts() == timeouts);
+
+	reactor.setIdleTimeout(server1, 0);
+	Thread::sleep(400);
+	assert (handler1.timeouts() == timeouts);
+	assert (handler2.timeouts() == 0);
+
+	reactor.stop();
+	client2.sendBytes("x", 1);
+	thread.join();
+}
+
+
+void SocketReactorTest::testSocketReactorPerformance()
+{
+	// Measures the round trip time through the reactor for one active
+	// connection, with an increasing number of idle connections
+	// registered with the same reactor.
+	const int ROUND_TRIPS = 10000;
+	const int idleCounts[] = {0, 100, 1000, 5000};
+
+	for (int i = 0; i < sizeof(idleCounts)/sizeof(idleCounts[0]); ++i)
+	{
+		SocketAddress ssa;
+		ServerSocket ss(ssa, 1024);
+		SocketReactor reactor;
+		SocketAcceptor<EchoServiceHandler> acceptor(ss, reactor);
+		Thread thread;
+		thread.start(reactor);
+
+		SocketAddress sa("localhost", ss.address().port());
+		std::vector<StreamSocket> idle;
+		for (int k = 0; k < idleCounts[i]; ++k)
+		{
+			idle.push_back(StreamSocket(sa));
+		}
+		StreamSocket active(sa);
+		char c = 'x';
+		active.sendBytes(&c, 1);
+		active.receiveBytes(&c, 1);
+
+		Stopwatch sw;
+		sw.start();
+		for (int k = 0; k < ROUND_TRIPS; ++k)
+		{
+			active.sendBytes(&c, 1);
+			active.receiveBytes(&c, 1);
+		}
+		sw.stop();
+		std::cout << "Round trip, " << idleCounts[i] << " idle connections: "
+		          << sw.elapsed()/ROUND_TRIPS << " us" << std::endl;
+
+		active.close();
+		for (std::vector<StreamSocket>::iterator it = idle.begin(); it != idle.end(); ++it)
+		{
+			it->close();
+		}
+		Thread::sleep(500);
+		reactor.stop();
+		thread.join();
+	}
+}
+
+
 void SocketReactorTest::setUp()
 {
 	ClientServiceHandler::setCloseOnTimeout(false);
+	ParallelEchoServiceHandler::reset();
 }
 
 
@@ -295,6 +709,12 @@ CppUnit::Test* SocketReactorTest::suite()
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactor);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorFail);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorTimeout);
+	CppUnit_addTest(pSuite, SocketReactorTest, testParallelSocketAcceptor);
+	CppUnit_addTest(pSuite, SocketReactorTest, testParallelSocketAcceptorReusePort);
+	CppUnit_addTest(pSuite, SocketReactorTest, testBufferedSocketHandler);
+	CppUnit_addTest(pSuite, SocketReactorTest, testBufferedSocketHandlerInputLimit);
+	CppUnit_addTest(pSuite, SocketReactorTest, testIdleTimeout);
+	//CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactorPerformance);
 
 	return pSuite;
 }
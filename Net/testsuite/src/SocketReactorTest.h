@@ -49,6 +49,12 @@ public:
 	void testSocketReactor();
 	void testSocketConnectorFail();
 	void testSocketConnectorTimeout();
+	void testParallelSocketAcceptor();
+	void testParallelSocketAcceptorReusePort();
+	void testBufferedSocketHandler();
+	void testBufferedSocketHandlerInputLimit();
+	void testIdleTimeout();
+	void testSocketReactorPerformance();
 
 	void setUp();
 	void tearDown();
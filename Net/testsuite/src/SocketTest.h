@@ -61,6 +61,7 @@ public:
 	void testSelect();
 	void testSelect2();
 	void testSelect3();
+	void testPollPerformance();
 
 	void setUp();
 	void tearDown();
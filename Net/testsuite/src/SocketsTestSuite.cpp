@@ -38,6 +38,7 @@
 #include "MulticastSocketTest.h"
 #include "DialogSocketTest.h"
 #include "RawSocketTest.h"
+#include "PollSetTest.h"
 
 
 CppUnit::Test* SocketsTestSuite::suite()
@@ -51,6 +52,7 @@ CppUnit::Test* SocketsTestSuite::suite()
 	pSuite->addTest(MulticastSocketTest::suite());
 	pSuite->addTest(DialogSocketTest::suite());
 	pSuite->addTest(RawSocketTest::suite());
+	pSuite->addTest(PollSetTest::suite());
 
 	return pSuite;
 }
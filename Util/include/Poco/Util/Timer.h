@@ -63,6 +63,15 @@ class Util_API Timer: protected Poco::Runnable
 	/// Timer is save for multithreaded use - multiple threads can schedule
 	/// new tasks simultaneously.
 	///
+	/// By default, scheduled tasks are kept in a queue ordered by execution
+	/// time, so that scheduling a task takes O(log n) time. A Timer that
+	/// has to manage a large number of tasks (e.g., one timeout per
+	/// connection) can be created with a resolution instead, in which case
+	/// the tasks are kept in a Poco::TimingWheel and scheduling a task
+	/// takes constant time. Tasks are then executed up to one resolution
+	/// interval late, and tasks falling into the same interval are executed
+	/// in no particular order.
+	///
 	/// Acknowledgement: The interface of this class has been inspired by
 	/// the java.util.Timer class from Java 1.3.
 {
@@ -73,6 +82,11 @@ public:
 	explicit Timer(Poco::Thread::Priority priority);
 		/// Creates the Timer, using a timer thread with
 		/// the given priority.
+
+	explicit Timer(Poco::Timestamp::TimeDiff resolution, Poco::Thread::Priority priority = Poco::Thread::PRIO_NORMAL);
+		/// Creates the Timer, using a timer thread with the given
+		/// priority and a Poco::TimingWheel with the given
+		/// resolution in microseconds for keeping the tasks.
 	
 	~Timer();
 		/// Destroys the Timer, cancelling all pending tasks.
@@ -250,6 +250,14 @@ Timer::Timer(Poco::Thread::Priority priority)
 }
 
 
+Timer::Timer(Poco::Timestamp::TimeDiff resolution, Poco::Thread::Priority priority):
+	_queue(resolution)
+{
+	_thread.setPriority(priority);
+	_thread.start(*this);
+}
+
+
 Timer::~Timer()
 {
 	_queue.enqueueNotification(new StopNotification(_queue), 0);
@@ -35,6 +35,7 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Util/Timer.h"
 #include "Poco/Util/TimerTaskAdapter.h"
+#include <vector>
 
 
 using Poco::Util::Timer;
@@ -129,6 +130,62 @@ void TimerTest::testScheduleAtFixedRate()
 }
 
 
+void TimerTest::testTimingWheel()
+{
+	Timer timer(1000);
+	
+	Timestamp time;
+	time += 500000;
+	
+	TimerTask::Ptr pTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onTimer);
+	TimerTask::Ptr pCancelledTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onTimer);
+
+	timer.schedule(pCancelledTask, time);
+	timer.schedule(pTask, time);
+	pCancelledTask->cancel();
+	
+	_event.wait();
+	assert (pTask->lastExecution() >= time);
+	assert (pCancelledTask->lastExecution() == 0);
+
+	Timestamp start;
+	pTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onTimer);
+	timer.scheduleAtFixedRate(pTask, 500, 500);
+
+	_event.wait();
+	assert (start.elapsed() >= 500000);
+	assert (pTask->lastExecution().elapsed() < 130000);
+
+	_event.wait();
+	assert (start.elapsed() >= 1000000);
+	assert (pTask->lastExecution().elapsed() < 130000);
+
+	pTask->cancel();
+	timer.cancel(true);
+}
+
+
+void TimerTest::testCancelDueTasks()
+{
+	Timer timer(1000);
+
+	Timestamp time;
+	time += 100000;
+
+	// all tasks become due together, so while the first one runs,
+	// the others are waiting to be run
+	std::vector<TimerTask::Ptr> tasks;
+	for (int i = 0; i < 10; ++i)
+	{
+		tasks.push_back(new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onCountingTimer));
+		timer.schedule(tasks.back(), time);
+	}
+	_started.wait();
+	timer.cancel(true);
+	assert (_count.value() == 1);
+}
+
+
 void TimerTest::setUp()
 {
 }
@@ -146,6 +203,14 @@ void TimerTest::onTimer(TimerTask& task)
 }
 
 
+void TimerTest::onCountingTimer(TimerTask& task)
+{
+	++_count;
+	_started.set();
+	Poco::Thread::sleep(100);
+}
+
+
 CppUnit::Test* TimerTest::suite()
 {
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TimerTest");
@@ -153,6 +218,8 @@ CppUnit::Test* TimerTest::suite()
 	CppUnit_addTest(pSuite, TimerTest, testSchedule);
 	CppUnit_addTest(pSuite, TimerTest, testScheduleInterval);
 	CppUnit_addTest(pSuite, TimerTest, testScheduleAtFixedRate);
+	CppUnit_addTest(pSuite, TimerTest, testTimingWheel);
+	CppUnit_addTest(pSuite, TimerTest, testCancelDueTasks);
 
 	return pSuite;
 }
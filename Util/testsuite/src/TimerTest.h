@@ -40,6 +40,7 @@
 #include "CppUnit/TestCase.h"
 #include "Poco/Util/TimerTask.h"
 #include "Poco/Event.h"
+#include "Poco/AtomicCounter.h"
 
 
 class TimerTest: public CppUnit::TestCase
@@ -51,16 +52,21 @@ public:
 	void testSchedule();
 	void testScheduleInterval();
 	void testScheduleAtFixedRate();
+	void testTimingWheel();
+	void testCancelDueTasks();
 
 	void setUp();
 	void tearDown();
 	
 	void onTimer(Poco::Util::TimerTask& task);
+	void onCountingTimer(Poco::Util::TimerTask& task);
 
 	static CppUnit::Test* suite();
 
 private:
 	Poco::Event _event;
+	Poco::Event _started;
+	Poco::AtomicCounter _count;
 };
 
 